@@ -1,7 +1,9 @@
 #pragma once
 
-#include <GLFW/glfw3.h>
+#include <memory>
+
 #include <glad/glad.h>
+#include <GLFW/glfw3.h>
 
 // Resources
 #include "ResourcesManager.hpp"
@@ -16,6 +18,10 @@
 #include "InputsManager.hpp"
 #include "Timer.hpp"
 #include "ThreadsManager.hpp"
+#include "JobSystem.hpp"
+#include "FileWatcher.hpp"
+// Core::Debug
+#include "GLRecorder.hpp"
 
 namespace Core
 {
@@ -28,6 +34,12 @@ namespace Core
 		const char* name;
 		void (*framebuffer_size_callback) (GLFWwindow* window, int width, int height);
 		void (*glDebugOutput) (GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei lenght, const GLchar* message, const void* userParam);
+		bool hotReload = false; // Reload the resources modified in Resources/
+		const char* assetPack = nullptr; // Pack built with --pack, mounted if it exists
+		size_t textureBudget = Resources::TEXTURE_STREAMING_BUDGET; // GPU bytes of the streamed texture levels
+		bool headless = false; // No window nor GPU : the GL calls are recorded, Scene1 is simulated then the app quits
+		unsigned int headlessFrames = 600; // Frames simulated once every resource is loaded
+		bool indirectDraws = false; // Scene1 drawn with one glMultiDrawElementsIndirect per shader and texture
 	};
 
 	class App
@@ -36,6 +48,7 @@ namespace Core
 	private:
 
 		static GLFWwindow* window;
+		std::unique_ptr<Debug::GLRecorder> recorder; // Null device of the headless runs, destroyed after the resources
 		unsigned int width;
 		unsigned int height;
 
@@ -45,9 +58,12 @@ namespace Core
 		 Resources::Scene* currentScene;
 		LowRenderer::Renderer m_renderer;
 		ThreadsManager threadsManager;
+		FileWatcher fileWatcher;
 
 		static bool stopGame;
-
+		static bool headless;
+		unsigned int headlessFrames;
+		bool indirectDraws;
 
 	public:
 		static Resources::NextScene nextScene;
@@ -63,12 +79,17 @@ namespace Core
 		// Get and Set
 		GLFWwindow* GetWindow() { return window; };
 		static void StopGame() { stopGame = true; };
+		static bool IsHeadless() { return headless; };
 
 	private:
+		bool InitWindow(const AppInit& p_appInit);
+		void InitHeadless();
+		void PrintHeadlessReport(const double p_seconds, const unsigned int p_frames, const Debug::GLCalls& p_calls) const;
 		void ChangeScene();
 		void InitRenderer();
 		void CreateResource();
 		void CreateScenes();
 		void InitScene1();
+		void ReloadModifiedResources();
 	};
 }
\ No newline at end of file
@@ -4,10 +4,16 @@
 
 #include "Log.hpp"
 
+#ifdef _WIN32
+	#define DEBUG_BREAK() __debugbreak()
+#else
+	#define DEBUG_BREAK() __builtin_trap()
+#endif
+
 namespace Core::Debug
 {
 #ifdef DEBUG
-	#define Assertion(p_expression, p_log) if (!(p_expression)) { DEBUG_LOG(p_log); __debugbreak();}
+	#define Assertion(p_expression, p_log) if (!(p_expression)) { DEBUG_LOG(p_log); DEBUG_BREAK();}
 #else
 	#define Assertion(p_expression, p_log) if (!(p_expression)) { DEBUG_LOG(p_log); abort();}
 #endif // DEBUG
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "MappedFile.hpp"
+
+namespace Resources
+{
+	const uint32_t PACK_MAGIC = 0x4B50474F; // "OGPK"
+	const uint32_t PACK_VERSION = 2;
+
+	enum class PackCompression : uint32_t
+	{
+		NONE,
+		ZLIB,
+	};
+
+	// File layout : header, table of contents sorted by path hash, paths, then the entries in build order.
+	// Every entry starts on a multiple of the alignment, so it can be used in place from the mapping.
+	struct PackHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t nbEntries;
+		uint32_t alignment;
+		uint64_t pathsOffset;
+		uint64_t pathsSize;
+	};
+
+	struct PackEntry
+	{
+		uint64_t pathHash;
+		uint64_t offset;
+		uint64_t size;		 // Stored size
+		uint64_t rawSize;	 // Size once decompressed
+		int64_t sourceTime;	 // Last write of the source file when the pack was built
+		uint32_t pathOffset; // From pathsOffset
+		uint32_t pathSize;
+		PackCompression compression;
+		uint32_t padding;
+	};
+
+	struct PackBuildSettings
+	{
+		uint32_t alignment = 4096;
+		bool compress = true;
+		float minCompressionRatio = 0.9f; // An entry stays compressed only if it is smaller than this ratio of its size
+	};
+
+	class AssetPack
+	{
+		// Attribute
+	private:
+		Core::MappedFile file;
+		const PackHeader* header;
+		const PackEntry* entries;
+		const char* paths;
+
+		// Methode
+	public:
+		AssetPack();
+
+		static bool Build(const std::string& p_output, const std::vector<std::string>& p_files, const PackBuildSettings& p_settings = PackBuildSettings());
+		static std::vector<std::string> ListFiles(const std::string& p_root);
+		static std::string NormalizePath(const std::string& p_path);
+		static int64_t GetSourceTime(const std::string& p_path); // 0 if the file is not on disk
+
+		bool Mount(const std::string& p_path);
+		void Unmount();
+
+		const PackEntry* Find(const std::string& p_path) const;
+		std::vector<std::string> GetStaleFiles() const; // Sources modified on disk since the build, read loose
+		std::shared_ptr<const std::string> Read(const std::string& p_path) const; // nullptr if the file is not in the pack
+
+		// Get and Set
+		bool IsMounted() const { return header != nullptr; };
+		unsigned int GetNbEntries() const { return header ? header->nbEntries : 0; };
+		std::string GetPath(const PackEntry& p_entry) const { return std::string(paths + p_entry.pathOffset, p_entry.pathSize); };
+	};
+}
\ No newline at end of file
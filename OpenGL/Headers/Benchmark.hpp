@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Core::Debug
+{
+	// Headless benchmarks (no window, no OpenGL context) : OpenGL.exe --benchmark
+	void Benchmark();
+
+	void BenchmarkTextureDecode();
+	void BenchmarkTextureCompression();
+	void BenchmarkTextureCache();
+	void BenchmarkDrawPath();
+	void BenchmarkRenderQueue();
+	void BenchmarkInstancing();
+	void BenchmarkFrustumCulling();
+	void BenchmarkOcclusionCulling();
+	void BenchmarkLightClusters();
+	void BenchmarkDrawRecording();
+
+	std::vector<std::string> ListBenchmarkFiles(const std::string& p_directory, const std::vector<std::string>& p_extensions);
+}
\ No newline at end of file
@@ -3,9 +3,26 @@
 #include "Transform.hpp"
 #include "GameObject.hpp"
 #include "InputsManager.hpp"
+#include "Frustum.hpp"
 
 namespace LowRenderer
 {
+	// Camera of the frame, computed once in Camera::Update and only read by the render, the culling and the debug draws
+	struct CameraState
+	{
+		Core::Maths::Mat4 view;
+		Core::Maths::Mat4 projection;
+		Core::Maths::Mat4 viewProjection;
+		Core::Maths::Mat4 inverseViewProjection;
+		Frustum frustum; // World planes of viewProjection
+		Core::Maths::Vec3 position;
+
+		float near = 0.f;
+		float far = 0.f;
+		float fovY = 0.f; // Degrees
+		float aspect = 0.f;
+	};
+
 	class Camera : public GameObject
 	{
 		// Attribute
@@ -25,8 +42,7 @@ namespace LowRenderer
 
 		GameObject* player;
 
-		Physics::Transform viewMatrix;
-		Physics::Transform projectionMatrix;
+		CameraState state;
 
 		// Methode
 	public:
@@ -35,7 +51,7 @@ namespace LowRenderer
 		void Update(const Core::Inputs& p_Inputs, const double p_deltaTime,const Physics::Transform& p_transformParent = Physics::Transform()) override;
 
 		// Get and Set
-		Core::Maths::Mat4& GetViewProjection();
+		const CameraState& GetState() const { return state; };
 		void SetPlayer(GameObject* p_player) { player = p_player; };
 		Core::Maths::Vec3& GetForward() { return front; };
 		Core::Maths::Vec3& GetRight() { return right; };
@@ -45,5 +61,6 @@ namespace LowRenderer
 		Core::Maths::Mat4 LookAt(const Core::Maths::Vec3& eye, const Core::Maths::Vec3& center, const Core::Maths::Vec3& up);
 		void CalculateViewMatrix();
 		void CalculateProjectionMatrix();
+		void CalculateState(); // After the view and the projection
 	};
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+
+#include "SpinLock.hpp"
+
+namespace Resources
+{
+	class AssetPack;
+
+	struct FileCacheStats
+	{
+		unsigned int nbRead = 0;		 // Files really read from disk
+		unsigned int nbShared = 0;		 // Requests served by an already loaded content
+		size_t bytesRead = 0;
+		size_t bytesSaved = 0;
+	};
+
+	// Content of every file read by resources, shared between all the resources
+	// which resolve to the same path or to the same bytes (FNV-1a 64 bits hash).
+	// Files are read from the mounted pack first, then from the disk.
+	class FileCache
+	{
+		// Attribute
+	private:
+		static Core::SpinLock filesLock;
+		static std::unordered_map<std::string, std::shared_ptr<const std::string>> files;	 // Canonical path -> content
+		static std::unordered_multimap<uint64_t, std::shared_ptr<const std::string>> contents; // Hash -> content
+		static FileCacheStats stats;
+		static std::shared_ptr<const AssetPack> pack;
+		static std::unordered_set<std::string> looseFiles; // Modified on disk since the pack was built
+
+		// Methode
+	public:
+		// nullptr if the file can not be read
+		static std::shared_ptr<const std::string> Read(const std::string& p_path);
+		static std::shared_ptr<const std::string> Load(const std::string& p_path); // Not kept in the cache (images, meshes)
+		static void Invalidate(const std::string& p_path);
+		static void Mount(const std::shared_ptr<const AssetPack>& p_pack);
+		static void Clear();
+		static size_t GetSourceSize(const std::string& p_path); // From the cache, the pack, then the disk. 0 if not found
+
+		static std::string Canonicalize(const std::string& p_path);
+		static uint64_t Hash(const void* p_data, const size_t p_size);
+
+		// Get and Set
+		static FileCacheStats GetStats();
+
+	private:
+		static std::shared_ptr<const std::string> ReadFile(const std::string& p_path, const std::string& p_canonicalPath);
+	};
+}
\ No newline at end of file
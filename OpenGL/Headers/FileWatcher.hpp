@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <filesystem>
+#include <chrono>
+
+namespace Core
+{
+	// Report the files modified under a directory (inotify on Linux, last write time polling elsewhere)
+	class FileWatcher
+	{
+		// Attribute
+	private:
+		std::string root;
+		bool isWatching;
+
+#ifdef __linux__
+		int inotify;
+		std::unordered_map<int, std::string> directories; // Watch descriptor -> directory
+#else
+		std::unordered_map<std::string, std::filesystem::file_time_type> lastWriteTimes;
+		std::chrono::steady_clock::time_point lastScan;
+#endif
+
+		// Methode
+	public:
+		FileWatcher();
+		~FileWatcher();
+
+		bool Init(const std::string& p_root);
+		std::vector<std::string> Poll();
+
+		// Get and Set
+		bool IsWatching() const { return isWatching; };
+
+	private:
+		void AddDirectory(const std::string& p_directory);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+
+#include "MyMaths.hpp"
+
+namespace LowRenderer
+{
+	// Points p with Dot(normal, p) + distance >= 0 are inside
+	struct Plane
+	{
+		Core::Maths::Vec3 normal;
+		float distance = 0.f;
+	};
+
+	struct Frustum
+	{
+		Plane planes[6]; // Left, right, bottom, top, near, far
+
+		// Gribb-Hartmann : rows of the view-projection of the engine, planes normalized
+		static Frustum FromViewProjection(const Core::Maths::Mat4& p_viewProjection);
+	};
+
+	// World bounding spheres in structure of arrays, read by batches of 4 (SSE) or 8 (AVX)
+	class BoundingSpheres
+	{
+		// Attribute
+	private:
+		std::vector<float> x;
+		std::vector<float> y;
+		std::vector<float> z;
+		std::vector<float> radius;
+
+		// Methode
+	public:
+		void Clear();
+		void Reserve(const size_t p_size);
+		void Add(const Core::Maths::Vec3& p_center, const float p_radius);
+
+		// Get and Set
+		size_t Size() const { return x.size(); };
+		const float* GetX() const { return x.data(); };
+		const float* GetY() const { return y.data(); };
+		const float* GetZ() const { return z.data(); };
+		const float* GetRadius() const { return radius.data(); };
+	};
+
+	// Indices of the spheres touching the frustum, in increasing order
+	void CullSpheres(const Frustum& p_frustum, const BoundingSpheres& p_spheres, std::vector<unsigned int>& p_visible);
+	void CullSpheresScalar(const Frustum& p_frustum, const BoundingSpheres& p_spheres, std::vector<unsigned int>& p_visible); // Reference
+}
\ No newline at end of file
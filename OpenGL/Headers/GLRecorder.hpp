@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace Core::Debug
+{
+	struct GLCalls
+	{
+		unsigned int getUniformLocation = 0;
+		unsigned int uniform = 0;		  // glUniform*
+		unsigned int useProgram = 0;
+		unsigned int bindTexture = 0;	  // Textures and samplers
+		unsigned int bindVertexArray = 0;
+		unsigned int bufferUpload = 0;	  // glBufferData, glBufferSubData and glCopyBufferSubData
+		unsigned int textureUpload = 0;	  // glTexImage2D, glTexSubImage2D and the compressed ones
+		unsigned int stateChange = 0;	  // Enable, parameters, clears and the other fixed states
+		unsigned int draw = 0;
+		size_t indices = 0;				  // Indices of the draw calls, the indirect ones read from the last upload to GL_DRAW_INDIRECT_BUFFER
+		unsigned int other = 0;			  // Creation and deletion of the objects
+	};
+
+	struct GLMemory
+	{
+		size_t bufferBytes = 0;
+		size_t textureBytes = 0; // Every level, compressed levels at their compressed size
+		unsigned int nbBuffers = 0;
+		unsigned int nbTextures = 0;
+		unsigned int nbPrograms = 0;
+	};
+
+	// Null OpenGL device : swaps the functions loaded by glad for functions which only record the calls,
+	// the objects and their sizes, so the engine runs without a GPU nor a context. Installed while it lives.
+	// The programs report the uniforms declared in their sources, or the given ones for every program.
+	class GLRecorder
+	{
+		// Attribute
+	private:
+		std::vector<std::function<void()>> restore;
+
+		// Methode
+	public:
+		GLRecorder(const std::vector<std::string>& p_uniforms = {});
+		~GLRecorder();
+		GLRecorder(const GLRecorder&) = delete;
+		GLRecorder& operator=(const GLRecorder&) = delete;
+
+		static void Reset(); // Calls only, the objects are kept
+
+		// Get and Set
+		static const GLCalls& GetCalls();
+		static GLMemory GetMemory();
+		static const std::vector<std::string>& GetUniformNames(const unsigned int p_program);
+		static int GetUniformLocation(const unsigned int p_program, const std::string& p_name);
+
+		// "uniform type name[size];" outside of the blocks, the sizes may be #define
+		static std::vector<std::string> ParseUniforms(const std::string& p_source);
+
+	private:
+		template <typename T>
+		void Replace(T& p_function, T p_stub)
+		{
+			restore.push_back([&p_function, previous = p_function]() { p_function = previous; });
+			p_function = p_stub;
+		}
+	};
+}
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "MyMaths.hpp"
 #include "Model.hpp"
 #include "LightManager.hpp"
+#include "RenderQueue.hpp"
 #include "InputsManager.hpp"
 
 // Physics
@@ -38,6 +39,9 @@ namespace LowRenderer
 		Physics::Rigidbody rigidbody;
 
 		Physics::Collider* collider;
+
+		bool occluder; // Its mesh hides the objects behind it
+		bool isStatic; // Never moves : merged in the static batch of its scene
 		// Methode
 	public:
 		GameObject(const LowRenderer::Model& p_model, const Physics::Transform& p_transform = Physics::Transform(), const std::string& p_name = "Default name");
@@ -45,7 +49,8 @@ namespace LowRenderer
 		GameObject(const GameObject& p_gameObject);
 
 		virtual void Update(const Core::Inputs& p_Inputs, const double p_deltaTime, const Physics::Transform& p_transformParent = Physics::Transform());
-		void Draw(Core::Maths::Mat4& p_vp, Core::Maths::Vec3 p_camPos, LightManager& p_lightManager, Core::Maths::Mat4 p_transformParent = Core::Maths::Mat4::Identity());
+		void Draw(const Core::Maths::Mat4& p_vp, RenderList& p_list); // Records the draw, submitted once the queue is merged and sorted
+		bool GetBoundingSphere(Core::Maths::Vec3& p_center, float& p_radius) const; // World space, false without model to draw
 
 		void Translate(const Core::Maths::Vec3& p_translation);
 		void Scale(const Core::Maths::Vec3& p_scale);
@@ -54,6 +59,7 @@ namespace LowRenderer
 		// Get and Set
 		const int GetShaderProgram() { return model.GetShaderProgram(); };
 		Model GetModel() { return model; };
+		const Model& GetModel() const { return model; };
 		std::string& GetName() { return name; };
 		Physics::Transform* GetTransfrom() { return &transform; };
 
@@ -62,8 +68,13 @@ namespace LowRenderer
 		virtual Core::Maths::Vec3& GetRotation() { return transform.rotation; };
 		Core::Maths::Vec3& GetScale() { return transform.scale; };
 		Core::Maths::Mat4& GetModelMatrix() { return transform.matrix; };
+		const Core::Maths::Mat4& GetModelMatrix() const { return transform.matrix; };
 
 		void SetEnableModel(const bool p_isEnable) { model.isEnable = p_isEnable; };
+		void SetOccluder(const bool p_isOccluder) { occluder = p_isOccluder; };
+		bool IsOccluder() const { return occluder; };
+		void SetStatic(const bool p_isStatic) { isStatic = p_isStatic; };
+		bool IsStatic() const { return isStatic; };
 		void SetEnablePlayerControler(const bool p_isEnable) { playerControler.isEnable = p_isEnable; };
 		void SetCameraRotation(Core::Maths::Vec3& p_forward, Core::Maths::Vec3& p_right) { playerControler.SetCam(p_forward, p_right); };
 
@@ -71,4 +82,4 @@ namespace LowRenderer
 		Physics::Collider* GetCollider();
 		Physics::Rigidbody& GetRigidbody() { return rigidbody; };
 	};
-}
+}
\ No newline at end of file
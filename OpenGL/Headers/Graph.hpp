@@ -5,6 +5,8 @@
 #include "GameObject.hpp"
 #include "Camera.hpp"
 #include "LightManager.hpp"
+#include "Frustum.hpp"
+#include "OcclusionCulling.hpp"
 
 namespace Core::DataStructure
 {
@@ -24,13 +26,20 @@ namespace Core::DataStructure
 		std::vector<GraphNode> nodes;
 		std::vector<LowRenderer::GameObject*>* gameObjects;
 
+		// Culling of the frame, kept to reuse their memory
+		std::vector<LowRenderer::GameObject*> drawables;
+		LowRenderer::BoundingSpheres spheres;
+		std::vector<unsigned int> visible; // Index in drawables
+		LowRenderer::OcclusionBuffer occlusion;
+		std::vector<char> occluded;		   // Per visible object
+
 		// Methode
 	public:
 		Graph(std::vector<LowRenderer::GameObject*>& p_gameObject);
 		~Graph();
 
 		void Update(const Core::Inputs& p_Inputs, const double p_deltaTime);
-		void Draw(LowRenderer::Camera& p_camera, LowRenderer::LightManager& p_lightManager);
+		void Draw(const LowRenderer::CameraState& p_camera, LowRenderer::RenderQueue& p_queue); // Objects in the frustum of the camera and not hidden by the occluders
 
 		void AddNode(int p_index);
 		bool SetParent(const std::string& p_nameParent, const std::string& p_nameChild);
@@ -41,12 +50,10 @@ namespace Core::DataStructure
 
 	private:
 		void UpdateChild(const GraphNode& p_child, const Core::Inputs& p_Inputs, const double p_deltaTime);
-		void DrawChild(LowRenderer::Camera& p_camera, LowRenderer::LightManager& p_lightManager, const GraphNode& p_child);
+		void AddDrawable(const GraphNode& p_node);
+		void CullOccluded(const Core::Maths::Mat4& p_viewProjection); // Marks the visible objects behind the occluders
 		
 		bool ParentCheck(const unsigned int p_index) const;
 		bool InitCheck(const unsigned int p_index);
-
-		// Get and Set
-		Core::Maths::Mat4& GetMatrixModelParent(const GraphNode& p_childs);
 	};
 }
\ No newline at end of file
@@ -1,14 +1,26 @@
 #pragma once
 
 #include <string>
+#include <atomic>
+#include <vector>
 
 namespace Resources
 {
 	enum class StatResource
 	{
 		NONE,
+		QUEUED,
 		INITIALIZED,
 		LOADED,
+		FAILED, // A file is missing or the resource could not be built
+	};
+
+	struct ResourceMemory
+	{
+		size_t cpu = 0; // Bytes kept in RAM
+		size_t gpu = 0; // Bytes in VRAM, estimated from the formats
+
+		ResourceMemory& operator+=(const ResourceMemory& p_memory) { cpu += p_memory.cpu; gpu += p_memory.gpu; return *this; };
 	};
 
 	class IResource
@@ -19,15 +31,36 @@ namespace Resources
 		std::string path2;
 		std::string name;
 		int id;
-		StatResource stat = StatResource::NONE;
+		std::atomic<StatResource> stat = StatResource::NONE; // Written by the workers, read by the main thread
 
 		// Methode
 	public:
+		IResource() {};
+		IResource(const IResource& p_other) : path1(p_other.path1), path2(p_other.path2), name(p_other.name), id(p_other.id), stat(p_other.stat.load()) {};
+		IResource& operator=(const IResource& p_other)
+		{
+			path1 = p_other.path1;
+			path2 = p_other.path2;
+			name = p_other.name;
+			id = p_other.id;
+			stat = p_other.stat.load();
+			return *this;
+		};
 		virtual ~IResource() {};
 
 		virtual void Init() {};
 		virtual void InitOpenGL() {};
 
+		// Hot reload : a new instance is initialized aside, then swapped with this one
+		virtual IResource* CreateReload() const { return nullptr; };
+		virtual void SwapReload(IResource& p_reloaded) {};
+
+		// Memory accounting, called from the OpenGL thread once the resource is loaded
+		virtual const char* GetTypeName() const { return "Resource"; };
+		virtual ResourceMemory GetMemoryUsage() const { return ResourceMemory(); };
+		virtual void GetUsedResources(std::vector<const IResource*>& p_resources) const {};
+		virtual bool DependsOn(const std::string& p_canonicalPath) const { return false; }; // Files read besides path1 and path2
+
 		virtual void SetPath1(const std::string& p_path1) { path1 = p_path1; };
 		virtual void SetPath2(const std::string& p_path2) { path1 = p_path2; };
 		virtual void SetName(const std::string& p_name) { name = p_name; };
@@ -36,6 +69,7 @@ namespace Resources
 		virtual const std::string& GetPath1() const { return path1; };
 		virtual const std::string& GetPath2() const { return path2; };
 		virtual const std::string& GetName() const { return name; };
-		virtual const StatResource& GetStat() const { return stat; };
+		virtual int GetId() const { return id; };
+		virtual StatResource GetStat() const { return stat; };
 	};
 }
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Resources
+{
+	// Pixels decoded from an encoded image (png, jpg...) in memory.
+	// Decode is re-entrant : no global stb state, images can be decoded by every worker at once.
+	class Image
+	{
+		// Attribute
+	private:
+		unsigned char* data;
+		int width;
+		int height;
+		int nrChannels;
+
+		// Methode
+	public:
+		Image();
+		~Image();
+		Image(const Image&) = delete;
+		Image& operator=(const Image&) = delete;
+		Image(Image&& p_other) noexcept;
+		Image& operator=(Image&& p_other) noexcept;
+
+		// p_desiredChannels = 0 keeps the channels of the file
+		bool Decode(const void* p_buffer, const size_t p_size, const bool p_flipVertically = true, const int p_desiredChannels = 0);
+		void Free();
+
+		// Get and Set
+		const unsigned char* GetData() const { return data; };
+		unsigned char* GetData() { return data; };
+		int GetWidth() const { return width; };
+		int GetHeight() const { return height; };
+		int GetNrChannels() const { return nrChannels; };
+		size_t GetSize() const { return (size_t)width * height * nrChannels; };
+	};
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <atomic>
+#include <functional>
+
+#include "SpinLock.hpp"
+
+namespace Core
+{
+	const unsigned int JOB_SPIN_MICROSECONDS = 2000; // An idle worker yields this long, the loops of a frame follow each other closely
+	const unsigned int JOB_SLEEP_MICROSECONDS = 200; // Then sleeps by steps of this length until a job comes
+
+	// Workers started once and kept for the whole run, fed with the parallel loops of the frame.
+	// Without worker (not started, or ThreadsManager::multithread off) every loop runs on the caller.
+	class JobSystem
+	{
+		// Attribute
+	private:
+		static std::vector<std::thread> workers;
+		static SpinLock jobsLock;
+		static std::deque<std::function<void()>> jobs;
+		static std::atomic<unsigned int> nbJobs; // Read by the idle workers without the lock
+		static std::atomic<bool> running;
+
+		// Methode
+	public:
+		static void Start(const unsigned int p_nbWorkers);
+		static void Stop(); // Waits for the jobs already queued
+
+		// p_function(begin, end) on chunks of p_grain indices, the caller takes chunks too and returns once every chunk is done
+		static void ParallelFor(const unsigned int p_count, const unsigned int p_grain, const std::function<void(unsigned int, unsigned int)>& p_function);
+
+		// Get and Set
+		static unsigned int GetNbWorkers() { return (unsigned int)workers.size(); };
+		static unsigned int GetDefaultNbWorkers(); // One thread per core, the caller included
+
+	private:
+		static void Run();
+	};
+}
\ No newline at end of file
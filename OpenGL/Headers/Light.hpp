@@ -1,9 +1,16 @@
 #pragma once
 
+#include <vector>
+
 #include "MyMaths.hpp"
 
 namespace LowRenderer
 {
+	class UniformBlock;
+
+	const unsigned int LIGHT_TEXELS = 5;	  // vec4 of a point or spot light in the buffer of the clustered lights
+	const float LIGHT_CUTOFF = 5.f / 256.f; // Attenuation beyond which a point light is ignored
+
 	struct InitLight
 	{
 		Core::Maths::Vec3 position;
@@ -25,13 +32,17 @@ namespace LowRenderer
 
 		// Methode
 	public:
-		virtual void Update(const int p_shaderProgram, const Core::Maths::Vec3& p_camPosition, std::string& p_array);
+		void Pack(UniformBlock& p_block) const; // LightData of the Lights block
+		void Pack(std::vector<Core::Maths::Vec4>& p_texels, const float p_w) const; // Position with p_w and the colors, 4 texels
 
 		// Get and Set
 		Core::Maths::Vec4& GetDiffuseColor() { return diffuseColor; };
 		Core::Maths::Vec4& GetAmbientColor() { return ambientColor; };
+		const Core::Maths::Vec4& GetAmbientColor() const { return ambientColor; };
 		Core::Maths::Vec4& GetSpecularColor() { return specularColor; };
 		Core::Maths::Vec3& GetPosition() { return position; };
+		const Core::Maths::Vec3& GetPosition() const { return position; };
+		float GetIntensity() const; // Largest component of the colors
 	};
 
 	class DirectionLight : public Light
@@ -44,7 +55,7 @@ namespace LowRenderer
 	public:
 		DirectionLight(const InitLight& p_initLight, const Core::Maths::Vec3& p_diretion);
 
-		void Update(const int p_shaderProgram, const Core::Maths::Vec3& p_camPosition, const unsigned int p_index);
+		void Pack(UniformBlock& p_block) const;
 	
 		Core::Maths::Vec3& GetDirection() { return direction; };
 	};
@@ -61,7 +72,9 @@ namespace LowRenderer
 	public:
 		PointLight(const InitLight& p_initLight, const float p_constant, const float p_linear, const float p_quadratic);
 
-		void Update(const int p_shaderProgram, const Core::Maths::Vec3& p_camPosition, const unsigned int p_index);
+		void Pack(UniformBlock& p_block) const;
+		void Pack(std::vector<Core::Maths::Vec4>& p_texels) const; // LIGHT_TEXELS texels
+		float GetRange() const; // Distance where the attenuation goes under LIGHT_CUTOFF
 	
 		float& GetConstant() { return constant; };
 		float& GetLinear() { return linear; };
@@ -80,10 +93,13 @@ namespace LowRenderer
 	public:
 		SpotLight(const InitLight& p_initLight, const Core::Maths::Vec3& p_direction, const float p_cutOff, const float p_outerCutOff);
 
-		void Update(const int p_shaderProgram, const Core::Maths::Vec3& p_camPosition, const unsigned int p_index);
+		void Pack(UniformBlock& p_block) const;
+		void Pack(std::vector<Core::Maths::Vec4>& p_texels) const; // LIGHT_TEXELS texels
 	
 		Core::Maths::Vec3& GetDirection() { return direction; };
+		const Core::Maths::Vec3& GetDirection() const { return direction; };
 		float& GetCutOff() { return cutOff; };
+		float GetCutOff() const { return cutOff; }; // Degrees, half angle of the lit cone
 		float& GetOuterCutOff() { return outerCutOff; };
 
 	};
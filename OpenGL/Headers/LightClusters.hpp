@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "MyMaths.hpp"
+
+namespace LowRenderer
+{
+	// Grid of the view frustum : tiles of the screen, slices growing exponentially with the depth
+	const unsigned int CLUSTER_X = 16;
+	const unsigned int CLUSTER_Y = 9;
+	const unsigned int CLUSTER_Z = 24;
+	const unsigned int NB_CLUSTERS = CLUSTER_X * CLUSTER_Y * CLUSTER_Z;
+	const unsigned int MAX_LIGHTS_PER_CLUSTER = 128; // The next lights of a full cluster are dropped
+
+	// Volume lit by a point or a spot light, in view space (the camera looks toward -z)
+	struct ClusterLight
+	{
+		Core::Maths::Vec3 center; // Bounding sphere
+		float radius = 0.f;
+
+		// Spot lights only, the clusters outside the cone are skipped
+		bool isSpot = false;
+		Core::Maths::Vec3 position;
+		Core::Maths::Vec3 direction;
+		float cosAngle = 0.f;
+		float sinAngle = 0.f;
+		float range = 0.f;
+
+		static ClusterLight Point(const Core::Maths::Vec3& p_position, const float p_range);
+		static ClusterLight Spot(const Core::Maths::Vec3& p_position, const Core::Maths::Vec3& p_direction, const float p_angle, const float p_range); // Angle in radians
+	};
+
+	// Clusters touched by a light, max included
+	struct ClusterRange
+	{
+		int minX = 0, maxX = -1;
+		int minY = 0, maxY = -1;
+		int minZ = 0, maxZ = -1;
+	};
+
+	// Clustered forward shading : each frame the point and spot lights are assigned to the clusters their volume
+	// touches, one slice per job. The fragments only read the lights of their cluster.
+	class LightClusters
+	{
+		// Attribute
+	private:
+		float near;
+		float far;
+		float tanHalfFovY;
+		float aspect;
+		std::vector<Core::Maths::Vec2> boundariesX;	   // Planes between the tiles, through the eye : x * a + z * b >= 0 on their right
+		std::vector<Core::Maths::Vec2> boundariesY;	   // y * a + z * b >= 0 above them
+		std::vector<Core::Maths::Vec4> clusterSpheres; // Bounding sphere of each cluster, for the cones
+
+		std::vector<ClusterRange> ranges;			   // Per light
+		std::vector<uint32_t> counts;				   // Per cluster
+		std::vector<uint32_t> lists;				   // MAX_LIGHTS_PER_CLUSTER per cluster
+		std::vector<unsigned int> sliceOverflows;
+
+		std::vector<uint32_t> grid;					   // Offset and number of lights of each cluster in indices
+		std::vector<uint32_t> indices;
+		unsigned int nbOverflows;
+
+		// Methode
+	public:
+		LightClusters();
+
+		void SetProjection(const float p_near, const float p_far, const float p_fovY, const float p_aspect); // Degrees, as the Camera
+		void Build(const std::vector<ClusterLight>& p_lights);
+
+		static unsigned int GetClusterIndex(const unsigned int p_x, const unsigned int p_y, const unsigned int p_z) { return (p_z * CLUSTER_Y + p_y) * CLUSTER_X + p_x; };
+
+		// Get and Set
+		const std::vector<uint32_t>& GetGrid() const { return grid; };
+		const std::vector<uint32_t>& GetIndices() const { return indices; };
+		unsigned int GetNbOverflows() const { return nbOverflows; };
+		float GetSliceScale() const; // Slice of a view depth : log(depth) * scale + bias
+		float GetSliceBias() const;
+		int GetSlice(const float p_depth) const;
+
+	private:
+		ClusterRange GetRange(const ClusterLight& p_light) const;
+		void BuildSlice(const unsigned int p_slice, const std::vector<ClusterLight>& p_lights);
+		float GetSliceDepth(const unsigned int p_slice) const; // Near depth of the slice
+	};
+}
\ No newline at end of file
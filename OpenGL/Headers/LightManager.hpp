@@ -3,12 +3,15 @@
 #include <vector>
 
 #include "Light.hpp"
+#include "UniformBlock.hpp"
+#include "ShaderPreprocessor.hpp"
+#include "LightClusters.hpp"
 
 namespace LowRenderer
 {
 	const unsigned int MAX_DIRECTION_LIGHT = 5;
-	const unsigned int MAX_POINT_LIGHT = 5;
-	const unsigned int MAX_SPOT_LIGHT = 5;
+	const unsigned int MAX_POINT_LIGHT = 512; // Clustered : a fragment only reads the lights of its cluster
+	const unsigned int MAX_SPOT_LIGHT = 512;
 
 	class LightManager
 	{
@@ -17,16 +20,39 @@ namespace LowRenderer
 		std::vector<DirectionLight> directionLights;
 		std::vector<PointLight>		pointLights;
 		std::vector<SpotLight>		spotLights;
+		UniformBlock block;
+		UniformBuffer buffer;
+		Resources::ShaderDefines defines; // Numbers of lights, compile-time constants of the shaders
+
+		// Point and spot lights, in texture buffers read through the clusters
+		LightClusters clusters;
+		std::vector<ClusterLight> volumes; // View space, the point lights then the spot lights
+		std::vector<Core::Maths::Vec4> texels;
+		TextureBuffer lightsTexture;
+		TextureBuffer gridTexture;
+		TextureBuffer indicesTexture;
 
 		// Methode
 	public:
 		LightManager();
 
-		void Draw(const int p_shaderProgram, const Core::Maths::Vec3& p_camPosition);
+		// Once per frame, before the draw of the objects : the lights to the clusters of the camera (no OpenGL),
+		// then the upload of the block and buffers every program reads
+		void AssignClusters(const Core::Maths::Mat4& p_view, const float p_near, const float p_far, const float p_fovY, const float p_aspect);
+		void Update(const Core::Maths::Vec3& p_camPosition);
+		void Pack(UniformBlock& p_block, const Core::Maths::Vec3& p_camPosition) const; // Layout of the "Lights" block
+		void PackLights(std::vector<Core::Maths::Vec4>& p_texels) const;				 // LIGHT_TEXELS per light, the point lights first
 		void DrawImGui();
 
 		void AddDirectionLight(const DirectionLight& p_light);
 		void AddPointLight(const PointLight& p_light);
 		void AddSpotLight(const SpotLight& p_light);
+
+		// Get and Set
+		const Resources::ShaderDefines& GetDefines() const { return defines; };
+		const LightClusters& GetClusters() const { return clusters; };
+
+	private:
+		void UpdateDefines();
 	};
 }
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include <filesystem>
 #include <fstream>
 #include <string>
+#include <cstring>
+
+#include "SpinLock.hpp"
 
 #define __FILENAME__ (strrchr(__FILE__, '\\') ? strrchr(__FILE__, '\\') + 1 : __FILE__)
 
@@ -21,11 +24,12 @@ namespace Core::Debug
 		Critical,
 	};
 
-	static class Log
+	class Log
 	{
 		// Attribute
 	private:
 		static std::ofstream logFile;
+		static SpinLock printLock; // Resources log from the workers
 
 		// Methode
 	public:
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+namespace Core
+{
+	// Read-only view of a whole file mapped in memory (mmap, or a file mapping on Windows)
+	class MappedFile
+	{
+		// Attribute
+	private:
+		const unsigned char* data;
+		size_t size;
+
+#ifdef _WIN32
+		void* file;
+		void* mapping;
+#else
+		int file;
+#endif
+
+		// Methode
+	public:
+		MappedFile();
+		~MappedFile();
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool Open(const std::string& p_path);
+		void Close();
+
+		// Ask the system to read the range ahead, with large sequential reads
+		void Prefetch(const size_t p_offset, const size_t p_size) const;
+
+		// Get and Set
+		const unsigned char* GetData() const { return data; };
+		size_t GetSize() const { return size; };
+		bool IsOpen() const { return data != nullptr; };
+	};
+}
\ No newline at end of file
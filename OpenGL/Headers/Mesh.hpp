@@ -14,6 +14,19 @@ namespace Resources
 		Core::Maths::Vec2 uv;
 	};
 
+	// Attributes of one instance, in columns as the vertex shader reads them
+	struct InstanceData
+	{
+		float model[16];		// Locations 3 to 6
+		float normalMatrix[9];	// Locations 7 to 9
+
+		InstanceData() = default; // Filled after the resize of the instances, on the workers
+		InstanceData(const Core::Maths::Mat4& p_model, const Core::Maths::Mat4& p_normalMatrix);
+	};
+
+	const unsigned int INSTANCE_MODEL_ATTRIBUTE = 3;
+	const unsigned int INSTANCE_NORMAL_ATTRIBUTE = 7;
+
 	class Mesh : public IResource
 	{
 		// Attribute
@@ -21,6 +34,7 @@ namespace Resources
 		unsigned int VBO, VAO, EBO;
 		std::vector<Vertex> vertexBuffer;
 		std::vector<unsigned int> indexBuffer;
+		float radius; // Bounding sphere around the origin of the mesh
 
 
 		// Methode
@@ -30,11 +44,23 @@ namespace Resources
 
 		void Init() override;
 		void InitOpenGL() override;
+		IResource* CreateReload() const override;
+		void SwapReload(IResource& p_reloaded) override;
 		void Draw() const;
+		void Bind() const;		   // Vertex array of the mesh
+		void DrawElements() const; // Once bound
+		static void BindInstances(const size_t p_offset); // Instances from the bound GL_ARRAY_BUFFER, in the bound vertex array
+		void DrawInstances(const unsigned int p_nbInstances) const;
+
+		const char* GetTypeName() const override { return "Mesh"; };
+		ResourceMemory GetMemoryUsage() const override;
 
 		// Get and Set
 		std::vector<Vertex>& GetVertexBuffer() { return vertexBuffer; }
 		std::vector<unsigned int>& GetIndexBuffer() { return indexBuffer; }
+		const std::vector<Vertex>& GetVertexBuffer() const { return vertexBuffer; }
+		const std::vector<unsigned int>& GetIndexBuffer() const { return indexBuffer; }
+		float GetRadius() const { return radius; }
 
 		void LoadMesh();
 	private:
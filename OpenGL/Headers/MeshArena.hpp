@@ -0,0 +1,85 @@
+#pragma once
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+#include "Mesh.hpp"
+
+namespace Resources
+{
+	const size_t ARENA_FULL = SIZE_MAX;
+	const size_t ARENA_VERTICES = 1 << 16; // First capacities, doubled when full
+	const size_t ARENA_INDICES = 1 << 18;
+
+	// First fit over [0, capacity) in elements, the freed ranges merged with their neighbours. No OpenGL.
+	class ArenaAllocator
+	{
+		// Attribute
+	private:
+		std::map<size_t, size_t> freeRanges; // Offset -> size
+		size_t capacity;
+		size_t used;
+
+		// Methode
+	public:
+		ArenaAllocator(const size_t p_capacity = 0);
+
+		size_t Allocate(const size_t p_size); // Offset, ARENA_FULL when no free range is large enough
+		void Free(const size_t p_offset, const size_t p_size);
+		void Grow(const size_t p_capacity);	  // The new elements are free
+
+		// Get and Set
+		size_t GetCapacity() const { return capacity; };
+		size_t GetUsed() const { return used; };
+		size_t GetFreeTail() const; // Free elements before the capacity, a grow extends them
+		size_t GetNbFreeRanges() const { return freeRanges.size(); };
+	};
+
+	// Place of a mesh in the arena, in elements
+	struct ArenaRange
+	{
+		size_t firstVertex = 0;
+		size_t nbVertices = 0;
+		size_t firstIndex = 0;
+		size_t nbIndices = 0;
+		const Vertex* source = nullptr; // Buffer uploaded, another one after a reload
+	};
+
+	// Every mesh drawn by the indirect draws in one vertex buffer and one index buffer, bound once.
+	// The meshes are added on their first draw, the buffers are created then and grown on the GPU when full.
+	// A deleted mesh leaves every arena. OpenGL thread only.
+	class MeshArena
+	{
+		// Attribute
+	private:
+		static std::vector<MeshArena*> arenas;
+
+		unsigned int VAO, VBO, EBO;
+		ArenaAllocator vertices;
+		ArenaAllocator indices;
+		std::unordered_map<const Mesh*, ArenaRange> ranges;
+
+		// Methode
+	public:
+		MeshArena();
+		~MeshArena();
+		MeshArena(const MeshArena&) = delete;
+		MeshArena& operator=(const MeshArena&) = delete;
+
+		const ArenaRange& Add(const Mesh& p_mesh); // OpenGL thread, uploaded again if the mesh was reloaded
+		void Remove(const Mesh& p_mesh);
+		void Bind() const;
+
+		static void RemoveFromAll(const Mesh& p_mesh); // From the destructor of the mesh
+
+		// Get and Set
+		const ArenaAllocator& GetVertices() const { return vertices; };
+		const ArenaAllocator& GetIndices() const { return indices; };
+		size_t GetNbMeshes() const { return ranges.size(); };
+
+	private:
+		void Grow(const size_t p_nbVertices, const size_t p_nbIndices); // Capacities for at least these free elements
+	};
+}
\ No newline at end of file
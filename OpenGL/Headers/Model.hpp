@@ -21,7 +21,10 @@ namespace LowRenderer
 		Model(Resources::Mesh* p_mesh, Resources::Shader* p_shader);
 		Model(Resources::Mesh* p_mesh, Resources::Shader* p_shader, Resources::Texture* p_texture);
 
-		void Draw(const Core::Maths::Mat4& p_transform, const Core::Maths::Mat4& p_mvp) const;
+		void Draw(const Core::Maths::Mat4& p_transform, const Core::Maths::Mat4& p_normalMatrix, const Core::Maths::Mat4& p_mvp) const;
+		void Draw(const Core::Maths::Mat4& p_transform, const Core::Maths::Mat4& p_mvp) const; // Normal matrix computed for this draw
+		void RequestTextureSize(const Core::Maths::Mat4& p_mvp) const; // Levels of the texture streamed for this size on screen
+		float GetScreenSize(const Core::Maths::Mat4& p_mvp) const;	   // In screen heights
 	
 		// Get and Set
 		const int GetShaderProgram() const { return shader->GetShaderProgram(); };
@@ -29,6 +32,11 @@ namespace LowRenderer
 		const std::string GetShaderName()	{ return shader->GetName(); };
 		const std::string GetMeshName()	{ return mesh->GetName(); };
 		Resources::Mesh* GetMesh()  { return mesh; };
+		const Resources::Mesh* GetMesh() const { return mesh; };
+		Resources::Shader* GetShader() { return shader; };
+		const Resources::Shader* GetShader() const { return shader; };
+		Resources::Texture* GetTexture() { return texture; };
+		const Resources::Texture* GetTexture() const { return texture; };
 		bool InitCheck()const;
 	};
 }
\ No newline at end of file
@@ -2,7 +2,10 @@
 
 #include <iostream>
 #include <cmath>
-#include <corecrt_math_defines.h>
+
+#ifndef M_PI
+    #define M_PI 3.14159265358979323846
+#endif
 
 namespace Core::Maths
 {
@@ -238,6 +241,7 @@ namespace Core::Maths
 
         Mat4 Transpose();
         Mat4 GetInverse() const;
+        Mat4 GetNormalMatrix() const; // Inverse transpose of the 3x3 part of an affine matrix, the rest is identity
 
         float Determinant() const;
         Mat4 CofactorMatrix() const;
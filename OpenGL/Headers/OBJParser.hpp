@@ -2,11 +2,11 @@
 
 #include <string>
 #include <sstream>
-#include <fstream>
 
 #include "Mesh.hpp"
 #include "MyMaths.hpp"
 #include "Assertion.hpp"
+#include "FileCache.hpp"
 
 namespace Resources::OBJ
 {
@@ -25,16 +25,21 @@ namespace Resources::OBJ
 		std::vector<index> vertexAlreadySaved;
 	};
 
-	inline void Open(std::ifstream& p_file, const std::string& p_path)
+	inline bool Open(std::istringstream& p_file, const std::string& p_path)
 	{
-		p_file.open(p_path, std::ios::in);
-		Assertion(p_file, "Fail to open obj " + p_path);
+		// From the mounted pack or from the disk
+		std::shared_ptr<const std::string> content = FileCache::Load(p_path);
+		if (!content)
+			return false;
+
+		p_file.str(*content);
 		Core::Debug::Log::Print("Open obj " + p_path + "\n", Core::Debug::LogLevel::Notification);
+		return true;
 	}
 
-	inline void Close(std::ifstream& p_file)
+	inline void Close(std::istringstream& p_file)
 	{
-		p_file.close();
+		p_file.str(std::string());
 		Core::Debug::Log::Print("Close obj\n", Core::Debug::LogLevel::Notification);
 	}
 
@@ -72,11 +77,13 @@ namespace Resources::OBJ
 		}
 	}
 
-	inline void Parse(const std::string& p_path, std::vector<Vertex>& p_vertices, std::vector<unsigned int>& p_indices)
+	// false if the file can not be read
+	inline bool Parse(const std::string& p_path, std::vector<Vertex>& p_vertices, std::vector<unsigned int>& p_indices)
 	{
-		std::ifstream obj;
+		std::istringstream obj;
 
-		Open(obj, p_path);
+		if (!Open(obj, p_path))
+			return false;
 
 		tempOBJ	temp;
 		std::string line;
@@ -121,5 +128,6 @@ namespace Resources::OBJ
 			}
 		}
 		Close(obj);
+		return true;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+
+#include "MyMaths.hpp"
+#include "Mesh.hpp"
+
+namespace LowRenderer
+{
+	const unsigned int OCCLUSION_WIDTH = 256; // Multiple of 4, the rasterizer fills 4 pixels at once
+	const unsigned int OCCLUSION_HEIGHT = 128;
+	const unsigned int OCCLUSION_BAND = 8;	  // Rows rasterized by one job
+	const float OCCLUSION_MIN_W = 1e-3f;	  // Bounds closer to the eye are not projected, the occluders are clipped by the near plane
+
+	// Occluder triangle set up in pixels : inside when the 3 edge functions A * x + B * y + C are positive,
+	// depth in [0, 1] on the plane A * x + B * y + C
+	struct OcclusionTriangle
+	{
+		float edgeA[3];
+		float edgeB[3];
+		float edgeC[3];
+		float depthA, depthB, depthC;
+		int minX, minY, maxX, maxY; // Pixels, max excluded
+	};
+
+	struct OcclusionLevel
+	{
+		unsigned int width = 0;
+		unsigned int height = 0;
+		std::vector<float> minDepth;
+		std::vector<float> maxDepth;
+	};
+
+	// Software occlusion culling : the occluders are rasterized by the CPU in a small depth buffer,
+	// reduced to a min/max depth pyramid, then the bounds of the other objects are tested against it.
+	// Depth grows toward far, 1 where no occluder was drawn.
+	class OcclusionBuffer
+	{
+		// Attribute
+	private:
+		std::vector<OcclusionTriangle> triangles;
+		std::vector<std::vector<unsigned int>> bins; // Triangles touching each band of rows
+		std::vector<float> depth;
+		std::vector<OcclusionLevel> pyramid;		 // Level 0 is the depth buffer
+		std::vector<Core::Maths::Vec4> projected;	 // Vertices of the occluder being added, in clip space
+
+		// Methode
+	public:
+		OcclusionBuffer();
+
+		void Clear();
+		void AddOccluder(const std::vector<Resources::Vertex>& p_vertices, const std::vector<unsigned int>& p_indices, const Core::Maths::Mat4& p_mvp);
+		void Rasterize();		// Bands on the job system, 4 pixels at once with SSE
+		void RasterizeScalar(); // Reference
+		void BuildPyramid();
+
+		// Once the pyramid is built, true when the box around the sphere is behind the occluders everywhere it covers
+		bool IsOccluded(const Core::Maths::Vec3& p_center, const float p_radius, const Core::Maths::Mat4& p_viewProjection) const;
+
+		// Get and Set
+		size_t GetNbTriangles() const { return triangles.size(); };
+		const std::vector<float>& GetDepth() const { return depth; };
+		const std::vector<OcclusionLevel>& GetPyramid() const { return pyramid; };
+
+	private:
+		void AddTriangle(const Core::Maths::Vec4& p_clip0, const Core::Maths::Vec4& p_clip1, const Core::Maths::Vec4& p_clip2); // Clip space, in front of the near plane
+		void RasterizeBand(const unsigned int p_band);
+		void RasterizeBandScalar(const unsigned int p_band);
+		bool IsRegionOccluded(const unsigned int p_level, const int p_minX, const int p_minY, const int p_maxX, const int p_maxY, const float p_depth) const; // Pixels of level 0, max included
+	};
+}
\ No newline at end of file
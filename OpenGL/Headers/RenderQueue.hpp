@@ -0,0 +1,168 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+#include "Model.hpp"
+#include "ShaderPreprocessor.hpp"
+#include "MeshArena.hpp"
+
+namespace LowRenderer
+{
+	const unsigned int MIN_INSTANCES = 2; // Identical draws below this count are drawn one by one
+	const unsigned int SORT_GRAIN = 2048; // Commands per chunk of the radix sort and of the instances, on the workers
+	const char* const INSTANCED_DEFINE = "INSTANCED";
+
+	// Passes in the order they are drawn
+	enum class RenderPass : uint8_t
+	{
+		Opaque,		 // Front to back
+		Transparent, // Back to front
+	};
+
+	// Sort key, from the most significant bits : pass (4) | shader (12) | texture (16) | mesh (16) | depth (16).
+	// The draws sharing a shader, then a texture, then a mesh follow each other once sorted.
+	struct RenderCommand
+	{
+		uint64_t key;
+		unsigned int draw; // Index in the draws of the queue, in the order they were added
+	};
+
+	struct RenderDraw
+	{
+		Resources::Shader* shader;
+		Resources::Texture* texture;
+		Resources::Mesh* mesh;
+		const Core::Maths::Mat4* transform;	   // Kept by the game object until the submit
+		const Core::Maths::Mat4* normalMatrix;
+		Core::Maths::Mat4 mvp;
+	};
+
+	// Sorted draws sharing their shader, texture and mesh
+	struct RenderBatch
+	{
+		unsigned int first;		   // In the sorted commands
+		unsigned int nbDraws;
+		unsigned int firstInstance; // In the instances, if nbDraws >= MIN_INSTANCES
+	};
+
+	// Layout read by glMultiDrawElementsIndirect
+	struct DrawElementsIndirectCommand
+	{
+		uint32_t count;
+		uint32_t instanceCount;
+		uint32_t firstIndex;
+		int32_t baseVertex;
+		uint32_t baseInstance; // First of the instances, read by the instanced attributes
+	};
+
+	// Indirect commands drawn by one glMultiDrawElementsIndirect
+	struct IndirectRun
+	{
+		Resources::Shader* shader;
+		Resources::Texture* texture;
+		unsigned int firstCommand;
+		unsigned int nbCommands;
+	};
+
+	// Draws recorded by one job of RenderQueue::Record, kept in the list until the submit.
+	// Nothing shared is written while recording : the sizes requested to the textures wait for the sort.
+	class RenderList
+	{
+		// Attribute
+	private:
+		std::vector<uint64_t> keys;
+		std::vector<RenderDraw> draws;
+		std::vector<std::pair<Resources::Texture*, float>> screenSizes; // Biggest size per texture
+
+		// Methode
+	public:
+		void Clear();
+		void Add(Model& p_model, const Core::Maths::Mat4& p_transform, const Core::Maths::Mat4& p_normalMatrix, const Core::Maths::Mat4& p_mvp, const RenderPass p_pass = RenderPass::Opaque);
+
+		// Get and Set
+		const std::vector<uint64_t>& GetKeys() const { return keys; };
+		const std::vector<RenderDraw>& GetDraws() const { return draws; };
+		const std::vector<std::pair<Resources::Texture*, float>>& GetScreenSizes() const { return screenSizes; };
+	};
+
+	struct RenderQueueStats
+	{
+		unsigned int nbDraws = 0;
+		unsigned int nbDrawCalls = 0;	  // glDrawElements, glDrawElementsInstanced and glMultiDrawElementsIndirect
+		unsigned int nbInstanced = 0;	  // Draws in the instanced batches
+		unsigned int nbShaderChanges = 0;
+		unsigned int nbTextureChanges = 0;
+		unsigned int nbMeshChanges = 0;
+	};
+
+	// Draws of a frame recorded as commands, sorted by their key, then submitted
+	// binding the shader, the texture and the mesh only when they change.
+	// The identical draws are gathered in one instanced draw, their matrices in an instance buffer.
+	// Indirect, every mesh is in one arena and every batch is one command : one multi-draw per shader and texture.
+	class RenderQueue
+	{
+		// Attribute
+	private:
+		std::vector<RenderList> lists;		  // Draws of the frame in the order of Add and Record, kept between frames
+		unsigned int nbLists;
+		bool addOpen;						  // The last list takes the next Add
+		std::vector<RenderCommand> commands;  // Gathered from the lists by Sort
+		std::vector<RenderCommand> sorted;	  // Buffer of the radix sort, kept between frames
+		std::vector<const RenderDraw*> draws; // In the lists
+		std::vector<uint8_t> batchStarts;	  // Per sorted command, 1 if it starts a batch
+		std::vector<RenderBatch> batches;
+		std::vector<Resources::InstanceData> instances;
+		unsigned int instanceBuffer;
+		bool instancing;
+		bool indirect;
+		Resources::MeshArena arena;
+		std::vector<DrawElementsIndirectCommand> indirectCommands;
+		std::vector<IndirectRun> runs;
+		unsigned int indirectBuffer;
+		Resources::ShaderDefines instancedDefines; // Defines of the frame with INSTANCED
+		uint64_t instancedFrom;					   // Key of these defines of the frame
+		RenderQueueStats stats;
+
+		// Methode
+	public:
+		RenderQueue();
+		~RenderQueue();
+		RenderQueue(const RenderQueue&) = delete;
+		RenderQueue& operator=(const RenderQueue&) = delete;
+
+		void Clear();
+		void Add(Model& p_model, const Core::Maths::Mat4& p_transform, const Core::Maths::Mat4& p_normalMatrix, const Core::Maths::Mat4& p_mvp, const RenderPass p_pass = RenderPass::Opaque);
+
+		// p_record(begin, end, list) on the chunks of p_grain items on the workers, each chunk in its own list :
+		// once sorted the draws are in the same order as recorded by Add on one thread
+		void Record(const unsigned int p_count, const unsigned int p_grain, const std::function<void(unsigned int, unsigned int, RenderList&)>& p_record);
+		void Sort(); // Gathers the commands of the lists, then groups the identical draws and gathers the instances
+		void Submit(const Resources::ShaderDefines& p_defines, const Core::Maths::Mat4& p_viewProjection); // OpenGL thread, after Sort
+
+		// One command per batch, its mesh added to the arena, and the runs of the batches sharing a shader and a texture
+		static void BuildIndirect(const std::vector<RenderBatch>& p_batches, const std::vector<RenderCommand>& p_commands, const std::vector<const RenderDraw*>& p_draws,
+			Resources::MeshArena& p_arena, std::vector<DrawElementsIndirectCommand>& p_indirectCommands, std::vector<IndirectRun>& p_runs);
+
+		static uint64_t MakeKey(const RenderPass p_pass, const int p_shader, const int p_texture, const int p_mesh, const float p_depth);
+		static void RadixSort(std::vector<RenderCommand>& p_commands, std::vector<RenderCommand>& p_buffer); // On the workers, by chunks of SORT_GRAIN
+
+		// Get and Set
+		const RenderQueueStats& GetStats() const { return stats; };
+		const std::vector<RenderCommand>& GetCommands() const { return commands; }; // After Sort
+		const std::vector<RenderBatch>& GetBatches() const { return batches; };
+		const std::vector<Resources::InstanceData>& GetInstances() const { return instances; };
+		const std::vector<DrawElementsIndirectCommand>& GetIndirectCommands() const { return indirectCommands; }; // After Submit
+		const std::vector<IndirectRun>& GetIndirectRuns() const { return runs; };
+		const Resources::MeshArena& GetArena() const { return arena; };
+		void SetInstancing(const bool p_instancing) { instancing = p_instancing; }; // Before Sort
+		void SetIndirect(const bool p_indirect) { indirect = p_indirect; };			// Before Sort
+
+	private:
+		RenderList& NextList();
+		void Gather();
+		void BuildBatches();
+		void SubmitIndirect(const Core::Maths::Mat4& p_viewProjection);
+	};
+}
\ No newline at end of file
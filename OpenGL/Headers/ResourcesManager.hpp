@@ -1,20 +1,68 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <array>
 #include <unordered_map>
+#include <map>
 #include <iostream>
 #include <memory>
+#include <atomic>
+#include <typeinfo>
 
 #include "Assertion.hpp"
+#include "SpinLock.hpp"
 #include "IResource.hpp"
+#include "FileCache.hpp"
+#include "TextureAtlas.hpp"
+#include "TextureStreamer.hpp"
 
 namespace Resources
 {
+	const unsigned int NB_RESOURCE_SHARDS = 16;
+	const char* const MEMORY_REPORT_PATH = "MemoryReport.json";
+
+	// Lookups only lock the shard of the name, and in read mode
+	struct ResourceShard
+	{
+		mutable Core::SharedSpinLock lock;
+		std::unordered_map<std::string, std::shared_ptr<IResource>> resources;
+	};
+
+	struct ResourceMemoryEntry
+	{
+		std::string name;
+		std::string type;
+		ResourceMemory memory;
+	};
+
+	struct MemoryReport
+	{
+		std::vector<ResourceMemoryEntry> resources; // Once per resource, even shared by several names, with the ones owned by a scene
+		std::map<std::string, ResourceMemory> types;
+		std::map<std::string, ResourceMemory> scenes; // Resources used by the scene
+		ResourceMemory total;
+	};
+
+	// Create, GetResource and Delete can be called from any thread.
+	// The pointer of GetResource is not owned: it stays valid only while no other thread deletes the name.
+	// The last owner of a resource must be released on the OpenGL thread (Delete, DeleteResources).
 	class ResourceManager
 	{
 		// Attribute
 	private:
-		std::unordered_map<std::string, std::unique_ptr<IResource>> resources;
+		// Declared first, the textures leave the streamer when the shards destroy them
+		TextureAtlas atlas; // Pages of the small textures, cleared with the resources
+		TextureStreamer streamer;
+
+		// A resource can be owned by several names when they resolve to the same files
+		std::array<ResourceShard, NB_RESOURCE_SHARDS> shards;
+		std::atomic<unsigned int> nextId;
+
+		Core::SpinLock sourcesLock;
+		std::unordered_map<std::string, std::weak_ptr<IResource>> sources; // Type + canonical paths -> resource
+		unsigned int nbShared;
+		size_t bytesShared;
 
 		// Methode
 	public:
@@ -26,29 +74,75 @@ namespace Resources
 		void Delete(const std::string p_name);
 		void DeleteResources();
 
-		const bool CheckAllResourcesLoaded();
+		// path1 and path2 are resolved through the pack while it is mounted
+		bool MountPack(const std::string& p_path);
+		void UnmountPack();
+
+		const bool CheckAllResourcesLoaded() const;
+		std::vector<IResource*> GetResourcesFromPath(const std::string& p_path) const;
+		void PrintSharingReport();
+
+		// Loaded resources only, from the OpenGL thread
+		MemoryReport GetMemoryReport() const;
+		bool DumpMemoryReport(const std::string& p_path) const; // JSON
+		void DrawMemoryWindow() const;
 		
 		// Get and Set
 		template <typename T>
 		T* GetResource(const std::string p_name) const;
+		unsigned int GetNbResources() const;
+		unsigned int GetNbShared() const { return nbShared; }; // Names given to an already created resource
+		TextureAtlas& GetAtlas() { return atlas; };
+		TextureStreamer& GetStreamer() { return streamer; };
+		const TextureStreamer& GetStreamer() const { return streamer; };
+
+	private:
+		ResourceShard& GetShard(const std::string& p_name);
+		const ResourceShard& GetShard(const std::string& p_name) const;
+		IResource* Find(const std::string& p_name) const;
+		void Insert(const std::string& p_name, const std::shared_ptr<IResource>& p_resource);
+
+		std::string GetSourceKey(const std::string& p_type, const std::string& p_path1, const std::string& p_path2) const;
+		IResource* ShareResource(const std::string& p_name, const std::string& p_key);
 	};
 
 	template <typename T>
 	T* ResourceManager::Create(const std::string p_name, const std::string p_path1, const std::string p_path2)
 	{
 		static_assert(std::is_base_of<IResource, T>::value, "T is not a compatible resource");
+
+		const std::string key = GetSourceKey(typeid(T).name(), p_path1, p_path2);
+
+		// Two producers creating the same source must end with the same resource
+		if (!key.empty())
+		{
+			sourcesLock.Lock();
+			if (IResource* shared = ShareResource(p_name, key))
+			{
+				sourcesLock.Unlock();
+				return static_cast<T*>(shared);
+			}
+		}
 		
-		const unsigned int id = resources.size();
-		auto [it, _] = resources.insert_or_assign(p_name, std::make_unique<T>(p_name, p_path1, p_path2, id));
+		// The id only identify the resource, it is not an OpenGL binding slot
+		const unsigned int id = nextId.fetch_add(1);
+		std::shared_ptr<IResource> resource = std::make_shared<T>(p_name, p_path1, p_path2, id);
+		Insert(p_name, resource);
+
+		if (!key.empty())
+		{
+			sources.insert_or_assign(key, resource);
+			sourcesLock.Unlock();
+		}
 		
 		Core::Debug::Log::Print("Add element " + p_name + " in resources\n", Core::Debug::LogLevel::Notification);
-		return static_cast<T*>(it->second.get());
+		return static_cast<T*>(resource.get());
 	}
 
 	template <typename T>
 	T* ResourceManager::GetResource(const std::string p_name) const
 	{
-		T* resource = static_cast<T*>(resources.find(p_name)->second.get());
+		T* resource = static_cast<T*>(Find(p_name));
 		Assertion(resource, p_name + " is not in resources");
 		return resource;
 	}
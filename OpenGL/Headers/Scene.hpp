@@ -1,7 +1,7 @@
 #pragma once
 
-#include <GLFW/glfw3.h>
 #include <glad/glad.h>
+#include <GLFW/glfw3.h>
 
 // Resources
 #include "IResource.hpp"
@@ -10,6 +10,7 @@
 #include "Camera.hpp"
 #include "GameObject.hpp"
 #include "LightManager.hpp"
+#include "StaticBatch.hpp"
 
 // Physics
 #include "PhysicManager.hpp"
@@ -36,6 +37,8 @@ namespace Resources
 		SceneType sceneType;
 	};
 
+	class ResourceManager;
+
 	class Scene : public IResource
 	{
 		// Attribute
@@ -44,8 +47,11 @@ namespace Resources
 		std::vector<LowRenderer::GameObject*> gameObjects;
 		LowRenderer::LightManager lightManager;
 		Core::DataStructure::Graph graph;
+		LowRenderer::RenderQueue renderQueue; // Draws of the graph, sorted each frame
+		LowRenderer::StaticBatch staticBatch;
 		Physics::PhysicsManager m_physicsManager;
 		Core::Editor::InterfaceEditor m_editor;
+		const ResourceManager* resources; // Memory window of the editor
 
 	protected:
 		unsigned int width;
@@ -60,6 +66,9 @@ namespace Resources
 		virtual void Update(const Core::Inputs& p_Inputs, const double& p_deltaTime);
 		virtual void Draw(const Core::Inputs& p_Inputs, std::chrono::duration<double>& elapsedMono, std::chrono::duration<double>& elapsedMulti);
 
+		const char* GetTypeName() const override { return "Scene"; };
+		void GetUsedResources(std::vector<const IResource*>& p_resources) const override;
+
 		void AddGameObject(LowRenderer::GameObject* p_gameObject, LowRenderer::GOType p_type = LowRenderer::GOType::None);
 		void AddDirectionLight(const LowRenderer::DirectionLight& p_light);
 		void AddPointLight(const LowRenderer::PointLight& p_light);
@@ -68,6 +77,8 @@ namespace Resources
 		Physics::Collider* CreateCollider(Resources::Mesh* p_mesh, Resources::Shader* p_shader, Physics::ColliderTypes types,bool isStatic);
 		Physics::Collider* GetLastCollider() { return m_physicsManager.colliders[m_physicsManager.colliders.size()-1]; }
 
+		void SetResourceManager(const ResourceManager* p_resources) { resources = p_resources; };
+		void SetIndirectDraws(const bool p_indirect) { renderQueue.SetIndirect(p_indirect); };
 		bool SetParent(const std::string& p_nameParent, const std::string& p_nameChild) { return graph.SetParent(p_nameParent, p_nameChild); };
 		void DrawTimer(std::chrono::duration<double>& elapsedMono, std::chrono::duration<double>& elapsedMulti);
 
@@ -1,42 +1,108 @@
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
 #include "IResource.hpp"
 #include "MyMaths.hpp"
 #include "Light.hpp"
+#include "ShaderPreprocessor.hpp"
 
 namespace Resources
 {
+	const unsigned int LIGHTS_BLOCK_BINDING = 0; // Uniform buffer of the LightManager
+
+	// Texture buffers of the clustered lights, after the diffuse texture
+	const unsigned int CLUSTER_LIGHTS_TEXTURE_UNIT = 1;
+	const unsigned int CLUSTER_GRID_TEXTURE_UNIT = 2;
+	const unsigned int CLUSTER_INDICES_TEXTURE_UNIT = 3;
+
+	// FNV-1a of a uniform name, computed at compile time for the names known by the code
+	constexpr uint64_t UniformHash(const char* p_name, const uint64_t p_hash = 14695981039346656037ull)
+	{
+		return *p_name ? UniformHash(p_name + 1, (p_hash ^ (unsigned char)*p_name) * 1099511628211ull) : p_hash;
+	}
+
+	// The keys are already hashed
+	struct UniformHasher
+	{
+		size_t operator()(const uint64_t p_hash) const { return (size_t)p_hash; };
+	};
+
+	// Program compiled for one set of defines
+	struct ShaderVariant
+	{
+		int program = 0;
+		int programSize = 0; // Binary size given by the driver
+
+		// Active uniforms reflected once after the link : name hash -> location
+		std::unordered_map<uint64_t, int, UniformHasher> uniforms;
+		int modelLocation = -1;
+		int mvpLocation = -1;
+		int normalMatrixLocation = -1;
+		int viewProjectionLocation = -1; // Instanced variant
+		ShaderDefines defines;			 // Given to Use, compiled again by a reload
+	};
+
 	class Shader : public IResource
 	{
 		// Attribute
 	private:
-		int vertexShader;
-		int fragmentShader;
-		int shaderProgram;
 		// path1 = path VertexShader
 		// path2 = path FragmentShader
-		const char* sourceVertex;
-		const char* sourceFragment;
-		std::string tempSourceV;
-		std::string tempSourceF;
+		// Includes resolved, without the defines of the variants
+		std::shared_ptr<const std::string> sourceVertex;
+		std::shared_ptr<const std::string> sourceFragment;
+		std::vector<std::string> includes; // Canonical paths, a change reloads the shader
+		ShaderDefines defines;			   // Of every variant of this shader
+
+		// Permutation cache : key of the defines given to Use -> program, compiled on the first use
+		std::unordered_map<uint64_t, ShaderVariant> variants;
+		ShaderVariant* current;
+		std::vector<ShaderDefines> reloadVariants; // Variants of the version reloaded, compiled by InitOpenGL
 
 		// Methodes
 	public:
 		Shader(const std::string& p_name, const std::string& p_path1, const std::string& p_path2, const unsigned int p_id);
+		~Shader();
 
 		void Init() override;
 		void InitOpenGL() override;
-		void Draw(const Core::Maths::Mat4& p_transform, const Core::Maths::Mat4& p_mvp);
+		IResource* CreateReload() const override;
+		void SwapReload(IResource& p_reloaded) override;
+		void Draw(const Core::Maths::Mat4& p_transform, const Core::Maths::Mat4& p_normalMatrix, const Core::Maths::Mat4& p_mvp);
+		void DrawInstances(const Core::Maths::Mat4& p_viewProjection); // The matrices of the objects are instance attributes
+		void Use(const ShaderDefines& p_defines); // Main thread, binds the variant of these defines
 
-		const int GetShaderProgram() const { return shaderProgram; }
+		const char* GetTypeName() const override { return "Shader"; };
+		ResourceMemory GetMemoryUsage() const override;
+		bool DependsOn(const std::string& p_canonicalPath) const override;
 
-	private:
-		bool SetVertexShader();
-		bool SetFragmentShader();
-		bool Link();
+		const int GetShaderProgram() const { return current ? current->program : 0; }
+		int GetLocation(const uint64_t p_name) const; // -1 if the uniform is not active in the current variant
+		unsigned int GetNbUniforms() const { return current ? (unsigned int)current->uniforms.size() : 0; };
+		unsigned int GetNbVariants() const { return (unsigned int)variants.size(); };
+		void SetDefines(const ShaderDefines& p_defines) { defines = p_defines; }; // Before Init
+
+		// Typed setters on a location given by GetLocation, -1 is ignored
+		static void SetInt(const int p_location, const int p_value);
+		static void SetFloat(const int p_location, const float p_value);
+		static void SetVec3(const int p_location, const Core::Maths::Vec3& p_value);
+		static void SetVec4(const int p_location, const Core::Maths::Vec4& p_value);
+		static void SetMat3(const int p_location, const Core::Maths::Mat4& p_value); // 3x3 part
+		static void SetMat4(const int p_location, const Core::Maths::Mat4& p_value);
 
-		void OpenShader(const std::string& p_path, std::ifstream& p_source);
-		void CloseShader(const std::string& p_path, std::ifstream& p_source);
+		static const ShaderDefines& GetEngineDefines(); // Limits of the engine, defined in every variant
+
+	private:
+		ShaderVariant& GetVariant(const ShaderDefines& p_defines);
+		ShaderVariant* CompileVariant(const ShaderDefines& p_defines); // nullptr if it does not compile or link
+		int Compile(const int p_type, const std::string& p_source) const;
+		bool Link(ShaderVariant& p_variant, const int p_vertexShader, const int p_fragmentShader) const;
+		void ReflectUniforms(ShaderVariant& p_variant) const;
 	};
 
 }
\ No newline at end of file
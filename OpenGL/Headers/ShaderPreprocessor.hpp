@@ -0,0 +1,61 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+namespace Resources
+{
+	// Set of "#define name value" of a shader variant. Sorted by name, so the key does not
+	// depend on the order of the Set calls.
+	class ShaderDefines
+	{
+		// Attribute
+	private:
+		std::map<std::string, std::string> defines;
+		uint64_t key;
+
+		// Methode
+	public:
+		ShaderDefines();
+
+		void Set(const std::string& p_name, const std::string& p_value = "");
+		void Set(const std::string& p_name, const int p_value);
+		void Merge(const ShaderDefines& p_defines); // The values of p_defines win
+
+		// Get and Set
+		uint64_t GetKey() const { return key; }; // Key of the variant in the permutation cache
+		bool IsEmpty() const { return defines.empty(); };
+		std::string GetLines() const;
+
+	private:
+		void UpdateKey();
+	};
+
+	struct PreprocessedShader
+	{
+		std::string source;
+		std::vector<std::string> files; // Source string numbers of the #line directives, 0 is the shader itself
+		std::string error;				// First include missing or malformed, empty if none
+	};
+
+	using ShaderReader = std::function<std::shared_ptr<const std::string>(const std::string&)>;
+
+	class ShaderPreprocessor
+	{
+		// Methode
+	public:
+		// Replaces the #include "file" by the file, relative to the including file. Each file is
+		// included once. The reader is FileCache::Read, the tests give their own sources.
+		static PreprocessedShader ResolveIncludes(const std::string& p_source, const std::string& p_path, const ShaderReader& p_reader);
+		// Inserts the defines after the #version line
+		static std::string InjectDefines(const std::string& p_source, const ShaderDefines& p_defines);
+
+	private:
+		static void Include(const std::string& p_source, const std::string& p_path, const ShaderReader& p_reader, PreprocessedShader& p_result);
+		static bool ParseInclude(const std::string& p_line, std::string& p_file); // p_file empty if the include is malformed
+	};
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+namespace Core
+{
+	// Lock built on an atomic boolean, as the queues of ThreadsManager : the engine uses no mutex.
+	// For short sections only, a waiting thread gives its core back on each try.
+	class SpinLock
+	{
+		// Attribute
+	private:
+		std::atomic<bool> locked;
+
+		// Methode
+	public:
+		SpinLock() : locked(false) {};
+		SpinLock(const SpinLock&) = delete;
+		SpinLock& operator=(const SpinLock&) = delete;
+
+		void Lock()
+		{
+			// Read before writing : the waiting threads do not fight for the cache line
+			while (locked.exchange(true, std::memory_order_acquire))
+			{
+				while (locked.load(std::memory_order_relaxed))
+					std::this_thread::yield();
+			}
+		}
+
+		void Unlock() { locked.store(false, std::memory_order_release); };
+	};
+
+	// Several readers, or one writer. A waiting writer blocks the new readers so it is not starved.
+	class SharedSpinLock
+	{
+		// Attribute
+	private:
+		static const unsigned int WRITER = 1u << 31;
+		std::atomic<unsigned int> state; // Writer bit | number of readers
+
+		// Methode
+	public:
+		SharedSpinLock() : state(0) {};
+		SharedSpinLock(const SharedSpinLock&) = delete;
+		SharedSpinLock& operator=(const SharedSpinLock&) = delete;
+
+		void Lock()
+		{
+			unsigned int expected = state.load(std::memory_order_relaxed);
+			while ((expected & WRITER) || !state.compare_exchange_weak(expected, expected | WRITER, std::memory_order_acquire))
+			{
+				std::this_thread::yield();
+				expected = state.load(std::memory_order_relaxed);
+			}
+
+			// The readers already in leave
+			while (state.load(std::memory_order_acquire) != WRITER)
+				std::this_thread::yield();
+		}
+
+		void Unlock() { state.store(0, std::memory_order_release); };
+
+		void LockShared()
+		{
+			unsigned int expected = state.load(std::memory_order_relaxed);
+			while ((expected & WRITER) || !state.compare_exchange_weak(expected, expected + 1, std::memory_order_acquire))
+			{
+				std::this_thread::yield();
+				expected = state.load(std::memory_order_relaxed);
+			}
+		}
+
+		void UnlockShared() { state.fetch_sub(1, std::memory_order_release); };
+	};
+
+	// Locked while it lives
+	template <typename T>
+	class ScopedLock
+	{
+		// Attribute
+	private:
+		T& lock;
+
+		// Methode
+	public:
+		ScopedLock(T& p_lock) : lock(p_lock) { lock.Lock(); };
+		~ScopedLock() { lock.Unlock(); };
+		ScopedLock(const ScopedLock&) = delete;
+		ScopedLock& operator=(const ScopedLock&) = delete;
+	};
+
+	class ScopedSharedLock
+	{
+		// Attribute
+	private:
+		SharedSpinLock& lock;
+
+		// Methode
+	public:
+		ScopedSharedLock(SharedSpinLock& p_lock) : lock(p_lock) { lock.LockShared(); };
+		~ScopedSharedLock() { lock.UnlockShared(); };
+		ScopedSharedLock(const ScopedSharedLock&) = delete;
+		ScopedSharedLock& operator=(const ScopedSharedLock&) = delete;
+	};
+}
\ No newline at end of file
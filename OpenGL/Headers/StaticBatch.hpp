@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+
+#include "GameObject.hpp"
+
+namespace LowRenderer
+{
+	const unsigned int STATIC_BATCH_MESH_ID = 0xF000; // Ids of the merged meshes, above the ones of the resource manager
+
+	// Objects drawn with the same shader and texture, merged in one mesh
+	struct StaticGroup
+	{
+		Resources::Shader* shader;
+		Resources::Texture* texture;
+		bool occluder;
+		std::vector<const Resources::Mesh*> meshes;
+		std::vector<const Physics::Transform*> transforms;
+		std::vector<const Resources::Vertex*> sources; // Vertex buffer of each mesh when merged, another one once reloaded
+	};
+
+	// Static objects of a scene merged by material : their vertices in world space in one mesh per shader,
+	// texture and occluder flag, drawn with one call each instead of one per object.
+	// Built once every static object is loaded and placed, their transform is not read anymore.
+	// A group is merged again when one of its meshes is reloaded.
+	class StaticBatch
+	{
+		// Attribute
+	private:
+		std::vector<StaticGroup> groups;
+		std::vector<std::unique_ptr<Resources::Mesh>> meshes; // One per group
+		std::vector<GameObject*> batches; // One per mesh, owned by the scene once added
+		bool built;
+
+		// Methode
+	public:
+		StaticBatch();
+
+		// False while a static object is still loading. Once built the static objects are not drawn anymore, their batches are
+		bool Build(const std::vector<GameObject*>& p_gameObjects);
+		unsigned int Update(); // OpenGL thread, merges again the groups of the reloaded meshes. Number of groups merged
+
+		// Vertices of the meshes in world space and their indices, one after the other : one job per mesh on the workers
+		static void Merge(const std::vector<const Resources::Mesh*>& p_meshes, const std::vector<const Physics::Transform*>& p_transforms,
+			std::vector<Resources::Vertex>& p_vertices, std::vector<unsigned int>& p_indices);
+
+		// Get and Set
+		bool IsBuilt() const { return built; };
+		const std::vector<GameObject*>& GetBatches() const { return batches; };
+		const std::vector<std::unique_ptr<Resources::Mesh>>& GetMeshes() const { return meshes; };
+
+	private:
+		std::unique_ptr<Resources::Mesh> MergeGroup(StaticGroup& p_group, const unsigned int p_index) const; // Uploaded
+	};
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace Core::Debug
+{
+	void TestFrustum();
+
+	void TestFrustumPlanes();
+	void TestFrustumCulling();
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+namespace Core::Debug
+{
+	void TestLightManager();
+
+	void TestStd140Scalars();
+	void TestStd140Structs();
+	void TestLightsBlock();
+	void TestLightRange();
+	void TestLightClusters();
+	void TestLightClustersCoverage();
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+
+namespace Core::Debug
+{
+	void TestMeshArena();
+
+	void TestArenaAllocator();
+	void TestMeshArenaAdd();
+	void TestMeshArenaFragmented();
+	void TestRenderIndirect();
+}
\ No newline at end of file
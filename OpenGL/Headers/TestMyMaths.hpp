@@ -36,4 +36,5 @@ namespace Core::Debug
 	void TestRotationYMat4();
 	void TestRotationZMat4();
 	void TestScaleMat4();
+	void TestNormalMatrixMat4();
 }
\ No newline at end of file
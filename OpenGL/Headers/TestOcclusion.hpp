@@ -0,0 +1,11 @@
+#pragma once
+
+namespace Core::Debug
+{
+	void TestOcclusion();
+
+	void TestOcclusionRasterizer();
+	void TestOcclusionPyramid();
+	void TestOcclusionQueries();
+	void TestOcclusionNearPlane();
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace Core::Debug
+{
+	void TestRenderQueue();
+
+	void TestRenderKey();
+	void TestRadixSort();
+	void TestRenderSubmit();
+	void TestRenderInstancing();
+	void TestRenderRecord();
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#pragma once
+
+namespace Core::Debug
+{
+	void TestResourcesManager();
+
+	void TestConcurrentCreate();
+	void TestConcurrentShare();
+	void TestConcurrentDelete();
+}
\ No newline at end of file
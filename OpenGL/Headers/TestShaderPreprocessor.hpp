@@ -0,0 +1,10 @@
+#pragma once
+
+namespace Core::Debug
+{
+	void TestShaderPreprocessor();
+
+	void TestShaderIncludes();
+	void TestShaderDefines();
+	void TestShaderVariantKey();
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#pragma once
+
+namespace Core::Debug
+{
+	void TestStaticBatch();
+
+	void TestStaticBatchMerge();
+	void TestStaticBatchWorkers();
+	void TestStaticBatchReload();
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#pragma once
+
+namespace Core::Debug
+{
+	void TestTextureAtlas();
+
+	void TestAtlasPack();
+	void TestAtlasRegion();
+	void TestAtlasReload();
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+namespace Core::Debug
+{
+	void TestTextureBaker();
+
+	void TestMipmapsSize();
+	void TestMipmapsConstant();
+	void TestMipmapsGamma();
+	void TestMipmapsCompress();
+	void TestTextureCache();
+	void TestTextureReloadFailed();
+}
\ No newline at end of file
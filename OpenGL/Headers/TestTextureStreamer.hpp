@@ -0,0 +1,11 @@
+#pragma once
+
+namespace Core::Debug
+{
+	void TestTextureStreamer();
+
+	void TestStreamingWantedLevel();
+	void TestStreamingPriority();
+	void TestStreamingBudget();
+	void TestStreamingUpload();
+}
\ No newline at end of file
@@ -1,9 +1,19 @@
 #pragma once
 
+#include <algorithm>
+
 #include "IResource.hpp"
+#include "TextureBaker.hpp"
+#include "TextureAtlas.hpp"
+#include "TextureStreamer.hpp"
 
 namespace Resources
 {
+	class Shader;
+
+	// Texture unit of the diffuse texture, a resource id is not a binding slot
+	const unsigned int DIFFUSE_TEXTURE_UNIT = 0;
+
 	class Texture : public IResource
 	{
 		// Attribute
@@ -12,8 +22,25 @@ namespace Resources
 		unsigned int sampler;
 
 		// Init
-		unsigned char* data;
-		int width, height, nrChannels;
+		TextureData textureData;
+		int width, height;
+		TextureFormat format;
+		size_t gpuSize;
+
+		// Small textures are drawn from a page of the atlas instead
+		bool inAtlas;
+		bool standalone; // Reloaded : a region of the atlas can not be freed, a new one per reload would fill the pages
+		AtlasRegion region;
+
+		// Levels finer than the tail are streamed, textureData is kept to upload them again after an eviction
+		unsigned int tailLevel;
+		unsigned int residentLevel;
+		float screenSize; // Biggest size on screen requested this frame, in screen heights
+
+	public:
+		static bool compression; // BC1/BC3 baked on the workers, else RGB8/RGBA8. Both are cached in Cache/Textures
+		static TextureAtlas* atlas; // nullptr : every texture has its own binding
+		static TextureStreamer* streamer; // nullptr : every level is uploaded at once
 
 		// Methode
 	public:
@@ -22,6 +49,19 @@ namespace Resources
 
 		void Init() override;
 		void InitOpenGL() override;
-		void Draw(const unsigned int p_shaderProgram);
+		IResource* CreateReload() const override;
+		void SwapReload(IResource& p_reloaded) override;
+		void Draw(const Shader& p_shader);
+
+		void RequestScreenSize(const float p_screenSize) { screenSize = std::max(screenSize, p_screenSize); };
+		void GetStreamingEntry(const float p_screenHeight, StreamingEntry& p_entry);
+		void SetResidentLevel(const unsigned int p_level);
+
+		const char* GetTypeName() const override { return "Texture"; };
+		ResourceMemory GetMemoryUsage() const override;
+
+	private:
+		void UploadLevel(const unsigned int p_level);
+		void FreeLevel(const unsigned int p_level);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "../stb-master/stb_rect_pack.h"
+#include "TextureBaker.hpp"
+
+namespace Resources
+{
+	const uint32_t ATLAS_PAGE_SIZE = 1024;
+	const uint32_t ATLAS_NB_LEVELS = 4;
+	const uint32_t ATLAS_MAX_TEXTURE_SIZE = 256; // Bigger textures keep their own binding
+	const uint32_t ATLAS_PADDING = 8;			  // Wrapped texels around each texture, still one on the last level
+	const uint32_t ATLAS_ALIGNMENT = 16;		  // Regions stay on whole texels down to the last level
+
+	struct AtlasRegion
+	{
+		unsigned int page = 0;
+		uint32_t x = 0;		 // Corner of the padded rect in the page, level 0
+		uint32_t y = 0;
+		uint32_t width = 0;	 // Without the padding
+		uint32_t height = 0;
+		float scale[2] = { 1.f, 1.f }; // Texture coordinates to page coordinates
+		float offset[2] = { 0.f, 0.f };
+	};
+
+	struct AtlasPage
+	{
+		unsigned int texture = 0;
+		stbrp_context context;
+		std::vector<stbrp_node> nodes;
+	};
+
+	// Pages of RGBA8 shared by the small textures, so the models using them share one binding.
+	// Textures are packed as they are loaded, the shader applies the scale and offset of the region
+	// to the wrapped texture coordinates.
+	// A region is never freed, the skyline of stb_rect_pack can not take a rect back : a reloaded texture
+	// keeps its own binding, its first region stays unused until Clear.
+	class TextureAtlas
+	{
+		// Attribute
+	private:
+		std::vector<std::unique_ptr<AtlasPage>> pages; // The packing context points to the nodes of its page
+		unsigned int sampler;
+		unsigned int nbRegions; // Packed since the last Clear, the unused ones included
+
+		// Methode
+	public:
+		TextureAtlas();
+		~TextureAtlas();
+
+		bool Insert(const TextureData& p_texture, AtlasRegion& p_region); // Main thread
+		bool Pack(const uint32_t p_width, const uint32_t p_height, AtlasRegion& p_region);
+		void Bind(const AtlasRegion& p_region) const;
+		void Clear();
+
+		static bool Fits(const TextureData& p_texture);
+		// Padded RGBA8 pixels of a level of the region, filled from the texture level wrapped
+		static std::vector<unsigned char> BuildRegion(const TextureData& p_texture, const unsigned int p_level);
+		static uint32_t GetPaddedSize(const uint32_t p_size);
+
+		// Get and Set
+		unsigned int GetNbPages() const { return (unsigned int)pages.size(); };
+		unsigned int GetNbRegions() const { return nbRegions; };
+		unsigned int GetPageTexture(const unsigned int p_page) const { return pages[p_page]->texture; };
+
+	private:
+		void CreatePageTexture(AtlasPage& p_page);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "Image.hpp"
+#include "MappedFile.hpp"
+
+namespace Resources
+{
+	const uint32_t TEXTURE_CACHE_MAGIC = 0x5854474F; // "OGTX"
+	const uint32_t TEXTURE_CACHE_VERSION = 3;
+	const uint64_t TEXTURE_CACHE_ALIGNMENT = 64; // Of the pixels in the file
+	const char* const TEXTURE_CACHE_DIRECTORY = "Cache/Textures";
+
+	enum class TextureFormat : uint32_t
+	{
+		RGB8,
+		RGBA8,
+		BC1, // Opaque, 8 bytes per 4x4 block
+		BC3, // Alpha, 16 bytes per 4x4 block
+	};
+
+	struct TextureLevel
+	{
+		uint32_t width;
+		uint32_t height;
+		uint64_t offset; // In the pixels of every level
+		uint64_t size;
+	};
+
+	// Cache file layout : header, level table, then the pixels of every level, ready to be uploaded.
+	// The file is mapped, the pixels are never copied before the upload.
+	struct TextureCacheHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		TextureFormat format;
+		uint32_t nbLevels;
+		uint64_t key;		   // Source content and bake settings
+		uint64_t pixelsOffset; // From the start of the file
+		uint64_t pixelsSize;
+	};
+
+	// Pixels ready to be uploaded, every level in one buffer
+	struct TextureData
+	{
+		TextureFormat format = TextureFormat::RGBA8;
+		std::vector<TextureLevel> levels;
+		std::vector<unsigned char> pixels;
+
+		// Loaded from the cache : the pixels stay in the mapped file
+		std::shared_ptr<const Core::MappedFile> mapping;
+		const unsigned char* mappedPixels = nullptr;
+		size_t mappedSize = 0;
+
+		bool IsCompressed() const { return format == TextureFormat::BC1 || format == TextureFormat::BC3; };
+		const unsigned char* GetPixels() const { return mapping ? mappedPixels : pixels.data(); };
+		size_t GetPixelsSize() const { return mapping ? mappedSize : pixels.size(); };
+		const unsigned char* GetLevel(const unsigned int p_level) const { return GetPixels() + levels[p_level].offset; };
+	};
+
+	class TextureBaker
+	{
+		// Methode
+	public:
+		// Full mip chain, compressed in BC1, or BC3 if the image has alpha
+		static TextureData Bake(const Image& p_image, const bool p_compress);
+		// Gamma-correct mip chain in RGB8 (3 channels) or RGBA8, wrapped on the edges like the sampler
+		static TextureData BuildMipmaps(const unsigned char* p_pixels, const uint32_t p_width, const uint32_t p_height, const int p_nrChannels);
+		static TextureData Compress(const TextureData& p_texture);
+		static TextureData Decompress(const TextureData& p_texture); // BC1/BC3 to RGBA8
+
+		static uint64_t GetKey(const std::string& p_content, const bool p_compress);
+		static std::string GetCachePath(const uint64_t p_key);
+		static bool LoadCache(const std::string& p_path, const uint64_t p_key, TextureData& p_texture);
+		static bool SaveCache(const std::string& p_path, const uint64_t p_key, const TextureData& p_texture);
+
+		static bool HasAlpha(const TextureData& p_texture);
+		static size_t GetLevelSize(const TextureFormat p_format, const uint32_t p_width, const uint32_t p_height);
+
+	private:
+		static std::vector<unsigned char> ToRGBA(const unsigned char* p_pixels, const size_t p_nbPixels, const int p_nrChannels);
+		static void CompressLevel(const unsigned char* p_rgba, const uint32_t p_width, const uint32_t p_height, const bool p_alpha, unsigned char* p_blocks);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace Resources
+{
+	class Texture;
+
+	const size_t TEXTURE_STREAMING_BUDGET = 128 * 1024 * 1024;	  // GPU bytes of the streamed levels
+	const size_t TEXTURE_STREAMING_UPLOAD = 4 * 1024 * 1024;	  // Per frame, at least one level is uploaded
+	const uint32_t TEXTURE_STREAMING_TAIL_SIZE = 64;			  // Levels up to this size are uploaded with the texture
+
+	struct StreamingEntry
+	{
+		unsigned int residentLevel; // Finest level on the GPU
+		unsigned int tailLevel;		// Coarsest level streamed, never evicted below
+		unsigned int wantedLevel;	// From the size on screen
+		float screenSize;			// Pixels, priority of the texture
+		std::vector<size_t> levelSizes;
+		unsigned int targetLevel;	// Result of the plan
+	};
+
+	// Streams the levels finer than the tail of the textures by priority on screen, on the OpenGL thread.
+	// The resident levels stay within the budget : the levels not needed any more, then the levels of
+	// the textures with the smallest size on screen are evicted first.
+	class TextureStreamer
+	{
+		// Attribute
+	private:
+		std::vector<Texture*> textures;
+		size_t budget;
+		size_t residentSize;
+
+		// Methode
+	public:
+		TextureStreamer();
+
+		void Add(Texture* p_texture);
+		void Remove(Texture* p_texture);
+		void Clear();
+		void Update(const float p_screenHeight); // After the draw of the frame, once the sizes are requested
+
+		static unsigned int GetWantedLevel(const uint32_t p_width, const uint32_t p_height, const float p_screenSize, const unsigned int p_tailLevel);
+		static void Plan(std::vector<StreamingEntry>& p_entries, const size_t p_budget, const size_t p_upload);
+
+		// Get and Set
+		void SetBudget(const size_t p_budget) { budget = p_budget; };
+		size_t GetBudget() const { return budget; };
+		size_t GetResidentSize() const { return residentSize; };
+		unsigned int GetNbTextures() const { return (unsigned int)textures.size(); };
+	};
+}
\ No newline at end of file
@@ -3,10 +3,17 @@
 #include <thread>
 #include <queue>
 #include "IResource.hpp"
+#include "SpinLock.hpp"
 #include <atomic>
 
 namespace Core
 {
+	struct ResourceReload
+	{
+		Resources::IResource* resource; // In use by the scene
+		Resources::IResource* reloaded; // Initialized aside, swapped with resource once loaded
+	};
+
 	class ThreadsManager
 	{
 		// Attribute
@@ -15,6 +22,13 @@ namespace Core
 		std::queue<Resources::IResource*> resourcesToLoad;
 		const unsigned int nbThreadResources;
 
+		// Hot reload
+		SpinLock reloadLock;
+		std::queue<ResourceReload> resourcesToReload;
+		std::queue<ResourceReload> resourcesToSwap;
+		std::thread reloadThread;
+		std::atomic<bool> reloadRunning;
+
 	public:
 		std::vector<std::thread> threadpool;
 		std::atomic<unsigned int> resourcesToInitEnabled;
@@ -27,12 +41,16 @@ namespace Core
 		~ThreadsManager();
 		void Init();
 		void Wait(std::atomic<unsigned int>& p_token);
-		void AddResourceToInit(Resources::IResource* p_resource) { resourcesToInit.push(p_resource); };
+		void AddResourceToInit(Resources::IResource* p_resource);
+		void AddResourceToReload(Resources::IResource* p_resource);
 		void Update();
 		void DeleteThreads();
 
 	private:
 		void InitResources();
+		void ReloadResources();
+		void StartReloadThread();
+		void SwapReloadedResources();
 	};
 
 }
\ No newline at end of file
@@ -9,6 +9,7 @@ namespace Physics
 		// Attribute
 	public:
 		Core::Maths::Mat4 matrix;
+		Core::Maths::Mat4 normalMatrix; // Inverse transpose of matrix, updated with it
 
 		// Local Matrix
 		Core::Maths::Vec3 translation;
@@ -20,6 +21,7 @@ namespace Physics
 		Transform(const Core::Maths::Vec3& p_translate = Core::Maths::Vec3(0.f, 0.f, 0.f), const Core::Maths::Vec3& p_scale = Core::Maths::Vec3(1.f, 1.f, 1.f), const Core::Maths::Vec3 & p_rotation = Core::Maths::Vec3(0.f, 0.f, 0.f));
 
 		// Get and Set
-		const Core::Maths::Mat4& GetLocalTransform();
+		Core::Maths::Mat4 GetLocalTransform() const;
+		void SetMatrix(const Core::Maths::Mat4& p_matrix);
 	};
 }
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "MyMaths.hpp"
+
+namespace LowRenderer
+{
+	// CPU image of a "layout(std140)" uniform block. The values are added in the order of the
+	// declaration of the block, each at the offset given by the std140 rules :
+	// scalars are aligned on 4 bytes, vec3 and vec4 on 16, structs start and end on 16
+	// (a vec3 followed by a float shares its 16 bytes).
+	class UniformBlock
+	{
+		// Attribute
+	private:
+		std::vector<unsigned char> data;
+
+		// Methode
+	public:
+		void Clear() { data.clear(); };
+
+		size_t AddInt(const int32_t p_value);
+		size_t AddFloat(const float p_value);
+		size_t AddVec3(const Core::Maths::Vec3& p_value);
+		size_t AddVec4(const Core::Maths::Vec4& p_value);
+
+		size_t BeginStruct(); // Also the start of each element of an array of structs
+		void EndStruct();
+
+		// Get and Set
+		const unsigned char* GetData() const { return data.data(); };
+		size_t GetSize() const { return data.size(); };
+
+	private:
+		size_t Add(const void* p_value, const size_t p_size, const size_t p_alignment); // Returns the offset of the value
+		void Align(const size_t p_alignment);
+	};
+
+	// Buffer bound to a binding point of every program, uploaded only when its content changed
+	class UniformBuffer
+	{
+		// Attribute
+	private:
+		unsigned int buffer;
+		unsigned int binding;
+		std::vector<unsigned char> uploaded;
+
+		// Methode
+	public:
+		UniformBuffer(const unsigned int p_binding);
+		~UniformBuffer();
+		UniformBuffer(const UniformBuffer&) = delete;
+		UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+		bool Upload(const UniformBlock& p_block); // True if the buffer was written
+
+		// Get and Set
+		unsigned int GetBuffer() const { return buffer; };
+	};
+
+	// Buffer read by the shaders through a samplerBuffer on its texture unit, uploaded only when its content changed
+	class TextureBuffer
+	{
+		// Attribute
+	private:
+		unsigned int buffer;
+		unsigned int texture;
+		unsigned int unit;
+		unsigned int format; // Internal format of the texels
+		std::vector<unsigned char> uploaded;
+
+		// Methode
+	public:
+		TextureBuffer(const unsigned int p_unit, const unsigned int p_format);
+		~TextureBuffer();
+		TextureBuffer(const TextureBuffer&) = delete;
+		TextureBuffer& operator=(const TextureBuffer&) = delete;
+
+		bool Upload(const void* p_data, const size_t p_size); // True if the buffer was written
+	};
+}
\ No newline at end of file
@@ -1,57 +1,17 @@
 #version 330 core
 
-#define MAX_DIRECTION_LIGHT 5
-#define MAX_POINT_LIGHT 5
-#define MAX_SPOT_LIGHT 5
-
 out vec4 FragColor;
 
 // Texture
 in vec2 TexCoord;
 uniform sampler2D texture1;
+uniform vec4 uvTransform; // xy : scale, zw : offset of the texture in its atlas page
 
-// Light
-struct LightData
-{
-    vec3 lightPos;
-    vec3 viewPos;
-    vec4 ambientColor;
-    vec4 diffuseColor;
-    vec4 specularColor;
-};
-
-struct DirectionLightData
-{
-    LightData lightData;
-    vec3 direction;
-};
-
-struct PointLightData
-{
-    LightData lightData;
-    float constant;
-    float linear;
-    float quadratic;
-};
-
-struct SpotLightData
-{
-    LightData lightData;
-    vec3 direction;
-    float cutOff;
-    float outerCutOff;
-};
-
-uniform float nbDirectionLight;
-uniform float nbPointLight;
-uniform float nbSpotLight;
-
-uniform DirectionLightData directionLights[MAX_DIRECTION_LIGHT];
-uniform PointLightData pointLights[MAX_POINT_LIGHT];
-uniform SpotLightData spotLights[MAX_SPOT_LIGHT];
+#include "Lights.glsl"
 
 in vec3 Normal;
 in vec3 FragPos;
+in vec4 ClipPosition; // View depth in w
 
 vec4 DirectionLight(DirectionLightData p_data)
 {
@@ -61,7 +21,7 @@ vec4 DirectionLight(DirectionLightData p_data)
     float diff = max(dot(norm, lightDir), 0.0);
 
     // Specular
-    vec3 viewDir = normalize(p_data.lightData.viewPos - FragPos);
+    vec3 viewDir = normalize(viewPos - FragPos);
     vec3 reflectDir = reflect(lightDir, norm);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
 
@@ -79,13 +39,14 @@ vec4 PointLight(PointLightData p_data)
     float diff = max(dot(norm, lightDir), 0.0);
 
     // Specular
-    vec3 viewDir = normalize(p_data.lightData.viewPos - FragPos);
+    vec3 viewDir = normalize(viewPos - FragPos);
     vec3 reflectDir = reflect(-lightDir, norm);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
 
     return p_data.lightData.ambientColor * attenuation + (diff * p_data.lightData.diffuseColor * attenuation) + (spec * p_data.lightData.specularColor * attenuation); 
 }
 
+// Without its ambient, added once for every spot light in spotAmbient
 vec4 SpotLight(SpotLightData p_data)
 {
 
@@ -101,34 +62,35 @@ vec4 SpotLight(SpotLightData p_data)
         float diff = max(dot(norm, lightDir), 0.0);
 
         // Specular
-        vec3 viewDir = normalize(p_data.lightData.viewPos - FragPos);
+        vec3 viewDir = normalize(viewPos - FragPos);
         vec3 reflectDir = reflect(-lightDir, norm);
         float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
 
-        return p_data.lightData.ambientColor + (diff * p_data.lightData.diffuseColor * intensity) + (spec * p_data.lightData.specularColor * intensity); 
+        return (diff * p_data.lightData.diffuseColor * intensity) + (spec * p_data.lightData.specularColor * intensity); 
     }
     else
     {
-        return p_data.lightData.ambientColor;
+        return vec4(0.0);
     }
 }
 
 vec4 LightCalc()
 {
-    vec4 result;
-    for(int i = 0; i < nbDirectionLight; i++)
+    vec4 result = spotAmbient;
+    for(int i = 0; i < DIRECTION_LIGHT_COUNT; i++)
     {
         result += DirectionLight(directionLights[i]);
     }
 
-    for(int i = 0; i < nbPointLight; i++)
-    {
-        result += PointLight(pointLights[i]);
-    }
-
-    for(int i = 0; i < nbSpotLight; i++)
+    // Only the point and spot lights whose volume touches the cluster of the fragment
+    uvec2 cluster = GetCluster(ClipPosition);
+    for(uint i = 0u; i < cluster.y; i++)
     {
-        result += SpotLight(spotLights[i]);
+        int light = int(texelFetch(clusterLightIndices, int(cluster.x + i)).x);
+        if(light < nbPointLight)
+            result += PointLight(GetPointLight(light));
+        else
+            result += SpotLight(GetSpotLight(light - nbPointLight));
     }
 
     return result;
@@ -136,7 +98,10 @@ vec4 LightCalc()
 
 void main()
 {
-    vec4 text = texture(texture1, TexCoord);
+    // Wrapped by hand, an atlas page holds several textures. The gradients of the unwrapped
+    // coordinates keep the mip level continuous across the seams.
+    vec2 uv = uvTransform.zw + fract(TexCoord) * uvTransform.xy;
+    vec4 text = textureGrad(texture1, uv, dFdx(TexCoord) * uvTransform.xy, dFdy(TexCoord) * uvTransform.xy);
     vec4 light = LightCalc();
     
     FragColor = text * light;
@@ -0,0 +1,100 @@
+// Lights of the LightManager, packed by LightManager::Pack with the std140 rules (offsets in bytes).
+// MAX_DIRECTION_LIGHT and CLUSTER_* are defined by the engine in every variant.
+struct LightData
+{
+    vec3 lightPos;      // 0
+    vec4 ambientColor;  // 16
+    vec4 diffuseColor;  // 32
+    vec4 specularColor; // 48
+};                      // 64
+
+struct DirectionLightData
+{
+    LightData lightData; // 0
+    vec3 direction;      // 64
+};                       // 80
+
+struct PointLightData
+{
+    LightData lightData; // 0
+    float constant;      // 64
+    float linear;        // 68
+    float quadratic;     // 72
+};                       // 80
+
+struct SpotLightData
+{
+    LightData lightData; // 0
+    vec3 direction;      // 64
+    float cutOff;        // 76
+    float outerCutOff;   // 80
+};                       // 96
+
+layout(std140) uniform Lights
+{
+    vec3 viewPos;          // 0
+    int nbDirectionLight;  // 12
+    int nbPointLight;      // 16
+    int nbSpotLight;       // 20
+    vec4 spotAmbient;      // 32 : ambient of every spot light, not limited to their cone
+    vec4 clusterSlices;    // 48 : slice of a view depth = log(depth) * x + y
+    DirectionLightData directionLights[MAX_DIRECTION_LIGHT]; // 64
+};                                                           // 464
+
+// Point and spot lights, LightManager::PackLights : 5 texels per light, the point lights first
+uniform samplerBuffer clusterLights;
+
+// LightClusters : offset and number of the lights of each cluster in clusterLightIndices
+uniform usamplerBuffer clusterGrid;
+uniform usamplerBuffer clusterLightIndices;
+
+PointLightData GetPointLight(int p_index)
+{
+    int texel = p_index * 5;
+    vec4 position = texelFetch(clusterLights, texel);
+    vec4 attenuation = texelFetch(clusterLights, texel + 4);
+
+    PointLightData light;
+    light.lightData.lightPos = position.xyz;
+    light.lightData.ambientColor = texelFetch(clusterLights, texel + 1);
+    light.lightData.diffuseColor = texelFetch(clusterLights, texel + 2);
+    light.lightData.specularColor = texelFetch(clusterLights, texel + 3);
+    light.constant = position.w;
+    light.linear = attenuation.x;
+    light.quadratic = attenuation.y;
+    return light;
+}
+
+SpotLightData GetSpotLight(int p_index)
+{
+    int texel = (nbPointLight + p_index) * 5;
+    vec4 position = texelFetch(clusterLights, texel);
+    vec4 direction = texelFetch(clusterLights, texel + 4);
+
+    SpotLightData light;
+    light.lightData.lightPos = position.xyz;
+    light.lightData.ambientColor = texelFetch(clusterLights, texel + 1);
+    light.lightData.diffuseColor = texelFetch(clusterLights, texel + 2);
+    light.lightData.specularColor = texelFetch(clusterLights, texel + 3);
+    light.direction = direction.xyz;
+    light.cutOff = position.w;
+    light.outerCutOff = direction.w;
+    return light;
+}
+
+// Offset and number of the lights of the cluster holding this clip position
+uvec2 GetCluster(vec4 p_clipPosition)
+{
+    vec2 screen = p_clipPosition.xy / p_clipPosition.w * 0.5 + 0.5;
+    ivec2 tile = clamp(ivec2(screen * vec2(CLUSTER_X, CLUSTER_Y)), ivec2(0), ivec2(CLUSTER_X - 1, CLUSTER_Y - 1));
+    int slice = clamp(int(floor(log(p_clipPosition.w) * clusterSlices.x + clusterSlices.y)), 0, CLUSTER_Z - 1);
+    return texelFetch(clusterGrid, (slice * CLUSTER_Y + tile.y) * CLUSTER_X + tile.x).xy;
+}
+
+// NB_DIRECTION_LIGHT is the number of direction lights of the scene, defined in its variant : the loop has
+// constant bounds and is unrolled. Without it the number of the block is read at run time.
+#ifdef NB_DIRECTION_LIGHT
+#define DIRECTION_LIGHT_COUNT NB_DIRECTION_LIGHT
+#else
+#define DIRECTION_LIGHT_COUNT nbDirectionLight
+#endif
\ No newline at end of file
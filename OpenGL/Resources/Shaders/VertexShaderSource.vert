@@ -7,14 +7,31 @@ layout(location = 2) in vec2 aTexCoord;
 out vec3 Normal;
 out vec2 TexCoord;
 out vec3 FragPos;
+out vec4 ClipPosition; // Cluster of the fragment
 
+#ifdef INSTANCED
+// One per instance, gathered by the render queue
+layout(location = 3) in mat4 instanceModel;
+layout(location = 7) in mat3 instanceNormalMatrix;
+
+uniform mat4 viewProjection;
+#else
 uniform mat4 mvp;
 uniform mat4 model;
+uniform mat3 normalMatrix; // Inverse transpose of model, computed once per transform change on the CPU
+#endif
 
 void main()
 {
+#ifdef INSTANCED
+    mat4 model = instanceModel;
+    mat3 normalMatrix = instanceNormalMatrix;
+    mat4 mvp = viewProjection * instanceModel;
+#endif
+
     gl_Position = mvp * vec4(aPos, 1.0);
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    ClipPosition = gl_Position;
+    Normal = normalMatrix * aNormal;
     TexCoord = aTexCoord;
     FragPos = vec3(model * vec4(aPos, 1.0));
 }
\ No newline at end of file
@@ -1,10 +1,12 @@
 #include "App.hpp"
 
 #include <iostream>
+#include <filesystem>
+#include <chrono>
 
-#include "Imgui/imgui.h"
-#include "Imgui/imgui_impl_glfw.h"
-#include "Imgui/imgui_impl_opengl3.h"
+#include "ImGUI/imgui.h"
+#include "ImGUI/imgui_impl_glfw.h"
+#include "ImGUI/imgui_impl_opengl3.h"
 
 #include "Log.hpp"
 
@@ -17,6 +19,7 @@ namespace Core
 	bool ThreadsManager::multithread = true;
 	GLFWwindow* App::window = nullptr;
 	bool App::stopGame = false;
+	bool App::headless = false;
 
 	App::App()
 		: width(0)
@@ -25,11 +28,21 @@ namespace Core
 		, threadsManager(5)
 		, currentScene(nullptr)
 		, timer(width, height)
+		, headlessFrames(0)
+		, indirectDraws(false)
 	{
 	}
 
 	App::~App()
 	{
+		JobSystem::Stop();
+
+		if (headless)
+		{
+			ImGui::DestroyContext();
+			return;
+		}
+
 		ImGui_ImplOpenGL3_Shutdown();
 		ImGui_ImplGlfw_Shutdown();
 		ImGui::DestroyContext();
@@ -42,7 +55,45 @@ namespace Core
 	{
 		width = p_appInit.width;
 		height = p_appInit.height;
+		headless = p_appInit.headless;
+		headlessFrames = p_appInit.headlessFrames;
+		indirectDraws = p_appInit.indirectDraws;
+
+		if (headless)
+			InitHeadless();
+		else if (!InitWindow(p_appInit))
+			return false;
+
+		if (ThreadsManager::multithread)
+			JobSystem::Start(JobSystem::GetDefaultNbWorkers());
+
+		// Without pack, the resources are read file by file from Resources/
+		if (p_appInit.assetPack && std::filesystem::exists(p_appInit.assetPack))
+			resources.MountPack(p_appInit.assetPack);
+
+		// Small textures share the pages of the atlas of the resource manager
+		Resources::Texture::atlas = &resources.GetAtlas();
+		Resources::Texture::streamer = &resources.GetStreamer();
+		resources.GetStreamer().SetBudget(p_appInit.textureBudget);
+
+		CreateScenes();
+		
+		currentScene = resources.GetResource<Resources::Scene>("Menu");
+
+		inputsManager.SetWindow(window);
+
+		if (p_appInit.hotReload && !headless)
+			fileWatcher.Init("Resources");
+
+		// Nobody clicks on Start
+		if (headless)
+			nextScene = { "Scene1", Resources::SceneType::ST_Game };
+
+		return true;
+	}
 
+	bool App::InitWindow(const AppInit& p_appInit)
+	{
 		// glfw: initialize and configure
 		glfwInit();
 		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, p_appInit.major);
@@ -91,13 +142,29 @@ namespace Core
 		ImGui_ImplGlfw_InitForOpenGL(window, true);
 		ImGui_ImplOpenGL3_Init("#version 130");
 
-		CreateScenes();
-		
-		currentScene = resources.GetResource<Resources::Scene>("Menu");
+		return true;
+	}
 
-		inputsManager.SetWindow(window);
+	void App::InitHeadless()
+	{
+		// Neither GLFW nor glad : every GL function is a stub of the recorder
+		recorder = std::make_unique<Debug::GLRecorder>();
 
-		return true;
+		glEnable(GL_DEPTH_TEST);
+		glEnable(GL_CULL_FACE);
+
+		// ImGui without backend : the frames are built, never rendered
+		IMGUI_CHECKVERSION();
+		ImGui::CreateContext();
+		ImGui::StyleColorsDark();
+
+		ImGuiIO& io = ImGui::GetIO();
+		io.DisplaySize = ImVec2((float)width, (float)height);
+		unsigned char* pixels = nullptr;
+		int fontWidth = 0, fontHeight = 0;
+		io.Fonts->GetTexDataAsRGBA32(&pixels, &fontWidth, &fontHeight);
+
+		Debug::Log::Print("Headless : OpenGL calls are recorded, no window\n", Debug::LogLevel::Notification);
 	}
 
 	void App::InitRenderer()
@@ -108,11 +175,20 @@ namespace Core
 	void App::Update()
 	{
 		Core::Inputs inputs;
+		if (headless)
+			inputs = Core::Inputs{ 0.f, 0.f, false, false, false, false, false, false, false };
+
+		unsigned int frames = 0;
+		std::chrono::steady_clock::time_point measureStart;
+
 		while (!stopGame)
 		{
 			// input
-			glfwPollEvents();
-			inputs = inputsManager.Update();
+			if (!headless)
+			{
+				glfwPollEvents();
+				inputs = inputsManager.Update();
+			}
 
 			// render
 			glClearColor(0.06f, 0.01f, 0.34f, 1.0f);
@@ -120,6 +196,7 @@ namespace Core
 			glClear(GL_DEPTH_BUFFER_BIT);
 			glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
+			ReloadModifiedResources();
 			threadsManager.Update();
 
 			ChangeScene();
@@ -128,15 +205,69 @@ namespace Core
 			currentScene->Update(inputs,timer.GetDeltaTime());
 			currentScene->Draw(inputs, timer.elapsedMono, timer.elapsedMulti);
 
+			// The models drawn this frame requested the levels of their textures
+			resources.GetStreamer().Update((float)height);
+
+			if (resources.CheckAllResourcesLoaded() && !timer.timerDone && timer.begin)
+			{
+				resources.PrintSharingReport();
+				resources.DumpMemoryReport(Resources::MEMORY_REPORT_PATH);
+			}
+
 			if (resources.CheckAllResourcesLoaded() && !timer.timerDone && timer.begin && threadsManager.multithread)
 				timer.ChronoEnd(timer.elapsedMulti);
 			else if (resources.CheckAllResourcesLoaded() && !timer.timerDone && timer.begin && !threadsManager.multithread)
 				timer.ChronoEnd(timer.elapsedMono);
 
-			glfwSwapBuffers(window);
+			if (!headless)
+			{
+				glfwSwapBuffers(window);
+				continue;
+			}
+
+			// The frames are measured once the loading is over
+			if (!resources.CheckAllResourcesLoaded())
+				continue;
+
+			if (frames == 0)
+			{
+				Debug::GLRecorder::Reset();
+				measureStart = std::chrono::steady_clock::now();
+			}
+
+			if (++frames < headlessFrames)
+				continue;
+
+			const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - measureStart;
+			PrintHeadlessReport(seconds.count(), frames, Debug::GLRecorder::GetCalls());
+			stopGame = true;
 		}
 	}
 
+	void App::PrintHeadlessReport(const double p_seconds, const unsigned int p_frames, const Debug::GLCalls& p_calls) const
+	{
+		const auto perFrame = [p_frames](const size_t p_count)
+		{
+			return std::to_string((double)p_count / p_frames);
+		};
+
+		const Debug::GLMemory memory = Debug::GLRecorder::GetMemory();
+
+		std::string report = "Headless : " + std::to_string(p_frames) + " frames in " + std::to_string(p_seconds) + " s, "
+			+ std::to_string(p_seconds * 1000.0 / p_frames) + " ms per frame\n";
+		report += "  Per frame : " + perFrame(p_calls.draw) + " draws, " + perFrame(p_calls.indices) + " indices, "
+			+ perFrame(p_calls.useProgram) + " programs, " + perFrame(p_calls.bindVertexArray) + " vertex arrays, "
+			+ perFrame(p_calls.bindTexture) + " textures, " + perFrame(p_calls.uniform) + " uniforms, "
+			+ perFrame(p_calls.getUniformLocation) + " uniform lookups\n";
+		report += "  Per frame : " + perFrame(p_calls.bufferUpload) + " buffer uploads, " + perFrame(p_calls.textureUpload)
+			+ " texture uploads, " + perFrame(p_calls.stateChange) + " state changes\n";
+		report += "  Memory : " + std::to_string(memory.nbBuffers) + " buffers " + std::to_string(memory.bufferBytes / 1024) + " KB, "
+			+ std::to_string(memory.nbTextures) + " textures " + std::to_string(memory.textureBytes / 1024) + " KB, "
+			+ std::to_string(memory.nbPrograms) + " programs\n";
+
+		Debug::Log::Print(report, Debug::LogLevel::Notification);
+	}
+
 	void App::ChangeScene()
 	{
 
@@ -185,6 +316,20 @@ namespace Core
 
 	}
 
+	void App::ReloadModifiedResources()
+	{
+		if (!fileWatcher.IsWatching())
+			return;
+
+		for (const std::string& path : fileWatcher.Poll())
+		{
+			Resources::FileCache::Invalidate(path);
+
+			for (Resources::IResource* resource : resources.GetResourcesFromPath(path))
+				threadsManager.AddResourceToReload(resource);
+		}
+	}
+
 	void App::CreateResource()
 	{
 		Core::Debug::Log::Print("---------\n", Core::Debug::LogLevel::None);
@@ -201,7 +346,7 @@ namespace Core
 		threadsManager.AddResourceToInit(resources.Create<Resources::Mesh>(name, path));
 
 		name = "PatrickText";
-		path = "Resources/Textures/patrick.png";
+		path = "Resources/Textures/Patrick.png";
 		threadsManager.AddResourceToInit(resources.Create<Resources::Texture>(name, path));
 
 		name = "ColliderShader";
@@ -281,7 +426,10 @@ namespace Core
 
 		// Scene1
 		name = "Scene1";
-		resources.Create<Resources::Scene>(name, "")->Init(width, height);
+		Resources::Scene* scene1 = resources.Create<Resources::Scene>(name, "");
+		scene1->Init(width, height);
+		scene1->SetResourceManager(&resources);
+		scene1->SetIndirectDraws(indirectDraws);
 
 		InitRenderer();
 		name = "BoxCollider";
@@ -335,6 +483,7 @@ namespace Core
 		currentScene->CreateCollider(resources.GetResource<Resources::Mesh>("SphereCollider"), resources.GetResource<Resources::Shader>("ColliderShader"), Physics::ColliderTypes::Sphere, true);
 		currentScene->AddGameObject(sphere1);
 		sphere1->SetCollider(currentScene->GetLastCollider());
+		sphere1->SetStatic(true);
 		sphere1->GetRigidbody().useGravity = false;
 		Physics::Collider* playerCollider = sphere1->GetCollider();
 		Physics::SphereCollider* sphereCollider = dynamic_cast<Physics::SphereCollider*>(playerCollider);
@@ -378,7 +527,9 @@ namespace Core
 		currentScene->AddGameObject(box1);
 		currentScene->CreateCollider(resources.GetResource<Resources::Mesh>("BoxCollider"), resources.GetResource<Resources::Shader>("ColliderShader"),Physics::ColliderTypes::Box, true);
 		box1->SetCollider(currentScene->GetLastCollider());
+		box1->SetStatic(true);
 		box1->GetRigidbody().useGravity = false;
+		box1->SetOccluder(true);
 
 		LowRenderer::GameObject* box3 = new LowRenderer::GameObject(basicBox, Physics::Transform(
 			Core::Maths::Vec3(0.f, -3.0f, 0.f),
@@ -389,6 +540,7 @@ namespace Core
 		currentScene->CreateCollider(resources.GetResource<Resources::Mesh>("BoxCollider"), resources.GetResource<Resources::Shader>("ColliderShader"),Physics::ColliderTypes::Box, true);
 		currentScene->AddGameObject(box3);
 		box3->SetCollider(currentScene->GetLastCollider());
+		box3->SetStatic(true);
 		// ========= ==================== =========
 
 		LowRenderer::GameObject* box5 = new LowRenderer::GameObject(basicBox, Physics::Transform(
@@ -399,6 +551,7 @@ namespace Core
 		currentScene->CreateCollider(resources.GetResource<Resources::Mesh>("BoxCollider"), resources.GetResource<Resources::Shader>("ColliderShader"), Physics::ColliderTypes::Box,true);
 		currentScene->AddGameObject(box5);
 		box5->SetCollider(currentScene->GetLastCollider());
+		box5->SetStatic(true);
 		box5->GetRigidbody().useGravity = false;
 
 		LowRenderer::GameObject* box6 = new LowRenderer::GameObject(basicBox, Physics::Transform(
@@ -409,7 +562,9 @@ namespace Core
 		currentScene->CreateCollider(resources.GetResource<Resources::Mesh>("BoxCollider"), resources.GetResource<Resources::Shader>("ColliderShader"), Physics::ColliderTypes::Box, true);
 		currentScene->AddGameObject(box6);
 		box6->SetCollider(currentScene->GetLastCollider());
+		box6->SetStatic(true);
 		box6->GetRigidbody().useGravity = false;
+		box6->SetOccluder(true);
 
 		LowRenderer::GameObject* box7 = new LowRenderer::GameObject(basicBox, Physics::Transform(
 			Core::Maths::Vec3(-15.f, 2.f, 6.f),
@@ -419,7 +574,9 @@ namespace Core
 		currentScene->CreateCollider(resources.GetResource<Resources::Mesh>("BoxCollider"), resources.GetResource<Resources::Shader>("ColliderShader"), Physics::ColliderTypes::Box, true);
 		currentScene->AddGameObject(box7);
 		box7->SetCollider(currentScene->GetLastCollider());
+		box7->SetStatic(true);
 		box7->GetRigidbody().useGravity = false;
+		box7->SetOccluder(true);
 
 		LowRenderer::GameObject* box8 = new LowRenderer::GameObject(basicBox, Physics::Transform(
 			Core::Maths::Vec3(-25.f, 2.f, 0.f),
@@ -430,6 +587,7 @@ namespace Core
 		currentScene->CreateCollider(resources.GetResource<Resources::Mesh>("BoxCollider"), resources.GetResource<Resources::Shader>("ColliderShader"), Physics::ColliderTypes::Box, true);
 		currentScene->AddGameObject(box8);
 		box8->SetCollider(currentScene->GetLastCollider());
+		box8->SetStatic(true);
 		box8->GetRigidbody().useGravity = false;
 
 
@@ -442,6 +600,7 @@ namespace Core
 		currentScene->CreateCollider(resources.GetResource<Resources::Mesh>("BoxCollider"), resources.GetResource<Resources::Shader>("ColliderShader"), Physics::ColliderTypes::Box, true);
 		currentScene->AddGameObject(box9);
 		box9->SetCollider(currentScene->GetLastCollider());
+		box9->SetStatic(true);
 		box9->GetRigidbody().useGravity = false;
 
 		LowRenderer::GameObject* box10 = new LowRenderer::GameObject(basicBox, Physics::Transform(
@@ -453,6 +612,7 @@ namespace Core
 		currentScene->CreateCollider(resources.GetResource<Resources::Mesh>("BoxCollider"), resources.GetResource<Resources::Shader>("ColliderShader"), Physics::ColliderTypes::Box, true);
 		currentScene->AddGameObject(box10);
 		box10->SetCollider(currentScene->GetLastCollider());
+		box10->SetStatic(true);
 		box10->GetRigidbody().useGravity = false;
 		
 		// Pistol	
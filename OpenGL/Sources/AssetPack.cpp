@@ -0,0 +1,276 @@
+#include "AssetPack.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+
+#include <STB_Image/stb_image.h>
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "../stb-master/stb_image_write.h"
+
+#include "FileCache.hpp"
+#include "Log.hpp"
+
+namespace Resources
+{
+	AssetPack::AssetPack()
+		: file()
+		, header(nullptr)
+		, entries(nullptr)
+		, paths(nullptr)
+	{
+	}
+
+	bool AssetPack::Build(const std::string& p_output, const std::vector<std::string>& p_files, const PackBuildSettings& p_settings)
+	{
+		const uint32_t alignment = p_settings.alignment ? p_settings.alignment : 1;
+		std::vector<PackEntry> toc(p_files.size());
+		std::string pathsData;
+
+		for (size_t i = 0; i < p_files.size(); i++)
+		{
+			const std::string path = NormalizePath(p_files[i]);
+			toc[i] = PackEntry();
+			toc[i].pathHash = FileCache::Hash(path.data(), path.size());
+			toc[i].pathOffset = (uint32_t)pathsData.size();
+			toc[i].pathSize = (uint32_t)path.size();
+			toc[i].sourceTime = GetSourceTime(p_files[i]);
+			pathsData += path;
+		}
+
+		PackHeader packHeader = PackHeader();
+		packHeader.magic = PACK_MAGIC;
+		packHeader.version = PACK_VERSION;
+		packHeader.nbEntries = (uint32_t)p_files.size();
+		packHeader.alignment = alignment;
+		packHeader.pathsOffset = sizeof(PackHeader) + toc.size() * sizeof(PackEntry);
+		packHeader.pathsSize = pathsData.size();
+
+		// Written aside then renamed, a failed build keeps the previous pack
+		const std::string temporaryPath = p_output + ".tmp";
+		std::error_code error;
+		std::ofstream pack(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!pack)
+		{
+			Core::Debug::Log::Print("Fail to create pack " + p_output + "\n", Core::Debug::LogLevel::Warning);
+			return false;
+		}
+
+		// The table of contents is written once the entries are known
+		pack.write((const char*)&packHeader, sizeof(PackHeader));
+		pack.write((const char*)toc.data(), toc.size() * sizeof(PackEntry));
+		pack.write(pathsData.data(), pathsData.size());
+
+		uint64_t offset = packHeader.pathsOffset + packHeader.pathsSize;
+		const std::vector<char> zeros(alignment, 0);
+		size_t rawTotal = 0;
+
+		// Entries keep the build order, files used together are read together
+		for (size_t i = 0; i < p_files.size(); i++)
+		{
+			std::ifstream input(p_files[i], std::ios::in | std::ios::binary);
+			if (!input)
+			{
+				Core::Debug::Log::Print("Fail to open " + p_files[i] + ", pack " + p_output + " not built\n", Core::Debug::LogLevel::Warning);
+				pack.close();
+				std::filesystem::remove(temporaryPath, error);
+				return false;
+			}
+			const std::string raw((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+			const uint64_t padding = (alignment - offset % alignment) % alignment;
+			pack.write(zeros.data(), padding);
+			offset += padding;
+
+			PackEntry& entry = toc[i];
+			entry.offset = offset;
+			entry.rawSize = raw.size();
+			entry.compression = PackCompression::NONE;
+			entry.size = raw.size();
+
+			unsigned char* compressed = nullptr;
+			int compressedSize = 0;
+			if (p_settings.compress && !raw.empty())
+				compressed = stbi_zlib_compress((unsigned char*)raw.data(), (int)raw.size(), &compressedSize, 8);
+
+			// Already compressed formats (png, jpg) are stored as they are
+			if (compressed && compressedSize < raw.size() * p_settings.minCompressionRatio)
+			{
+				entry.compression = PackCompression::ZLIB;
+				entry.size = compressedSize;
+				pack.write((const char*)compressed, compressedSize);
+			}
+			else
+				pack.write(raw.data(), raw.size());
+
+			STBIW_FREE(compressed);
+			offset += entry.size;
+			rawTotal += raw.size();
+		}
+
+		std::sort(toc.begin(), toc.end(), [](const PackEntry& p_a, const PackEntry& p_b) { return p_a.pathHash < p_b.pathHash; });
+		pack.seekp(sizeof(PackHeader));
+		pack.write((const char*)toc.data(), toc.size() * sizeof(PackEntry));
+		pack.close();
+
+		if (pack.fail())
+		{
+			Core::Debug::Log::Print("Fail to write pack " + p_output + "\n", Core::Debug::LogLevel::Warning);
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+
+		std::filesystem::rename(temporaryPath, p_output, error);
+		if (error)
+		{
+			Core::Debug::Log::Print("Fail to replace pack " + p_output + " : " + error.message() + "\n", Core::Debug::LogLevel::Warning);
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+
+		Core::Debug::Log::Print("Build pack " + p_output + " : " + std::to_string(p_files.size()) + " files, "
+			+ std::to_string(rawTotal / 1024) + " KB -> " + std::to_string(offset / 1024) + " KB\n", Core::Debug::LogLevel::Notification);
+		return true;
+	}
+
+	std::vector<std::string> AssetPack::ListFiles(const std::string& p_root)
+	{
+		std::vector<std::string> files;
+
+		std::error_code error;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(p_root, error))
+		{
+			if (entry.is_regular_file())
+				files.push_back(entry.path().generic_string());
+		}
+
+		// Same pack for the same files, whatever the order of the file system
+		std::sort(files.begin(), files.end());
+		return files;
+	}
+
+	std::string AssetPack::NormalizePath(const std::string& p_path)
+	{
+		std::filesystem::path path = std::filesystem::path(p_path).lexically_normal();
+
+		// Entries are stored relative to the working directory
+		if (path.is_absolute())
+		{
+			std::error_code error;
+			const std::filesystem::path relative = path.lexically_relative(std::filesystem::current_path(error));
+			if (!error && !relative.empty())
+				path = relative;
+		}
+
+		return path.generic_string();
+	}
+
+	int64_t AssetPack::GetSourceTime(const std::string& p_path)
+	{
+		std::error_code error;
+		const std::filesystem::file_time_type time = std::filesystem::last_write_time(p_path, error);
+		return error ? 0 : (int64_t)time.time_since_epoch().count();
+	}
+
+	bool AssetPack::Mount(const std::string& p_path)
+	{
+		Unmount();
+
+		if (!file.Open(p_path))
+			return false;
+
+		const PackHeader* packHeader = (const PackHeader*)file.GetData();
+		if (file.GetSize() < sizeof(PackHeader) || packHeader->magic != PACK_MAGIC || packHeader->version != PACK_VERSION
+			|| packHeader->pathsOffset + packHeader->pathsSize > file.GetSize()
+			|| sizeof(PackHeader) + (uint64_t)packHeader->nbEntries * sizeof(PackEntry) > packHeader->pathsOffset)
+		{
+			Core::Debug::Log::Print(p_path + " is not a valid pack\n", Core::Debug::LogLevel::Warning);
+			file.Close();
+			return false;
+		}
+
+		header = packHeader;
+		entries = (const PackEntry*)(file.GetData() + sizeof(PackHeader));
+		paths = (const char*)file.GetData() + header->pathsOffset;
+
+		// The resources of a scene are loaded together, read the whole pack ahead
+		file.Prefetch(0, file.GetSize());
+
+		Core::Debug::Log::Print("Mount pack " + p_path + " (" + std::to_string(header->nbEntries) + " files)\n", Core::Debug::LogLevel::Notification);
+		return true;
+	}
+
+	void AssetPack::Unmount()
+	{
+		file.Close();
+		header = nullptr;
+		entries = nullptr;
+		paths = nullptr;
+	}
+
+	const PackEntry* AssetPack::Find(const std::string& p_path) const
+	{
+		if (!header)
+			return nullptr;
+
+		const std::string path = NormalizePath(p_path);
+		const uint64_t hash = FileCache::Hash(path.data(), path.size());
+
+		const PackEntry* end = entries + header->nbEntries;
+		const PackEntry* entry = std::lower_bound(entries, end, hash, [](const PackEntry& p_entry, const uint64_t p_hash) { return p_entry.pathHash < p_hash; });
+
+		for (; entry != end && entry->pathHash == hash; entry++)
+		{
+			if (entry->pathSize == path.size() && std::memcmp(paths + entry->pathOffset, path.data(), path.size()) == 0)
+				return entry;
+		}
+
+		return nullptr;
+	}
+
+	std::vector<std::string> AssetPack::GetStaleFiles() const
+	{
+		std::vector<std::string> stale;
+		if (!header)
+			return stale;
+
+		// A shipped pack has no sources beside it, only a different file on disk replaces an entry
+		for (unsigned int i = 0; i < header->nbEntries; i++)
+		{
+			const std::string path = GetPath(entries[i]);
+			const int64_t time = GetSourceTime(path);
+			if (time != 0 && time != entries[i].sourceTime)
+				stale.push_back(path);
+		}
+
+		return stale;
+	}
+
+	std::shared_ptr<const std::string> AssetPack::Read(const std::string& p_path) const
+	{
+		const PackEntry* entry = Find(p_path);
+		if (!entry)
+			return nullptr;
+
+		if (entry->offset + entry->size > file.GetSize())
+		{
+			Core::Debug::Log::Print("Entry " + p_path + " is out of the pack\n", Core::Debug::LogLevel::Warning);
+			return nullptr;
+		}
+
+		const char* data = (const char*)file.GetData() + entry->offset;
+		if (entry->compression == PackCompression::NONE)
+			return std::make_shared<const std::string>(data, entry->size);
+
+		std::string content(entry->rawSize, '\0');
+		const int size = stbi_zlib_decode_buffer(content.data(), (int)content.size(), data, (int)entry->size);
+		if (size != (int)entry->rawSize)
+		{
+			Core::Debug::Log::Print("Fail to decompress " + p_path + " from the pack\n", Core::Debug::LogLevel::Warning);
+			return nullptr;
+		}
+
+		return std::make_shared<const std::string>(std::move(content));
+	}
+}
\ No newline at end of file
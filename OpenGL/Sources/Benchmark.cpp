@@ -0,0 +1,808 @@
+#include "Benchmark.hpp"
+
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <filesystem>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <functional>
+
+#include <glad/glad.h>
+
+#include "Log.hpp"
+#include "FileCache.hpp"
+#include "Image.hpp"
+#include "TextureBaker.hpp"
+#include "GLRecorder.hpp"
+#include "Model.hpp"
+#include "LightManager.hpp"
+#include "RenderQueue.hpp"
+#include "Frustum.hpp"
+#include "OcclusionCulling.hpp"
+#include "JobSystem.hpp"
+#include "LightClusters.hpp"
+
+using namespace Resources;
+
+namespace Core::Debug
+{
+	const unsigned int NB_DECODE_ITERATIONS = 4;
+	const unsigned int NB_DRAW_OBJECTS = 10000;
+	const unsigned int NB_DRAW_PATH_LIGHTS = 5; // Point and spot lights of the block, before the clusters
+	const unsigned int NB_INSTANCED_OBJECTS = 50000;
+	const unsigned int NB_CULLED_OBJECTS = 100000;
+	const unsigned int NB_CULLING_ITERATIONS = 20;
+	const unsigned int NB_OCCLUDERS = 200;
+	const unsigned int NB_OCCLUDEES = 10000;
+	const unsigned int NB_CLUSTER_LIGHTS = 4096;
+	const unsigned int NB_RECORDED_OBJECTS = 65536;
+	const unsigned int RECORD_GRAIN = 512; // Objects per list, as Graph::Draw
+
+	void Benchmark()
+	{
+		BenchmarkTextureDecode();
+		BenchmarkTextureCompression();
+		BenchmarkTextureCache();
+		BenchmarkDrawPath();
+		BenchmarkRenderQueue();
+		BenchmarkInstancing();
+		BenchmarkFrustumCulling();
+		BenchmarkOcclusionCulling();
+		BenchmarkLightClusters();
+		BenchmarkDrawRecording();
+	}
+
+	std::vector<std::string> ListBenchmarkFiles(const std::string& p_directory, const std::vector<std::string>& p_extensions)
+	{
+		std::vector<std::string> files;
+
+		std::error_code error;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(p_directory, error))
+		{
+			const std::string extension = entry.path().extension().string();
+			if (entry.is_regular_file() && std::find(p_extensions.begin(), p_extensions.end(), extension) != p_extensions.end())
+				files.push_back(entry.path().generic_string());
+		}
+
+		std::sort(files.begin(), files.end());
+		return files;
+	}
+
+	void BenchmarkTextureDecode()
+	{
+		const std::vector<std::string> paths = ListBenchmarkFiles("Resources/Textures", { ".png", ".jpg" });
+		if (paths.empty())
+		{
+			Log::Print("Texture decode : no texture in Resources/Textures\n", LogLevel::Warning);
+			return;
+		}
+
+		// Files are read before, only the decode is measured
+		std::vector<std::shared_ptr<const std::string>> files;
+		for (const std::string& path : paths)
+			files.push_back(FileCache::Load(path));
+
+		const size_t nbJobs = files.size() * NB_DECODE_ITERATIONS;
+		std::vector<uint64_t> serialHashes(files.size());
+		std::vector<uint64_t> parallelHashes(nbJobs);
+		size_t decodedBytes = 0;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (unsigned int iteration = 0; iteration < NB_DECODE_ITERATIONS; iteration++)
+		{
+			for (size_t i = 0; i < files.size(); i++)
+			{
+				Image image;
+				image.Decode(files[i]->data(), files[i]->size());
+				serialHashes[i] = FileCache::Hash(image.GetData(), image.GetSize());
+				decodedBytes += image.GetSize();
+			}
+		}
+		const std::chrono::duration<double> serial = std::chrono::steady_clock::now() - start;
+
+		// Every worker decodes at once, the result must not depend on the thread
+		const unsigned int nbThreads = std::max(1u, std::thread::hardware_concurrency());
+		std::atomic<size_t> nextJob = 0;
+		std::vector<std::thread> threads;
+
+		start = std::chrono::steady_clock::now();
+		for (unsigned int t = 0; t < nbThreads; t++)
+		{
+			threads.emplace_back([&]()
+			{
+				for (size_t job = nextJob++; job < nbJobs; job = nextJob++)
+				{
+					const std::shared_ptr<const std::string>& file = files[job % files.size()];
+					const bool flip = job % 2 == 0;
+					Image image;
+					image.Decode(file->data(), file->size(), flip);
+					if (flip)
+						parallelHashes[job] = FileCache::Hash(image.GetData(), image.GetSize());
+				}
+			});
+		}
+		for (std::thread& thread : threads)
+			thread.join();
+		const std::chrono::duration<double> parallel = std::chrono::steady_clock::now() - start;
+
+		// Odd jobs decode without flip on other threads, they must not change the flip of the even ones
+		unsigned int nbMismatch = 0;
+		for (size_t job = 0; job < nbJobs; job += 2)
+		{
+			if (parallelHashes[job] != serialHashes[job % files.size()])
+				nbMismatch++;
+		}
+
+		const double megaBytes = (double)decodedBytes / (1024.0 * 1024.0);
+		Log::Print("Texture decode : " + std::to_string(files.size()) + " textures x " + std::to_string(NB_DECODE_ITERATIONS) + ", "
+			+ std::to_string((int)megaBytes) + " MB of pixels\n", LogLevel::Test);
+		Log::Print("  serial   : " + std::to_string(serial.count() * 1000.0) + " ms (" + std::to_string(megaBytes / serial.count()) + " MB/s)\n", LogLevel::Test);
+		Log::Print("  " + std::to_string(nbThreads) + " threads : " + std::to_string(parallel.count() * 1000.0) + " ms ("
+			+ std::to_string(megaBytes / parallel.count()) + " MB/s), x" + std::to_string(serial.count() / parallel.count()) + "\n", LogLevel::Test);
+
+		if (nbMismatch)
+			Log::Print("Texture decode : " + std::to_string(nbMismatch) + " images differ when decoded in parallel\n", LogLevel::Warning);
+	}
+
+	void BenchmarkTextureCompression()
+	{
+		const std::vector<std::string> paths = ListBenchmarkFiles("Resources/Textures", { ".png", ".jpg" });
+		std::vector<Image> images(paths.size());
+		for (size_t i = 0; i < paths.size(); i++)
+		{
+			std::shared_ptr<const std::string> file = FileCache::Load(paths[i]);
+			images[i].Decode(file->data(), file->size());
+		}
+
+		// Each texture is baked by one worker, as in Texture::Init
+		const unsigned int nbThreads = std::max(1u, std::thread::hardware_concurrency());
+		std::vector<TextureData> baked(images.size());
+		std::atomic<size_t> nextTexture = 0;
+		std::vector<std::thread> threads;
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (unsigned int t = 0; t < nbThreads; t++)
+		{
+			threads.emplace_back([&]()
+			{
+				for (size_t i = nextTexture++; i < images.size(); i = nextTexture++)
+					baked[i] = TextureBaker::Bake(images[i], true);
+			});
+		}
+		for (std::thread& thread : threads)
+			thread.join();
+		const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+		double nbPixels = 0.0;
+		size_t rawSize = 0;
+		size_t compressedSize = 0;
+
+		for (size_t i = 0; i < images.size(); i++)
+		{
+			const Image& image = images[i];
+			for (const TextureLevel& level : baked[i].levels)
+				nbPixels += (double)level.width * level.height;
+			rawSize += (size_t)image.GetWidth() * image.GetHeight() * 4 * 4 / 3;
+			compressedSize += baked[i].GetPixelsSize();
+
+			// PSNR of the first level, on the channels of the source
+			const TextureData decompressed = TextureBaker::Decompress(baked[i]);
+			const unsigned char* result = decompressed.GetLevel(0);
+			const int channels = image.GetNrChannels();
+			const int nbCompared = baked[i].format == TextureFormat::BC3 ? 4 : 3;
+			double squaredError = 0.0;
+
+			for (size_t pixel = 0; pixel < (size_t)image.GetWidth() * image.GetHeight(); pixel++)
+			{
+				const unsigned char* source = image.GetData() + pixel * channels;
+				for (int channel = 0; channel < nbCompared; channel++)
+				{
+					const int sourceChannel = channels >= 3 ? std::min(channel, channels - 1) : (channel == 3 ? 1 : 0);
+					const double error = (double)source[sourceChannel] - result[pixel * 4 + channel];
+					squaredError += error * error;
+				}
+			}
+
+			const double mse = squaredError / ((double)image.GetWidth() * image.GetHeight() * nbCompared);
+			const double psnr = mse > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / mse) : 99.0;
+			Log::Print("  " + paths[i] + (baked[i].format == TextureFormat::BC3 ? " BC3 " : " BC1 ") + std::to_string(image.GetWidth()) + "x"
+				+ std::to_string(image.GetHeight()) + " PSNR " + std::to_string(psnr) + " dB\n", LogLevel::Test);
+		}
+
+		Log::Print("Texture compression : " + std::to_string(images.size()) + " textures with mipmaps on " + std::to_string(nbThreads) + " threads, "
+			+ std::to_string(duration.count() * 1000.0) + " ms (" + std::to_string(nbPixels / duration.count() / 1000000.0) + " MPixels/s), "
+			+ std::to_string(rawSize / 1024) + " KB -> " + std::to_string(compressedSize / 1024) + " KB\n", LogLevel::Test);
+	}
+
+	void BenchmarkTextureCache()
+	{
+		const std::vector<std::string> paths = ListBenchmarkFiles("Resources/Textures", { ".png", ".jpg" });
+
+		// Both runs read the source, its hash is the key of the cache
+		std::vector<std::shared_ptr<const std::string>> files;
+		for (const std::string& path : paths)
+			files.push_back(FileCache::Load(path));
+
+		// Cold : decode and mipmaps, as in Texture::Init without compression
+		const std::chrono::steady_clock::time_point coldStart = std::chrono::steady_clock::now();
+		for (const std::shared_ptr<const std::string>& file : files)
+		{
+			const uint64_t key = TextureBaker::GetKey(*file, false);
+			Image image;
+			image.Decode(file->data(), file->size());
+			TextureBaker::SaveCache(TextureBaker::GetCachePath(key), key, TextureBaker::Bake(image, false));
+		}
+		const std::chrono::duration<double> cold = std::chrono::steady_clock::now() - coldStart;
+
+		// Warm : mapped, every page of the pixels is touched like the upload would
+		size_t nbBytes = 0;
+		unsigned int checksum = 0;
+		const std::chrono::steady_clock::time_point warmStart = std::chrono::steady_clock::now();
+		for (const std::shared_ptr<const std::string>& file : files)
+		{
+			const uint64_t key = TextureBaker::GetKey(*file, false);
+			TextureData texture;
+			if (!TextureBaker::LoadCache(TextureBaker::GetCachePath(key), key, texture))
+				continue;
+
+			for (size_t i = 0; i < texture.GetPixelsSize(); i += 4096)
+				checksum += texture.GetPixels()[i];
+			nbBytes += texture.GetPixelsSize();
+		}
+		const std::chrono::duration<double> warm = std::chrono::steady_clock::now() - warmStart;
+
+		const double megaBytes = (double)nbBytes / (1024.0 * 1024.0);
+		Log::Print("Texture cache : " + std::to_string(files.size()) + " textures, " + std::to_string((int)megaBytes) + " MB of levels (" + std::to_string(checksum % 10) + ")\n", LogLevel::Test);
+		Log::Print("  decode : " + std::to_string(cold.count() * 1000.0) + " ms\n", LogLevel::Test);
+		Log::Print("  cache  : " + std::to_string(warm.count() * 1000.0) + " ms (" + std::to_string(megaBytes / warm.count()) + " MB/s), x"
+			+ std::to_string(cold.count() / warm.count()) + "\n", LogLevel::Test);
+	}
+
+	// Uniforms of the default shader before the lights block, as the driver reported them
+	std::vector<std::string> GetDrawPathUniforms()
+	{
+		std::vector<std::string> uniforms = { "model", "normalMatrix", "mvp", "texture1", "uvTransform", "nbDirectionLight", "nbPointLight", "nbSpotLight" };
+		const char* lightData[] = { "lightPos", "viewPos", "ambientColor", "diffuseColor", "specularColor" };
+
+		for (unsigned int i = 0; i < LowRenderer::MAX_DIRECTION_LIGHT; i++)
+		{
+			const std::string light = "directionLights[" + std::to_string(i) + "].";
+			uniforms.push_back(light + "direction");
+			for (const char* member : lightData)
+				uniforms.push_back(light + "lightData." + member);
+		}
+		for (unsigned int i = 0; i < NB_DRAW_PATH_LIGHTS; i++)
+		{
+			const std::string light = "pointLights[" + std::to_string(i) + "].";
+			for (const char* member : { "constant", "linear", "quadratic" })
+				uniforms.push_back(light + member);
+			for (const char* member : lightData)
+				uniforms.push_back(light + "lightData." + member);
+		}
+		for (unsigned int i = 0; i < NB_DRAW_PATH_LIGHTS; i++)
+		{
+			const std::string light = "spotLights[" + std::to_string(i) + "].";
+			for (const char* member : { "direction", "cutOff", "outerCutOff" })
+				uniforms.push_back(light + member);
+			for (const char* member : lightData)
+				uniforms.push_back(light + "lightData." + member);
+		}
+
+		return uniforms;
+	}
+
+	// Draw of one object before the uniform cache : every name is built and looked up by the driver
+	void DrawPathByName(const int p_program, const Maths::Mat4& p_transform, const Maths::Mat4& p_mvp, const unsigned int p_nbLights)
+	{
+		glUseProgram(p_program);
+
+		glUniform1f(glGetUniformLocation(p_program, "nbDirectionLight"), (float)p_nbLights);
+		glUniform1f(glGetUniformLocation(p_program, "nbPointLight"), (float)p_nbLights);
+		glUniform1f(glGetUniformLocation(p_program, "nbSpotLight"), (float)p_nbLights);
+
+		const std::vector<std::pair<const char*, std::vector<const char*>>> lightMembers = {
+			{ "directionLights[", { "direction" } },
+			{ "pointLights[", { "constant", "linear", "quadratic" } },
+			{ "spotLights[", { "direction", "cutOff", "outerCutOff" } } };
+
+		for (const auto& [lights, members] : lightMembers)
+		{
+			for (unsigned int i = 0; i < p_nbLights; i++)
+			{
+				std::string array = lights + std::to_string(i) + "].";
+				for (const char* member : members)
+					glUniform1f(glGetUniformLocation(p_program, (array + member).c_str()), 1.f);
+
+				array += "lightData.";
+				glUniform4f(glGetUniformLocation(p_program, (array + "ambientColor").c_str()), 0.f, 0.f, 0.f, 1.f);
+				glUniform4f(glGetUniformLocation(p_program, (array + "diffuseColor").c_str()), 1.f, 1.f, 1.f, 1.f);
+				glUniform4f(glGetUniformLocation(p_program, (array + "specularColor").c_str()), 1.f, 1.f, 1.f, 1.f);
+				glUniform3f(glGetUniformLocation(p_program, (array + "lightPos").c_str()), 0.f, 5.f, 0.f);
+				glUniform3f(glGetUniformLocation(p_program, (array + "viewPos").c_str()), 0.f, 0.f, 0.f);
+			}
+		}
+
+		glBindTextureUnit(Resources::DIFFUSE_TEXTURE_UNIT, 1);
+		glBindSampler(Resources::DIFFUSE_TEXTURE_UNIT, 1);
+		glUniform1i(glGetUniformLocation(p_program, "texture1"), Resources::DIFFUSE_TEXTURE_UNIT);
+		glUniform4f(glGetUniformLocation(p_program, "uvTransform"), 1.f, 1.f, 0.f, 0.f);
+
+		glUniformMatrix4fv(glGetUniformLocation(p_program, "model"), 1, GL_TRUE, &p_transform.mat[0][0]);
+		glUniformMatrix4fv(glGetUniformLocation(p_program, "mvp"), 1, GL_TRUE, &p_mvp.mat[0][0]);
+
+		glBindVertexArray(1);
+		glDrawElements(GL_TRIANGLES, 0, GL_UNSIGNED_INT, 0);
+	}
+
+	void BenchmarkDrawPath()
+	{
+		// Declared first, the resources are deleted while the recorder is still installed
+		GLRecorder recorder(GetDrawPathUniforms());
+
+		Resources::Shader shader("Benchmark", "Resources/Shaders/VertexShaderSource.vert", "Resources/Shaders/FragmentShaderSource.frag", 0);
+		shader.Init();
+		shader.InitOpenGL();
+		Resources::Mesh mesh("Benchmark", "", "", 1);
+		Resources::Texture texture("Benchmark", "", "", 2);
+		LowRenderer::Model model(&mesh, &shader, &texture);
+
+		// One light of each type, as in Scene1
+		LowRenderer::LightManager lights;
+		LowRenderer::InitLight initLight{ Maths::Vec3(0.f, 5.f, 0.f), Maths::Vec4(0.1f, 0.1f, 0.1f, 1.f), Maths::Vec4(1.f, 1.f, 1.f, 1.f), Maths::Vec4(1.f, 1.f, 1.f, 1.f) };
+		lights.AddDirectionLight(LowRenderer::DirectionLight(initLight, Maths::Vec3(0.f, 0.f, 1.f)));
+		lights.AddPointLight(LowRenderer::PointLight(initLight, 1.f, 0.09f, 0.032f));
+		lights.AddSpotLight(LowRenderer::SpotLight(initLight, Maths::Vec3(0.f, -1.f, 0.f), 12.5f, 0.82f));
+
+		const Maths::Mat4 transform = Maths::Mat4::Identity();
+		const Maths::Mat4 normalMatrix = transform.GetNormalMatrix();
+		const Maths::Mat4 mvp = Maths::Mat4::Identity();
+		const Maths::Vec3 camPosition;
+
+		GLRecorder::Reset();
+		const std::chrono::steady_clock::time_point byNameStart = std::chrono::steady_clock::now();
+		for (unsigned int i = 0; i < NB_DRAW_OBJECTS; i++)
+			DrawPathByName(shader.GetShaderProgram(), transform, mvp, 1);
+		const std::chrono::duration<double> byName = std::chrono::steady_clock::now() - byNameStart;
+		const GLCalls byNameCalls = GLRecorder::GetCalls();
+
+		// Same calls as Scene::Draw : the lights block once per frame, then GameObject::Draw
+		GLRecorder::Reset();
+		const std::chrono::steady_clock::time_point cachedStart = std::chrono::steady_clock::now();
+		lights.Update(camPosition);
+		for (unsigned int i = 0; i < NB_DRAW_OBJECTS; i++)
+		{
+			shader.Use(lights.GetDefines());
+			model.Draw(transform, normalMatrix, mvp);
+		}
+		const std::chrono::duration<double> cached = std::chrono::steady_clock::now() - cachedStart;
+		const GLCalls cachedCalls = GLRecorder::GetCalls();
+
+		auto perObject = [](const std::chrono::duration<double>& p_duration) { return std::to_string(p_duration.count() * 1e9 / NB_DRAW_OBJECTS); };
+		Log::Print("Draw path : " + std::to_string(NB_DRAW_OBJECTS) + " objects, " + std::to_string(shader.GetNbUniforms()) + " uniforms reflected\n", LogLevel::Test);
+		Log::Print("  by name : " + perObject(byName) + " ns per object, " + std::to_string(byNameCalls.getUniformLocation / NB_DRAW_OBJECTS) + " glGetUniformLocation, "
+			+ std::to_string(byNameCalls.uniform / NB_DRAW_OBJECTS) + " glUniform\n", LogLevel::Test);
+		Log::Print("  cached  : " + perObject(cached) + " ns per object, " + std::to_string(cachedCalls.getUniformLocation / NB_DRAW_OBJECTS) + " glGetUniformLocation, "
+			+ std::to_string(cachedCalls.uniform / NB_DRAW_OBJECTS) + " glUniform, " + std::to_string(cachedCalls.bufferUpload) + " lights upload per frame, x"
+			+ std::to_string(byName.count() / cached.count()) + "\n", LogLevel::Test);
+	}
+
+	void BenchmarkRenderQueue()
+	{
+		// Declared first, the resources are deleted while the recorder is still installed
+		GLRecorder recorder(GetDrawPathUniforms());
+
+		// Two shaders, four textures and three meshes, as the objects of Scene1 and their colliders
+		std::vector<std::unique_ptr<Resources::Shader>> shaders;
+		for (const char* fragment : { "Resources/Shaders/FragmentShaderSource.frag", "Resources/Shaders/ColliderFrag.frag" })
+		{
+			shaders.push_back(std::make_unique<Resources::Shader>("Benchmark", "Resources/Shaders/VertexShaderSource.vert", fragment, (unsigned int)shaders.size()));
+			shaders.back()->Init();
+			shaders.back()->InitOpenGL();
+		}
+		std::vector<std::unique_ptr<Resources::Texture>> textures;
+		for (unsigned int i = 0; i < 4; i++)
+			textures.push_back(std::make_unique<Resources::Texture>("Benchmark", "", "", 10 + i));
+		std::vector<std::unique_ptr<Resources::Mesh>> meshes;
+		for (unsigned int i = 0; i < 3; i++)
+			meshes.push_back(std::make_unique<Resources::Mesh>("Benchmark", "", "", 20 + i));
+
+		// In the order of the graph : the objects sharing their resources are not consecutive
+		std::mt19937 random(42);
+		std::vector<LowRenderer::Model> models;
+		std::vector<Maths::Mat4> transforms;
+		for (unsigned int i = 0; i < NB_DRAW_OBJECTS; i++)
+		{
+			models.push_back(LowRenderer::Model(meshes[random() % meshes.size()].get(), shaders[random() % shaders.size()].get(), textures[random() % textures.size()].get()));
+			transforms.push_back(Maths::Mat4::CreateTranslationMatrix(Maths::Vec3((float)(random() % 100), 0.f, (float)(random() % 100))));
+		}
+		const Maths::Mat4 normalMatrix = Maths::Mat4::Identity();
+		const ShaderDefines defines;
+
+		// Before the queue : GameObject::Draw binds everything for each object
+		GLRecorder::Reset();
+		const std::chrono::steady_clock::time_point immediateStart = std::chrono::steady_clock::now();
+		for (unsigned int i = 0; i < NB_DRAW_OBJECTS; i++)
+		{
+			models[i].GetShader()->Use(defines);
+			models[i].Draw(transforms[i], normalMatrix, transforms[i]);
+		}
+		const std::chrono::duration<double> immediate = std::chrono::steady_clock::now() - immediateStart;
+		const GLCalls immediateCalls = GLRecorder::GetCalls();
+
+		// Second frame of the queue : its buffers are already allocated
+		LowRenderer::RenderQueue queue;
+		queue.SetInstancing(false);
+		std::chrono::duration<double> sorted;
+		for (unsigned int frame = 0; frame < 2; frame++)
+		{
+			GLRecorder::Reset();
+			const std::chrono::steady_clock::time_point sortedStart = std::chrono::steady_clock::now();
+			queue.Clear();
+			for (unsigned int i = 0; i < NB_DRAW_OBJECTS; i++)
+				queue.Add(models[i], transforms[i], normalMatrix, transforms[i]);
+			queue.Sort();
+			queue.Submit(defines, Maths::Mat4::Identity());
+			sorted = std::chrono::steady_clock::now() - sortedStart;
+		}
+		const GLCalls sortedCalls = GLRecorder::GetCalls();
+
+		auto binds = [](const GLCalls& p_calls)
+		{
+			return std::to_string(p_calls.useProgram) + " glUseProgram, " + std::to_string(p_calls.bindTexture) + " texture binds, "
+				+ std::to_string(p_calls.bindVertexArray) + " glBindVertexArray, " + std::to_string(p_calls.uniform) + " glUniform";
+		};
+		auto perObject = [](const std::chrono::duration<double>& p_duration) { return std::to_string(p_duration.count() * 1e9 / NB_DRAW_OBJECTS); };
+		Log::Print("Render queue : " + std::to_string(NB_DRAW_OBJECTS) + " objects, 2 shaders, 4 textures, 3 meshes\n", LogLevel::Test);
+		Log::Print("  graph order : " + perObject(immediate) + " ns per object, " + binds(immediateCalls) + "\n", LogLevel::Test);
+		Log::Print("  sorted      : " + perObject(sorted) + " ns per object, " + binds(sortedCalls) + ", x"
+			+ std::to_string((double)(immediateCalls.useProgram + immediateCalls.bindTexture + immediateCalls.bindVertexArray + immediateCalls.uniform)
+				/ (sortedCalls.useProgram + sortedCalls.bindTexture + sortedCalls.bindVertexArray + sortedCalls.uniform)) + " fewer calls\n", LogLevel::Test);
+	}
+
+	void BenchmarkInstancing()
+	{
+		// Declared first, the resources are deleted while the recorder is still installed
+		GLRecorder recorder;
+
+		Resources::Shader shader("Benchmark", "Resources/Shaders/VertexShaderSource.vert", "Resources/Shaders/FragmentShaderSource.frag", 0);
+		shader.Init();
+		shader.InitOpenGL();
+		std::vector<std::unique_ptr<Resources::Texture>> textures;
+		for (unsigned int i = 0; i < 4; i++)
+			textures.push_back(std::make_unique<Resources::Texture>("Benchmark", "", "", 10 + i));
+		std::vector<std::unique_ptr<Resources::Mesh>> meshes;
+		for (unsigned int i = 0; i < 3; i++)
+			meshes.push_back(std::make_unique<Resources::Mesh>("Benchmark", "", "", 20 + i));
+
+		// Twelve distinct models shared by every object, as basicBox by the boxes of Scene1
+		std::mt19937 random(42);
+		std::vector<LowRenderer::Model> models;
+		std::vector<Maths::Mat4> transforms;
+		for (unsigned int i = 0; i < NB_INSTANCED_OBJECTS; i++)
+		{
+			models.push_back(LowRenderer::Model(meshes[random() % meshes.size()].get(), &shader, textures[random() % textures.size()].get()));
+			transforms.push_back(Maths::Mat4::CreateTranslationMatrix(Maths::Vec3((float)(random() % 100), 0.f, (float)(random() % 100))));
+		}
+		const Maths::Mat4 normalMatrix = Maths::Mat4::Identity();
+		const ShaderDefines defines;
+
+		LowRenderer::RenderQueue queue;
+		// One by one, instanced, then one multi-draw indirect per texture
+		const char* const modes[] = { "one by one", "instanced", "indirect" };
+		for (unsigned int mode = 0; mode < 3; mode++)
+		{
+			queue.SetInstancing(mode > 0);
+			queue.SetIndirect(mode == 2);
+
+			// Second frame : the buffers of the queue are already allocated
+			std::chrono::duration<double> sort, submit;
+			for (unsigned int frame = 0; frame < 2; frame++)
+			{
+				queue.Clear();
+				for (unsigned int i = 0; i < NB_INSTANCED_OBJECTS; i++)
+					queue.Add(models[i], transforms[i], normalMatrix, transforms[i]);
+
+				const std::chrono::steady_clock::time_point sortStart = std::chrono::steady_clock::now();
+				queue.Sort();
+				const std::chrono::steady_clock::time_point submitStart = std::chrono::steady_clock::now();
+				GLRecorder::Reset();
+				queue.Submit(defines, Maths::Mat4::Identity());
+				submit = std::chrono::steady_clock::now() - submitStart;
+				sort = submitStart - sortStart;
+			}
+
+			const GLCalls& calls = GLRecorder::GetCalls();
+			auto perObject = [](const std::chrono::duration<double>& p_duration) { return std::to_string(p_duration.count() * 1e9 / NB_INSTANCED_OBJECTS); };
+			if (mode == 0)
+				Log::Print("Instancing : " + std::to_string(NB_INSTANCED_OBJECTS) + " objects, 12 distinct models\n", LogLevel::Test);
+			Log::Print(std::string("  ") + modes[mode] + " : sort and grouping " + perObject(sort) + " ns, submit " + perObject(submit)
+				+ " ns per object, " + std::to_string(calls.draw) + " draw calls, " + std::to_string(calls.uniform) + " glUniform, "
+				+ std::to_string(queue.GetInstances().size() * sizeof(Resources::InstanceData) / 1024) + " KB of instances\n", LogLevel::Test);
+		}
+	}
+
+	void BenchmarkFrustumCulling()
+	{
+		// Large level around the camera : most of the objects are behind it or too far
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> position(-500.f, 500.f);
+		std::uniform_real_distribution<float> size(0.5f, 5.f);
+		LowRenderer::BoundingSpheres spheres;
+		spheres.Reserve(NB_CULLED_OBJECTS);
+		for (unsigned int i = 0; i < NB_CULLED_OBJECTS; i++)
+			spheres.Add(Maths::Vec3(position(random), position(random) / 10.f, position(random)), size(random));
+
+		// Projection of the Camera, looking toward -z from the origin
+		const float near = 0.1f, far = 100.f;
+		const float a = 1.f / tanf(Maths::DEG2RAD * 100.f / 2.f);
+		const Maths::Mat4 projection(
+			a / (16.f / 9.f), 0.f, 0.f,							 0.f,
+			0.f,			  a,   0.f,							 0.f,
+			0.f,			  0.f, -(far + near) / (far - near), -(2 * far * near) / (far - near),
+			0.f,			  0.f, -1.f,						 0.f);
+		const LowRenderer::Frustum frustum = LowRenderer::Frustum::FromViewProjection(projection);
+
+		std::vector<unsigned int> visible;
+		visible.reserve(NB_CULLED_OBJECTS);
+		auto measure = [&](void (*p_cull)(const LowRenderer::Frustum&, const LowRenderer::BoundingSpheres&, std::vector<unsigned int>&))
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (unsigned int i = 0; i < NB_CULLING_ITERATIONS; i++)
+				p_cull(frustum, spheres, visible);
+			return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / NB_CULLING_ITERATIONS;
+		};
+
+		const double scalar = measure(&LowRenderer::CullSpheresScalar);
+		const size_t nbVisible = visible.size();
+		const double simd = measure(&LowRenderer::CullSpheres);
+
+#ifdef __AVX__
+		const std::string width = "AVX, 8";
+#else
+		const std::string width = "SSE, 4";
+#endif
+		Log::Print("Frustum culling : " + std::to_string(NB_CULLED_OBJECTS) + " spheres, " + std::to_string(nbVisible) + " visible\n", LogLevel::Test);
+		Log::Print("  scalar : " + std::to_string(scalar * 1000.0) + " ms\n", LogLevel::Test);
+		Log::Print("  " + width + " spheres per batch : " + std::to_string(simd * 1000.0) + " ms, x" + std::to_string(scalar / simd)
+			+ (visible.size() == nbVisible ? "" : ", different results") + "\n", LogLevel::Test);
+	}
+
+	void BenchmarkOcclusionCulling()
+	{
+		// Walls between the camera and the objects, as the boxes of the scenes
+		std::vector<Resources::Vertex> box;
+		for (unsigned int corner = 0; corner < 8; corner++)
+			box.push_back({ Maths::Vec3(corner & 1 ? 1.f : -1.f, corner & 2 ? 1.f : -1.f, corner & 4 ? 1.f : -1.f) });
+		const std::vector<unsigned int> boxIndices = { 0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6, 0, 1, 4, 1, 5, 4, 2, 6, 3, 3, 6, 7, 0, 4, 2, 2, 4, 6, 1, 3, 5, 3, 7, 5 };
+
+		// Projection of the Camera, looking toward -z from the origin
+		const float near = 0.1f, far = 100.f;
+		const float a = 1.f / tanf(Maths::DEG2RAD * 100.f / 2.f);
+		const Maths::Mat4 viewProjection(
+			a / (16.f / 9.f), 0.f, 0.f,							 0.f,
+			0.f,			  a,   0.f,							 0.f,
+			0.f,			  0.f, -(far + near) / (far - near), -(2 * far * near) / (far - near),
+			0.f,			  0.f, -1.f,						 0.f);
+
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> side(-40.f, 40.f);
+		std::uniform_real_distribution<float> wallDepth(-30.f, -8.f);
+		std::uniform_real_distribution<float> wallSize(1.f, 6.f);
+		std::vector<Maths::Mat4> occluders;
+		for (unsigned int i = 0; i < NB_OCCLUDERS; i++)
+		{
+			occluders.push_back(viewProjection * Maths::Mat4::CreateTranslationMatrix(Maths::Vec3(side(random), side(random) / 4.f, wallDepth(random)))
+				* Maths::Mat4::CreateScaleMatrix(Maths::Vec3(wallSize(random), wallSize(random), 0.5f)));
+		}
+
+		std::uniform_real_distribution<float> objectDepth(-90.f, -10.f);
+		std::uniform_real_distribution<float> objectSize(0.2f, 2.f);
+		LowRenderer::BoundingSpheres objects;
+		for (unsigned int i = 0; i < NB_OCCLUDEES; i++)
+			objects.Add(Maths::Vec3(side(random), side(random) / 4.f, objectDepth(random)), objectSize(random));
+
+		LowRenderer::OcclusionBuffer buffer;
+		auto setup = [&]()
+		{
+			buffer.Clear();
+			for (const Maths::Mat4& mvp : occluders)
+				buffer.AddOccluder(box, boxIndices, mvp);
+		};
+
+		auto measure = [&](const std::function<void()>& p_function)
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (unsigned int i = 0; i < NB_CULLING_ITERATIONS; i++)
+				p_function();
+			return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / NB_CULLING_ITERATIONS * 1000.0;
+		};
+
+		const double setupTime = measure(setup);
+		const double scalar = measure([&]() { setup(); buffer.RasterizeScalar(); }) - setupTime;
+		const double simd = measure([&]() { setup(); buffer.Rasterize(); }) - setupTime;
+		Core::JobSystem::Start(Core::JobSystem::GetDefaultNbWorkers());
+		const double simdWorkers = measure([&]() { setup(); buffer.Rasterize(); }) - setupTime;
+		const double pyramid = measure([&]() { buffer.BuildPyramid(); });
+
+		unsigned int nbOccluded = 0;
+		const double queries = measure([&]()
+		{
+			nbOccluded = 0;
+			for (unsigned int i = 0; i < NB_OCCLUDEES; i++)
+				nbOccluded += buffer.IsOccluded(Maths::Vec3(objects.GetX()[i], objects.GetY()[i], objects.GetZ()[i]), objects.GetRadius()[i], viewProjection);
+		});
+		const unsigned int nbWorkers = Core::JobSystem::GetNbWorkers();
+		Core::JobSystem::Stop();
+
+		Log::Print("Occlusion culling : " + std::to_string(NB_OCCLUDERS) + " occluders, " + std::to_string(buffer.GetNbTriangles()) + " triangles, "
+			+ std::to_string(LowRenderer::OCCLUSION_WIDTH) + "x" + std::to_string(LowRenderer::OCCLUSION_HEIGHT) + " depth\n", LogLevel::Test);
+		Log::Print("  setup " + std::to_string(setupTime) + " ms, rasterization scalar " + std::to_string(scalar) + " ms, SSE " + std::to_string(simd)
+			+ " ms, SSE on " + std::to_string(nbWorkers) + " workers " + std::to_string(simdWorkers) + " ms, pyramid " + std::to_string(pyramid) + " ms\n", LogLevel::Test);
+		Log::Print("  " + std::to_string(NB_OCCLUDEES) + " objects tested in " + std::to_string(queries) + " ms, " + std::to_string(nbOccluded) + " occluded\n", LogLevel::Test);
+	}
+
+	void BenchmarkLightClusters()
+	{
+		// Lights in the frustum of the Camera, a third of them spots
+		const float tanHalfFovY = tanf(Maths::DEG2RAD * 100.f / 2.f), aspect = 16.f / 9.f;
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> unit(-1.f, 1.f);
+		std::uniform_real_distribution<float> depth(1.f, 90.f);
+		std::uniform_real_distribution<float> range(0.5f, 6.f);
+		std::uniform_real_distribution<float> angle(0.1f, 1.f);
+
+		std::vector<LowRenderer::ClusterLight> lights;
+		for (unsigned int i = 0; i < NB_CLUSTER_LIGHTS; i++)
+		{
+			const float z = -depth(random);
+			const Maths::Vec3 position(unit(random) * -z * tanHalfFovY * aspect, unit(random) * -z * tanHalfFovY, z);
+			if (i % 3)
+				lights.push_back(LowRenderer::ClusterLight::Point(position, range(random)));
+			else
+			{
+				Maths::Vec3 direction(unit(random), unit(random), unit(random));
+				direction.Normalize();
+				lights.push_back(LowRenderer::ClusterLight::Spot(position, direction, angle(random), range(random) * 2.f));
+			}
+		}
+
+		LowRenderer::LightClusters clusters;
+		clusters.SetProjection(0.1f, 100.f, 100.f, aspect);
+
+		auto measure = [&]()
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (unsigned int i = 0; i < NB_CULLING_ITERATIONS; i++)
+				clusters.Build(lights);
+			return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / NB_CULLING_ITERATIONS * 1000.0;
+		};
+
+		const double serial = measure();
+		const std::vector<uint32_t> serialIndices = clusters.GetIndices();
+		Core::JobSystem::Start(Core::JobSystem::GetDefaultNbWorkers());
+		const double parallel = measure();
+		const unsigned int nbWorkers = Core::JobSystem::GetNbWorkers();
+		Core::JobSystem::Stop();
+
+		unsigned int nbUsed = 0, maxLights = 0;
+		for (unsigned int cluster = 0; cluster < LowRenderer::NB_CLUSTERS; cluster++)
+		{
+			const uint32_t count = clusters.GetGrid()[cluster * 2 + 1];
+			nbUsed += count > 0;
+			maxLights = std::max(maxLights, count);
+		}
+
+		Log::Print("Light clusters : " + std::to_string(NB_CLUSTER_LIGHTS) + " lights, " + std::to_string(LowRenderer::CLUSTER_X) + "x" + std::to_string(LowRenderer::CLUSTER_Y)
+			+ "x" + std::to_string(LowRenderer::CLUSTER_Z) + " clusters\n", LogLevel::Test);
+		Log::Print("  build on 1 thread " + std::to_string(serial) + " ms, on " + std::to_string(nbWorkers) + " workers " + std::to_string(parallel) + " ms"
+			+ (clusters.GetIndices() == serialIndices ? "" : " (MISMATCH)") + "\n", LogLevel::Test);
+		Log::Print("  " + std::to_string(clusters.GetIndices().size()) + " indices, " + std::to_string(nbUsed) + " clusters lit, "
+			+ std::to_string(nbUsed ? (double)clusters.GetIndices().size() / nbUsed : 0.0) + " lights per lit cluster, max " + std::to_string(maxLights)
+			+ ", " + std::to_string(clusters.GetNbOverflows()) + " overflows\n", LogLevel::Test);
+	}
+
+	void BenchmarkDrawRecording()
+	{
+		GLRecorder recorder;
+
+		Resources::Shader shader("Benchmark", "Resources/Shaders/VertexShaderSource.vert", "Resources/Shaders/FragmentShaderSource.frag", 0);
+		shader.Init();
+		shader.InitOpenGL();
+		std::vector<std::unique_ptr<Resources::Texture>> textures;
+		for (unsigned int i = 0; i < 4; i++)
+			textures.push_back(std::make_unique<Resources::Texture>("Benchmark", "", "", 10 + i));
+		std::vector<std::unique_ptr<Resources::Mesh>> meshes;
+		for (unsigned int i = 0; i < 3; i++)
+			meshes.push_back(std::make_unique<Resources::Mesh>("Benchmark", "", "", 20 + i));
+
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> position(-50.f, 50.f);
+		std::vector<LowRenderer::Model> models;
+		std::vector<Maths::Mat4> transforms;
+		for (unsigned int i = 0; i < NB_RECORDED_OBJECTS; i++)
+		{
+			models.push_back(LowRenderer::Model(meshes[random() % meshes.size()].get(), &shader, textures[random() % textures.size()].get()));
+			transforms.push_back(Maths::Mat4::CreateTranslationMatrix(Maths::Vec3(position(random), 0.f, position(random) - 60.f)));
+		}
+		const Maths::Mat4 normalMatrix = Maths::Mat4::Identity();
+		const ShaderDefines defines;
+
+		const float near = 0.1f, far = 100.f;
+		const float a = 1.f / tanf(Maths::DEG2RAD * 100.f / 2.f);
+		const Maths::Mat4 viewProjection(
+			a / (16.f / 9.f), 0.f, 0.f,							 0.f,
+			0.f,			  a,   0.f,							 0.f,
+			0.f,			  0.f, -(far + near) / (far - near), -(2 * far * near) / (far - near),
+			0.f,			  0.f, -1.f,						 0.f);
+
+		// What GameObject::Draw does for each visible object
+		auto record = [&](unsigned int p_begin, unsigned int p_end, LowRenderer::RenderList& p_list)
+		{
+			for (unsigned int i = p_begin; i < p_end; i++)
+				p_list.Add(models[i], transforms[i], normalMatrix, viewProjection * transforms[i]);
+		};
+
+		LowRenderer::RenderQueue queue;
+		struct FrameTimes { double record = 0.0, sort = 0.0, submit = 0.0; };
+		auto frame = [&](const bool p_workers)
+		{
+			FrameTimes times;
+			const unsigned int nbFrames = 4;
+			for (unsigned int i = 0; i < nbFrames; i++)
+			{
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				queue.Clear();
+				if (p_workers)
+					queue.Record(NB_RECORDED_OBJECTS, RECORD_GRAIN, record);
+				else
+				{
+					for (unsigned int object = 0; object < NB_RECORDED_OBJECTS; object++)
+						queue.Add(models[object], transforms[object], normalMatrix, viewProjection * transforms[object]);
+				}
+				const std::chrono::steady_clock::time_point sortStart = std::chrono::steady_clock::now();
+				queue.Sort();
+				const std::chrono::steady_clock::time_point submitStart = std::chrono::steady_clock::now();
+				queue.Submit(defines, viewProjection);
+				const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+				times.record += std::chrono::duration<double>(sortStart - start).count() * 1000.0 / nbFrames;
+				times.sort += std::chrono::duration<double>(submitStart - sortStart).count() * 1000.0 / nbFrames;
+				times.submit += std::chrono::duration<double>(end - submitStart).count() * 1000.0 / nbFrames;
+			}
+			return times;
+		};
+
+		const FrameTimes serial = frame(false);
+		const std::vector<LowRenderer::RenderCommand> serialCommands = queue.GetCommands();
+
+		auto print = [&serial](const std::string& p_name, const FrameTimes& p_times)
+		{
+			const double frameTime = p_times.record + p_times.sort + p_times.submit;
+			Log::Print(p_name + "record " + std::to_string(p_times.record) + " ms, sort " + std::to_string(p_times.sort) + " ms, submit " + std::to_string(p_times.submit)
+				+ " ms, frame " + std::to_string(frameTime) + " ms, x" + std::to_string((serial.record + serial.sort + serial.submit) / frameTime) + "\n", LogLevel::Test);
+		};
+		Log::Print("Draw recording : " + std::to_string(NB_RECORDED_OBJECTS) + " objects, " + std::to_string(RECORD_GRAIN) + " per list\n", LogLevel::Test);
+		print("  1 thread   : ", serial);
+
+		// The record, the sort and the instances scale with the workers, the submit stays on the caller
+		std::vector<unsigned int> nbWorkers = { 1, 2, 4, Core::JobSystem::GetDefaultNbWorkers() };
+		std::sort(nbWorkers.begin(), nbWorkers.end());
+		nbWorkers.erase(std::unique(nbWorkers.begin(), nbWorkers.end()), nbWorkers.end());
+		for (const unsigned int nb : nbWorkers)
+		{
+			Core::JobSystem::Start(nb);
+			const FrameTimes parallel = frame(true);
+			Core::JobSystem::Stop();
+
+			bool same = serialCommands.size() == queue.GetCommands().size();
+			for (size_t i = 0; same && i < serialCommands.size(); i++)
+				same = serialCommands[i].key == queue.GetCommands()[i].key && serialCommands[i].draw == queue.GetCommands()[i].draw;
+			print("  " + std::to_string(nb) + (nb > 1 ? " workers  : " : " worker   : "), parallel);
+			if (!same)
+				Log::Print("  different draws on " + std::to_string(nb) + " workers\n", LogLevel::Warning);
+		}
+	}
+}
\ No newline at end of file
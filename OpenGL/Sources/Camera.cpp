@@ -13,6 +13,7 @@ namespace LowRenderer
 		, GameObject("Camera", Physics::Transform(-5.f, 0.f, 0.f))
 	{
 		CalculateProjectionMatrix();
+		CalculateState();
 	}
 
 	void Camera::Update(const Core::Inputs& p_Inputs, const double p_deltaTime, const Physics::Transform& p_transformParent)
@@ -22,12 +23,7 @@ namespace LowRenderer
 		UpdateInputs(p_Inputs);
 
 		CalculateViewMatrix();
-	}
-
-	Core::Maths::Mat4& Camera::GetViewProjection()
-	{
-		Core::Maths::Mat4 vp = projectionMatrix.matrix * viewMatrix.matrix;
-		return vp;
+		CalculateState();
 	}
 
 	void Camera::UpdateInputs(const Core::Inputs& p_inputs)
@@ -81,7 +77,7 @@ namespace LowRenderer
 
 	void Camera::CalculateViewMatrix()
 	{
-		viewMatrix.matrix = LookAt(transform.translation, transform.translation + front, up);
+		state.view = LookAt(transform.translation, transform.translation + front, up);
 	}
 
 	void Camera::CalculateProjectionMatrix()
@@ -94,6 +90,19 @@ namespace LowRenderer
 			0.f,		0.f, -(far + near) / (far - near), -(2 * far * near) / (far - near),
 			0.f,		0.f, -1.f,						   0.f
 		);
-		projectionMatrix.matrix = projection;
+		state.projection = projection;
+	}
+
+	void Camera::CalculateState()
+	{
+		state.viewProjection = state.projection * state.view;
+		state.inverseViewProjection = state.viewProjection.GetInverse();
+		state.frustum = Frustum::FromViewProjection(state.viewProjection);
+		state.position = transform.translation;
+
+		state.near = near;
+		state.far = far;
+		state.fovY = FOV;
+		state.aspect = aspect;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include "FileCache.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "Log.hpp"
+#include "AssetPack.hpp"
+
+namespace Resources
+{
+	Core::SpinLock FileCache::filesLock;
+	std::unordered_map<std::string, std::shared_ptr<const std::string>> FileCache::files;
+	std::unordered_multimap<uint64_t, std::shared_ptr<const std::string>> FileCache::contents;
+	FileCacheStats FileCache::stats;
+	std::shared_ptr<const AssetPack> FileCache::pack;
+	std::unordered_set<std::string> FileCache::looseFiles;
+
+	std::shared_ptr<const std::string> FileCache::Read(const std::string& p_path)
+	{
+		const std::string path = Canonicalize(p_path);
+
+		{
+			Core::ScopedLock lock(filesLock);
+			auto it = files.find(path);
+			if (it != files.end())
+			{
+				stats.nbShared++;
+				stats.bytesSaved += it->second->size();
+				return it->second;
+			}
+		}
+
+		// Read outside of the lock, other workers can read their own files meanwhile
+		std::shared_ptr<const std::string> content = ReadFile(p_path, path);
+		if (!content)
+			return nullptr;
+
+		const uint64_t hash = Hash(content->data(), content->size());
+
+		Core::ScopedLock lock(filesLock);
+
+		// Another worker may have read the same path meanwhile
+		auto it = files.find(path);
+		if (it != files.end())
+		{
+			stats.nbShared++;
+			stats.bytesSaved += content->size();
+			return it->second;
+		}
+
+		// Same bytes under another path
+		auto range = contents.equal_range(hash);
+		for (auto same = range.first; same != range.second; same++)
+		{
+			if (*same->second == *content)
+			{
+				stats.nbShared++;
+				stats.bytesSaved += content->size();
+				files.insert_or_assign(path, same->second);
+				Core::Debug::Log::Print("File " + p_path + " share its content with an other file\n", Core::Debug::LogLevel::Notification);
+				return same->second;
+			}
+		}
+
+		files.insert_or_assign(path, content);
+		contents.emplace(hash, content);
+		return content;
+	}
+
+	std::shared_ptr<const std::string> FileCache::Load(const std::string& p_path)
+	{
+		return ReadFile(p_path, Canonicalize(p_path));
+	}
+
+	void FileCache::Invalidate(const std::string& p_path)
+	{
+		const std::string path = Canonicalize(p_path);
+
+		Core::ScopedLock lock(filesLock);
+		if (pack)
+			looseFiles.insert(path);
+
+		auto it = files.find(path);
+		if (it == files.end())
+			return;
+
+		auto range = contents.equal_range(Hash(it->second->data(), it->second->size()));
+		for (auto same = range.first; same != range.second; same++)
+		{
+			if (same->second == it->second)
+			{
+				contents.erase(same);
+				break;
+			}
+		}
+
+		// Other paths sharing this content keep it until they are invalidated too
+		files.erase(it);
+	}
+
+	void FileCache::Mount(const std::shared_ptr<const AssetPack>& p_pack)
+	{
+		std::unordered_set<std::string> staleFiles;
+		if (p_pack)
+		{
+			for (const std::string& path : p_pack->GetStaleFiles())
+				staleFiles.insert(Canonicalize(path));
+
+			if (!staleFiles.empty())
+				Core::Debug::Log::Print(std::to_string(staleFiles.size()) + " files are newer than the pack, they are read from the disk\n", Core::Debug::LogLevel::Warning);
+		}
+
+		Core::ScopedLock lock(filesLock);
+		pack = p_pack;
+		looseFiles = std::move(staleFiles);
+	}
+
+	void FileCache::Clear()
+	{
+		Core::ScopedLock lock(filesLock);
+		files.clear();
+		contents.clear();
+		stats = FileCacheStats();
+	}
+
+	size_t FileCache::GetSourceSize(const std::string& p_path)
+	{
+		const std::string path = Canonicalize(p_path);
+		std::shared_ptr<const AssetPack> mountedPack;
+		{
+			Core::ScopedLock lock(filesLock);
+			auto it = files.find(path);
+			if (it != files.end())
+				return it->second->size();
+
+			if (looseFiles.find(path) == looseFiles.end())
+				mountedPack = pack;
+		}
+
+		if (mountedPack)
+		{
+			if (const PackEntry* entry = mountedPack->Find(p_path))
+				return (size_t)entry->rawSize;
+		}
+
+		std::error_code error;
+		const uintmax_t size = std::filesystem::file_size(p_path, error);
+		return error ? 0 : (size_t)size;
+	}
+
+	std::string FileCache::Canonicalize(const std::string& p_path)
+	{
+		if (p_path.empty())
+			return p_path;
+
+		std::error_code error;
+		std::filesystem::path path = std::filesystem::weakly_canonical(p_path, error);
+		if (error)
+			path = std::filesystem::path(p_path).lexically_normal();
+
+		return path.generic_string();
+	}
+
+	uint64_t FileCache::Hash(const void* p_data, const size_t p_size)
+	{
+		// FNV-1a 64 bits
+		const unsigned char* data = static_cast<const unsigned char*>(p_data);
+		uint64_t hash = 14695981039346656037ull;
+
+		for (size_t i = 0; i < p_size; i++)
+		{
+			hash ^= data[i];
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	FileCacheStats FileCache::GetStats()
+	{
+		Core::ScopedLock lock(filesLock);
+		return stats;
+	}
+
+	std::shared_ptr<const std::string> FileCache::ReadFile(const std::string& p_path, const std::string& p_canonicalPath)
+	{
+		std::shared_ptr<const AssetPack> mountedPack;
+		{
+			Core::ScopedLock lock(filesLock);
+			if (looseFiles.find(p_canonicalPath) == looseFiles.end())
+				mountedPack = pack;
+		}
+
+		std::shared_ptr<const std::string> content = mountedPack ? mountedPack->Read(p_path) : nullptr;
+		if (!content)
+		{
+			std::ifstream file(p_path, std::ios::in | std::ios::binary);
+			if (!file.is_open())
+			{
+				Core::Debug::Log::Print("Fail to open file " + p_path + "\n", Core::Debug::LogLevel::Warning);
+				return nullptr;
+			}
+			std::stringstream buffer;
+			buffer << file.rdbuf();
+			file.close();
+			content = std::make_shared<const std::string>(buffer.str());
+			Core::Debug::Log::Print("Read file " + p_path + "\n", Core::Debug::LogLevel::Notification);
+		}
+
+		Core::ScopedLock lock(filesLock);
+		stats.nbRead++;
+		stats.bytesRead += content->size();
+		return content;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include "FileWatcher.hpp"
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "Log.hpp"
+
+namespace Core
+{
+#ifndef __linux__
+	const std::chrono::milliseconds SCAN_INTERVAL(500);
+#endif
+
+	FileWatcher::FileWatcher()
+		: root()
+		, isWatching(false)
+#ifdef __linux__
+		, inotify(-1)
+#endif
+	{
+	}
+
+	FileWatcher::~FileWatcher()
+	{
+#ifdef __linux__
+		if (inotify != -1)
+			close(inotify);
+#endif
+	}
+
+	bool FileWatcher::Init(const std::string& p_root)
+	{
+		root = p_root;
+
+		std::error_code error;
+		if (!std::filesystem::is_directory(root, error))
+		{
+			Debug::Log::Print("Can't watch " + root + ", it is not a directory\n", Debug::LogLevel::Warning);
+			return false;
+		}
+
+#ifdef __linux__
+		inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (inotify == -1)
+		{
+			Debug::Log::Print("Fail to init inotify\n", Debug::LogLevel::Warning);
+			return false;
+		}
+#else
+		lastScan = std::chrono::steady_clock::now();
+#endif
+
+		AddDirectory(root);
+		for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(root, error))
+		{
+			if (entry.is_directory())
+				AddDirectory(entry.path().generic_string());
+		}
+
+		isWatching = true;
+		Debug::Log::Print("Watch files in " + root + "\n", Debug::LogLevel::Notification);
+		return true;
+	}
+
+	std::vector<std::string> FileWatcher::Poll()
+	{
+		std::vector<std::string> modifiedFiles;
+		if (!isWatching)
+			return modifiedFiles;
+
+#ifdef __linux__
+		alignas(inotify_event) char buffer[4096];
+		ssize_t length;
+
+		while ((length = read(inotify, buffer, sizeof(buffer))) > 0)
+		{
+			for (char* ptr = buffer; ptr < buffer + length; ptr += sizeof(inotify_event) + ((inotify_event*)ptr)->len)
+			{
+				const inotify_event* event = (const inotify_event*)ptr;
+				if (event->len == 0)
+					continue;
+
+				const std::string path = directories[event->wd] + '/' + event->name;
+
+				if (event->mask & IN_ISDIR)
+				{
+					if (event->mask & (IN_CREATE | IN_MOVED_TO))
+						AddDirectory(path);
+					continue;
+				}
+
+				// Wait for the file to be fully written
+				if (!(event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)))
+					continue;
+
+				if (std::find(modifiedFiles.begin(), modifiedFiles.end(), path) == modifiedFiles.end())
+					modifiedFiles.push_back(path);
+			}
+		}
+#else
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if (now - lastScan < SCAN_INTERVAL)
+			return modifiedFiles;
+		lastScan = now;
+
+		std::error_code error;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(root, error))
+		{
+			if (!entry.is_regular_file())
+				continue;
+
+			const std::string path = entry.path().generic_string();
+			const std::filesystem::file_time_type writeTime = entry.last_write_time(error);
+
+			auto it = lastWriteTimes.find(path);
+			if (it == lastWriteTimes.end())
+				lastWriteTimes.emplace(path, writeTime);
+			else if (it->second != writeTime)
+			{
+				it->second = writeTime;
+				modifiedFiles.push_back(path);
+			}
+		}
+#endif
+
+		for (const std::string& path : modifiedFiles)
+			Debug::Log::Print("File modified " + path + "\n", Debug::LogLevel::Notification);
+
+		return modifiedFiles;
+	}
+
+	void FileWatcher::AddDirectory(const std::string& p_directory)
+	{
+#ifdef __linux__
+		const int watch = inotify_add_watch(inotify, p_directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+		if (watch == -1)
+		{
+			Debug::Log::Print("Fail to watch " + p_directory + "\n", Debug::LogLevel::Warning);
+			return;
+		}
+		directories[watch] = p_directory;
+#else
+		std::error_code error;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(p_directory, error))
+		{
+			if (entry.is_regular_file())
+				lastWriteTimes.emplace(entry.path().generic_string(), entry.last_write_time(error));
+		}
+#endif
+	}
+}
\ No newline at end of file
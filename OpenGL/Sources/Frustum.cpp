@@ -0,0 +1,153 @@
+#include "Frustum.hpp"
+
+#include <cmath>
+#include <immintrin.h>
+
+namespace LowRenderer
+{
+	Frustum Frustum::FromViewProjection(const Core::Maths::Mat4& p_viewProjection)
+	{
+		const float (&m)[4][4] = p_viewProjection.mat;
+		const float sides[6][2] = { { 0, 1.f }, { 0, -1.f }, { 1, 1.f }, { 1, -1.f }, { 2, 1.f }, { 2, -1.f } };
+
+		Frustum frustum;
+		for (unsigned int i = 0; i < 6; i++)
+		{
+			// Row 3 +- row of the axis, the clip coordinates are inside when -w <= c <= w
+			const unsigned int row = (unsigned int)sides[i][0];
+			const float sign = sides[i][1];
+			Plane& plane = frustum.planes[i];
+			plane.normal = Core::Maths::Vec3(m[3][0] + sign * m[row][0], m[3][1] + sign * m[row][1], m[3][2] + sign * m[row][2]);
+			plane.distance = m[3][3] + sign * m[row][3];
+
+			const float length = plane.normal.Magnitude();
+			if (length > 0.f)
+			{
+				plane.normal = plane.normal / length;
+				plane.distance /= length;
+			}
+		}
+
+		return frustum;
+	}
+
+	void BoundingSpheres::Clear()
+	{
+		x.clear();
+		y.clear();
+		z.clear();
+		radius.clear();
+	}
+
+	void BoundingSpheres::Reserve(const size_t p_size)
+	{
+		x.reserve(p_size);
+		y.reserve(p_size);
+		z.reserve(p_size);
+		radius.reserve(p_size);
+	}
+
+	void BoundingSpheres::Add(const Core::Maths::Vec3& p_center, const float p_radius)
+	{
+		x.push_back(p_center.x);
+		y.push_back(p_center.y);
+		z.push_back(p_center.z);
+		radius.push_back(p_radius);
+	}
+
+	void CullSpheresScalar(const Frustum& p_frustum, const BoundingSpheres& p_spheres, std::vector<unsigned int>& p_visible)
+	{
+		p_visible.clear();
+
+		for (size_t i = 0; i < p_spheres.Size(); i++)
+		{
+			bool inside = true;
+			for (const Plane& plane : p_frustum.planes)
+			{
+				const float distance = plane.normal.x * p_spheres.GetX()[i] + plane.normal.y * p_spheres.GetY()[i] + plane.normal.z * p_spheres.GetZ()[i] + plane.distance;
+				inside &= distance >= -p_spheres.GetRadius()[i];
+			}
+
+			if (inside)
+				p_visible.push_back((unsigned int)i);
+		}
+	}
+
+	void CullSpheres(const Frustum& p_frustum, const BoundingSpheres& p_spheres, std::vector<unsigned int>& p_visible)
+	{
+		p_visible.clear();
+		const size_t size = p_spheres.Size();
+		const float* x = p_spheres.GetX();
+		const float* y = p_spheres.GetY();
+		const float* z = p_spheres.GetZ();
+		const float* radius = p_spheres.GetRadius();
+		size_t i = 0;
+
+#ifdef __AVX__
+		// 8 spheres against each plane, same operations as the scalar reference
+		for (; i + 8 <= size; i += 8)
+		{
+			const __m256 centerX = _mm256_loadu_ps(x + i);
+			const __m256 centerY = _mm256_loadu_ps(y + i);
+			const __m256 centerZ = _mm256_loadu_ps(z + i);
+			const __m256 negativeRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(radius + i));
+			__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+			for (const Plane& plane : p_frustum.planes)
+			{
+				__m256 distance = _mm256_mul_ps(_mm256_set1_ps(plane.normal.x), centerX);
+				distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.normal.y), centerY));
+				distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.normal.z), centerZ));
+				distance = _mm256_add_ps(distance, _mm256_set1_ps(plane.distance));
+				inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negativeRadius, _CMP_GE_OQ));
+			}
+
+			const int mask = _mm256_movemask_ps(inside);
+			for (unsigned int lane = 0; mask && lane < 8; lane++)
+			{
+				if (mask & (1 << lane))
+					p_visible.push_back((unsigned int)(i + lane));
+			}
+		}
+#endif
+
+		for (; i + 4 <= size; i += 4)
+		{
+			const __m128 centerX = _mm_loadu_ps(x + i);
+			const __m128 centerY = _mm_loadu_ps(y + i);
+			const __m128 centerZ = _mm_loadu_ps(z + i);
+			const __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + i));
+			__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+			for (const Plane& plane : p_frustum.planes)
+			{
+				__m128 distance = _mm_mul_ps(_mm_set1_ps(plane.normal.x), centerX);
+				distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.normal.y), centerY));
+				distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.normal.z), centerZ));
+				distance = _mm_add_ps(distance, _mm_set1_ps(plane.distance));
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negativeRadius));
+			}
+
+			const int mask = _mm_movemask_ps(inside);
+			for (unsigned int lane = 0; mask && lane < 4; lane++)
+			{
+				if (mask & (1 << lane))
+					p_visible.push_back((unsigned int)(i + lane));
+			}
+		}
+
+		// Last spheres, fewer than a batch
+		for (; i < size; i++)
+		{
+			bool inside = true;
+			for (const Plane& plane : p_frustum.planes)
+			{
+				const float distance = plane.normal.x * x[i] + plane.normal.y * y[i] + plane.normal.z * z[i] + plane.distance;
+				inside &= distance >= -radius[i];
+			}
+
+			if (inside)
+				p_visible.push_back((unsigned int)i);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,441 @@
+#include "GLRecorder.hpp"
+
+#include <cstring>
+#include <sstream>
+#include <algorithm>
+#include <unordered_map>
+
+#include <glad/glad.h>
+
+namespace Core::Debug
+{
+	struct RecordedProgram
+	{
+		std::vector<GLuint> shaders;
+		std::vector<std::string> names; // As glGetActiveUniform reports them, "name[0]" for the arrays
+		std::vector<GLint> sizes;
+		std::unordered_map<std::string, int> locations;
+	};
+
+	static GLCalls calls;
+	static std::vector<std::string> uniformNames;		  // Given active uniforms of every program
+	static std::unordered_map<std::string, int> uniforms; // Given name -> location
+	static GLuint nextName = 1;
+	static std::unordered_map<GLuint, std::vector<std::string>> shaders;		 // Declared uniforms
+	static std::unordered_map<GLuint, RecordedProgram> programs;
+	static std::unordered_map<GLuint, size_t> buffers;						 // Bytes
+	static std::unordered_map<GLuint, std::vector<size_t>> textures;			 // Bytes of each level
+	static std::unordered_map<GLenum, GLuint> boundBuffers;
+	static std::vector<GLuint> indirectData; // Last upload to GL_DRAW_INDIRECT_BUFFER, read by the multi-draws
+	static GLuint boundTexture = 0;
+
+	static size_t GetTexelSize(const GLint p_format)
+	{
+		switch (p_format)
+		{
+		case GL_RED:
+		case GL_R8:
+			return 1;
+		case GL_RG:
+		case GL_RG8:
+			return 2;
+		case GL_RGB:
+		case GL_RGB8:
+		case GL_SRGB8:
+			return 3;
+		default:
+			return 4;
+		}
+	}
+
+	static void SetTextureLevel(const GLint p_level, const size_t p_size)
+	{
+		std::vector<size_t>& levels = textures[boundTexture];
+		if (levels.size() <= (size_t)p_level)
+			levels.resize((size_t)p_level + 1, 0);
+		levels[p_level] = p_size;
+	}
+
+	// Objects : the shaders compile and the programs link
+	static GLuint APIENTRY CreateShader(GLenum) { calls.other++; shaders[nextName]; return nextName++; }
+	static GLuint APIENTRY CreateProgram() { calls.other++; programs[nextName]; return nextName++; }
+	static void APIENTRY CompileShader(GLuint) { calls.other++; }
+	static void APIENTRY AttachShader(GLuint p_program, GLuint p_shader) { calls.other++; programs[p_program].shaders.push_back(p_shader); }
+	static void APIENTRY DeleteShader(GLuint p_shader) { calls.other++; shaders.erase(p_shader); }
+	static void APIENTRY DeleteProgram(GLuint p_program) { calls.other++; programs.erase(p_program); }
+	static void APIENTRY GetShaderiv(GLuint, GLenum p_name, GLint* p_params) { calls.other++; *p_params = p_name == GL_COMPILE_STATUS ? 1 : 0; }
+	static void APIENTRY GetInfoLog(GLuint, GLsizei, GLsizei* p_length, GLchar* p_log) { if (p_length) *p_length = 0; if (p_log) *p_log = '\0'; }
+	static void APIENTRY GetIntegerv(GLenum, GLint* p_data) { *p_data = 0; }
+
+	static void APIENTRY ShaderSource(GLuint p_shader, GLsizei p_count, const GLchar* const* p_strings, const GLint* p_lengths)
+	{
+		calls.other++;
+		std::string source;
+		for (GLsizei i = 0; i < p_count; i++)
+			source += p_lengths && p_lengths[i] >= 0 ? std::string(p_strings[i], (size_t)p_lengths[i]) : std::string(p_strings[i]);
+		shaders[p_shader] = GLRecorder::ParseUniforms(source);
+	}
+
+	static void APIENTRY LinkProgram(GLuint p_program)
+	{
+		calls.other++;
+		RecordedProgram& program = programs[p_program];
+		program.names.clear();
+		program.sizes.clear();
+		program.locations.clear();
+
+		int location = 0;
+		for (GLuint shader : program.shaders)
+		{
+			for (const std::string& declaration : shaders[shader])
+			{
+				// "name[size]" for the arrays
+				const size_t bracket = declaration.find('[');
+				const std::string name = declaration.substr(0, bracket);
+				const GLint size = bracket == std::string::npos ? 1 : std::max(std::atoi(declaration.c_str() + bracket + 1), 1);
+				if (program.locations.find(name) != program.locations.end())
+					continue;
+
+				program.names.push_back(bracket == std::string::npos ? name : name + "[0]");
+				program.sizes.push_back(size);
+				program.locations[name] = location;
+				for (GLint element = 0; bracket != std::string::npos && element < size; element++)
+					program.locations[name + '[' + std::to_string(element) + ']'] = location + element;
+				location += size;
+			}
+		}
+	}
+
+	static void APIENTRY GetProgramiv(GLuint p_program, GLenum p_name, GLint* p_params)
+	{
+		calls.other++;
+		switch (p_name)
+		{
+		case GL_ACTIVE_UNIFORMS:
+			*p_params = (GLint)GLRecorder::GetUniformNames(p_program).size();
+			break;
+		case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+			*p_params = 256;
+			break;
+		case GL_PROGRAM_BINARY_LENGTH:
+		case GL_INFO_LOG_LENGTH:
+			*p_params = 0;
+			break;
+		default:
+			*p_params = 1;
+			break;
+		}
+	}
+
+	static void APIENTRY GetActiveUniform(GLuint p_program, GLuint p_index, GLsizei p_bufSize, GLsizei* p_length, GLint* p_size, GLenum* p_type, GLchar* p_name)
+	{
+		calls.other++;
+		const std::string& name = GLRecorder::GetUniformNames(p_program)[p_index];
+		const GLsizei length = std::min((GLsizei)name.size(), p_bufSize - 1);
+		memcpy(p_name, name.data(), (size_t)length);
+		p_name[length] = '\0';
+		*p_length = length;
+		*p_size = uniformNames.empty() ? programs[p_program].sizes[p_index] : 1;
+		*p_type = GL_FLOAT;
+	}
+
+	static GLint APIENTRY FindUniformLocation(GLuint p_program, const GLchar* p_name) { return GLRecorder::GetUniformLocation(p_program, p_name); }
+	static GLuint APIENTRY GetUniformBlockIndex(GLuint, const GLchar*) { calls.other++; return 0; }
+	static void APIENTRY UniformBlockBinding(GLuint, GLuint, GLuint) { calls.other++; }
+
+	static void APIENTRY GenObjects(GLsizei p_nb, GLuint* p_objects) { calls.other++; for (GLsizei i = 0; i < p_nb; i++) p_objects[i] = nextName++; }
+	static void APIENTRY DeleteObjects(GLsizei, const GLuint*) { calls.other++; }
+
+	static void APIENTRY GenBuffers(GLsizei p_nb, GLuint* p_buffers)
+	{
+		GenObjects(p_nb, p_buffers);
+		for (GLsizei i = 0; i < p_nb; i++)
+			buffers[p_buffers[i]] = 0;
+	}
+
+	static void APIENTRY DeleteBuffers(GLsizei p_nb, const GLuint* p_buffers)
+	{
+		calls.other++;
+		for (GLsizei i = 0; i < p_nb; i++)
+			buffers.erase(p_buffers[i]);
+	}
+
+	static void APIENTRY GenTextures(GLsizei p_nb, GLuint* p_textures)
+	{
+		GenObjects(p_nb, p_textures);
+		for (GLsizei i = 0; i < p_nb; i++)
+			textures[p_textures[i]];
+	}
+
+	static void APIENTRY DeleteTextures(GLsizei p_nb, const GLuint* p_textures)
+	{
+		calls.other++;
+		for (GLsizei i = 0; i < p_nb; i++)
+			textures.erase(p_textures[i]);
+	}
+
+	// Uploads
+	static void APIENTRY BindBuffer(GLenum p_target, GLuint p_buffer) { calls.stateChange++; boundBuffers[p_target] = p_buffer; }
+	static void APIENTRY BindBufferBase(GLenum p_target, GLuint, GLuint p_buffer) { calls.stateChange++; boundBuffers[p_target] = p_buffer; }
+	static void APIENTRY BufferData(GLenum p_target, GLsizeiptr p_size, const void* p_data, GLenum)
+	{
+		calls.bufferUpload++;
+		buffers[boundBuffers[p_target]] = (size_t)p_size;
+		if (p_target == GL_DRAW_INDIRECT_BUFFER)
+		{
+			indirectData.assign((size_t)p_size / sizeof(GLuint), 0);
+			if (p_data)
+				memcpy(indirectData.data(), p_data, indirectData.size() * sizeof(GLuint));
+		}
+	}
+
+	static void APIENTRY BufferSubData(GLenum, GLintptr, GLsizeiptr, const void*) { calls.bufferUpload++; }
+	static void APIENTRY CopyBufferSubData(GLenum, GLenum, GLintptr, GLintptr, GLsizeiptr) { calls.bufferUpload++; }
+	static void APIENTRY BindTexture(GLenum, GLuint p_texture) { calls.bindTexture++; boundTexture = p_texture; }
+
+	static void APIENTRY TexImage2D(GLenum, GLint p_level, GLint p_format, GLsizei p_width, GLsizei p_height, GLint, GLenum, GLenum, const void*)
+	{
+		calls.textureUpload++;
+		SetTextureLevel(p_level, (size_t)p_width * p_height * GetTexelSize(p_format));
+	}
+
+	static void APIENTRY CompressedTexImage2D(GLenum, GLint p_level, GLenum, GLsizei, GLsizei, GLint, GLsizei p_size, const void*)
+	{
+		calls.textureUpload++;
+		SetTextureLevel(p_level, (size_t)p_size);
+	}
+
+	static void APIENTRY TexBuffer(GLenum, GLenum, GLuint) { calls.stateChange++; }
+	static void APIENTRY TexSubImage2D(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, const void*) { calls.textureUpload++; }
+
+	// States
+	static void APIENTRY Enable(GLenum) { calls.stateChange++; }
+	static void APIENTRY Clear(GLbitfield) { calls.stateChange++; }
+	static void APIENTRY ClearColor(GLfloat, GLfloat, GLfloat, GLfloat) { calls.stateChange++; }
+	static void APIENTRY PolygonMode(GLenum, GLenum) { calls.stateChange++; }
+	static void APIENTRY Viewport(GLint, GLint, GLsizei, GLsizei) { calls.stateChange++; }
+	static void APIENTRY PixelStorei(GLenum, GLint) { calls.stateChange++; }
+	static void APIENTRY TexParameteri(GLenum, GLenum, GLint) { calls.stateChange++; }
+	static void APIENTRY SamplerParameteri(GLuint, GLenum, GLint) { calls.stateChange++; }
+	static void APIENTRY SamplerParameterf(GLuint, GLenum, GLfloat) { calls.stateChange++; }
+	static void APIENTRY VertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) { calls.stateChange++; }
+	static void APIENTRY EnableVertexAttribArray(GLuint) { calls.stateChange++; }
+	static void APIENTRY VertexAttribDivisor(GLuint, GLuint) { calls.stateChange++; }
+
+	// Draw path
+	static void APIENTRY UseProgram(GLuint) { calls.useProgram++; }
+	static void APIENTRY Uniform1i(GLint, GLint) { calls.uniform++; }
+	static void APIENTRY ProgramUniform1i(GLuint, GLint, GLint) { calls.uniform++; }
+	static void APIENTRY Uniform1f(GLint, GLfloat) { calls.uniform++; }
+	static void APIENTRY Uniform3f(GLint, GLfloat, GLfloat, GLfloat) { calls.uniform++; }
+	static void APIENTRY Uniform4f(GLint, GLfloat, GLfloat, GLfloat, GLfloat) { calls.uniform++; }
+	static void APIENTRY UniformMatrix3fv(GLint, GLsizei, GLboolean, const GLfloat*) { calls.uniform++; }
+	static void APIENTRY UniformMatrix4fv(GLint, GLsizei, GLboolean, const GLfloat*) { calls.uniform++; }
+	static void APIENTRY BindTextureUnit(GLuint, GLuint) { calls.bindTexture++; }
+	static void APIENTRY BindSampler(GLuint, GLuint) { calls.bindTexture++; }
+	static void APIENTRY BindVertexArray(GLuint) { calls.bindVertexArray++; }
+	static void APIENTRY DrawElements(GLenum, GLsizei p_count, GLenum, const void*) { calls.draw++; calls.indices += (size_t)p_count; }
+	static void APIENTRY DrawElementsInstanced(GLenum, GLsizei p_count, GLenum, const void*, GLsizei p_nbInstances) { calls.draw++; calls.indices += (size_t)p_count * p_nbInstances; }
+
+	static void APIENTRY MultiDrawElementsIndirect(GLenum, GLenum, const void* p_offset, GLsizei p_nbCommands, GLsizei p_stride)
+	{
+		// Commands of 5 integers : count, instanceCount, firstIndex, baseVertex, baseInstance
+		calls.draw++;
+		const size_t stride = p_stride ? (size_t)p_stride / sizeof(GLuint) : 5;
+		for (size_t command = (size_t)p_offset / sizeof(GLuint), i = 0; i < (size_t)p_nbCommands && command + 1 < indirectData.size(); command += stride, i++)
+			calls.indices += (size_t)indirectData[command] * indirectData[command + 1];
+	}
+
+	GLRecorder::GLRecorder(const std::vector<std::string>& p_uniforms)
+	{
+		uniformNames = p_uniforms;
+		uniforms.clear();
+		for (unsigned int i = 0; i < uniformNames.size(); i++)
+			uniforms[uniformNames[i]] = (int)i;
+		Reset();
+
+		Replace(glad_glCreateShader, &CreateShader);
+		Replace(glad_glShaderSource, &ShaderSource);
+		Replace(glad_glCompileShader, &CompileShader);
+		Replace(glad_glGetShaderiv, &GetShaderiv);
+		Replace(glad_glGetShaderInfoLog, &GetInfoLog);
+		Replace(glad_glCreateProgram, &CreateProgram);
+		Replace(glad_glAttachShader, &AttachShader);
+		Replace(glad_glLinkProgram, &LinkProgram);
+		Replace(glad_glGetProgramiv, &GetProgramiv);
+		Replace(glad_glGetProgramInfoLog, &GetInfoLog);
+		Replace(glad_glGetActiveUniform, &GetActiveUniform);
+		Replace(glad_glGetUniformLocation, &FindUniformLocation);
+		Replace(glad_glGetUniformBlockIndex, &GetUniformBlockIndex);
+		Replace(glad_glUniformBlockBinding, &UniformBlockBinding);
+		Replace(glad_glGetIntegerv, &GetIntegerv);
+		Replace(glad_glGenBuffers, &GenBuffers);
+		Replace(glad_glGenTextures, &GenTextures);
+		Replace(glad_glGenSamplers, &GenObjects);
+		Replace(glad_glGenVertexArrays, &GenObjects);
+		Replace(glad_glDeleteShader, &DeleteShader);
+		Replace(glad_glDeleteProgram, &DeleteProgram);
+		Replace(glad_glDeleteTextures, &DeleteTextures);
+		Replace(glad_glDeleteSamplers, &DeleteObjects);
+		Replace(glad_glDeleteVertexArrays, &DeleteObjects);
+		Replace(glad_glDeleteBuffers, &DeleteBuffers);
+
+		Replace(glad_glBindBuffer, &BindBuffer);
+		Replace(glad_glBindBufferBase, &BindBufferBase);
+		Replace(glad_glBufferData, &BufferData);
+		Replace(glad_glBufferSubData, &BufferSubData);
+		Replace(glad_glCopyBufferSubData, &CopyBufferSubData);
+		Replace(glad_glBindTexture, &BindTexture);
+		Replace(glad_glTexImage2D, &TexImage2D);
+		Replace(glad_glCompressedTexImage2D, &CompressedTexImage2D);
+		Replace(glad_glTexSubImage2D, &TexSubImage2D);
+		Replace(glad_glTexBuffer, &TexBuffer);
+
+		Replace(glad_glEnable, &Enable);
+		Replace(glad_glClear, &Clear);
+		Replace(glad_glClearColor, &ClearColor);
+		Replace(glad_glPolygonMode, &PolygonMode);
+		Replace(glad_glViewport, &Viewport);
+		Replace(glad_glPixelStorei, &PixelStorei);
+		Replace(glad_glTexParameteri, &TexParameteri);
+		Replace(glad_glSamplerParameteri, &SamplerParameteri);
+		Replace(glad_glSamplerParameterf, &SamplerParameterf);
+		Replace(glad_glVertexAttribPointer, &VertexAttribPointer);
+		Replace(glad_glEnableVertexAttribArray, &EnableVertexAttribArray);
+		Replace(glad_glVertexAttribDivisor, &VertexAttribDivisor);
+
+		Replace(glad_glUseProgram, &UseProgram);
+		Replace(glad_glUniform1i, &Uniform1i);
+		Replace(glad_glProgramUniform1i, &ProgramUniform1i);
+		Replace(glad_glUniform1f, &Uniform1f);
+		Replace(glad_glUniform3f, &Uniform3f);
+		Replace(glad_glUniform4f, &Uniform4f);
+		Replace(glad_glUniformMatrix3fv, &UniformMatrix3fv);
+		Replace(glad_glUniformMatrix4fv, &UniformMatrix4fv);
+		Replace(glad_glBindTextureUnit, &BindTextureUnit);
+		Replace(glad_glBindSampler, &BindSampler);
+		Replace(glad_glBindVertexArray, &BindVertexArray);
+		Replace(glad_glDrawElements, &DrawElements);
+		Replace(glad_glDrawElementsInstanced, &DrawElementsInstanced);
+		Replace(glad_glMultiDrawElementsIndirect, &MultiDrawElementsIndirect);
+	}
+
+	GLRecorder::~GLRecorder()
+	{
+		for (const std::function<void()>& function : restore)
+			function();
+
+		shaders.clear();
+		programs.clear();
+		buffers.clear();
+		textures.clear();
+		boundBuffers.clear();
+		indirectData.clear();
+		boundTexture = 0;
+	}
+
+	void GLRecorder::Reset()
+	{
+		calls = GLCalls();
+	}
+
+	const GLCalls& GLRecorder::GetCalls()
+	{
+		return calls;
+	}
+
+	GLMemory GLRecorder::GetMemory()
+	{
+		GLMemory memory;
+		memory.nbBuffers = (unsigned int)buffers.size();
+		memory.nbTextures = (unsigned int)textures.size();
+		memory.nbPrograms = (unsigned int)programs.size();
+
+		for (const auto& [buffer, size] : buffers)
+			memory.bufferBytes += size;
+		for (const auto& [texture, levels] : textures)
+		{
+			for (const size_t size : levels)
+				memory.textureBytes += size;
+		}
+
+		return memory;
+	}
+
+	const std::vector<std::string>& GLRecorder::GetUniformNames(const unsigned int p_program)
+	{
+		if (!uniformNames.empty())
+			return uniformNames;
+
+		return programs[p_program].names;
+	}
+
+	int GLRecorder::GetUniformLocation(const unsigned int p_program, const std::string& p_name)
+	{
+		calls.getUniformLocation++;
+
+		// Like the driver, a lookup by name
+		const std::unordered_map<std::string, int>& locations = uniformNames.empty() ? programs[p_program].locations : uniforms;
+		auto it = locations.find(p_name);
+		return it != locations.end() ? it->second : -1;
+	}
+
+	std::vector<std::string> GLRecorder::ParseUniforms(const std::string& p_source)
+	{
+		std::unordered_map<std::string, std::string> defines;
+		std::vector<std::string> declarations;
+
+		// Words of the source without the comments, the directives are read line by line
+		std::vector<std::string> words;
+		std::istringstream lines(p_source);
+		std::string line;
+		while (std::getline(lines, line))
+		{
+			line = line.substr(0, line.find("//"));
+			std::istringstream lineWords(line);
+			std::string word;
+			if (line.find('#') != std::string::npos)
+			{
+				std::string directive, name, value;
+				lineWords >> directive >> name >> value;
+				if (directive == "#define")
+					defines[name] = value;
+				continue;
+			}
+
+			// Punctuation as separate words
+			for (const char separator : { ';', '{', '}', '[', ']' })
+			{
+				for (size_t position = line.find(separator); position != std::string::npos; position = line.find(separator, position + 2))
+					line.replace(position, 1, std::string(" ") + separator + " ");
+			}
+			lineWords = std::istringstream(line);
+			while (lineWords >> word)
+				words.push_back(word);
+		}
+
+		for (size_t i = 0; i + 2 < words.size(); i++)
+		{
+			if (words[i] != "uniform")
+				continue;
+
+			// Block : its members have no location
+			if (words[i + 2] == "{")
+			{
+				while (i < words.size() && words[i] != "}")
+					i++;
+				continue;
+			}
+
+			std::string declaration = words[i + 2];
+			if (i + 5 < words.size() && words[i + 3] == "[")
+			{
+				auto define = defines.find(words[i + 4]);
+				declaration += '[' + (define != defines.end() ? define->second : words[i + 4]) + ']';
+			}
+			declarations.push_back(declaration);
+		}
+
+		return declarations;
+	}
+}
\ No newline at end of file
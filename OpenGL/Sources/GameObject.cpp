@@ -1,11 +1,14 @@
 #include "GameObject.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
-#include "Imgui/imgui.h"
-#include "Imgui/imgui_impl_glfw.h"
-#include "Imgui/imgui_impl_opengl3.h"
+#include "ImGUI/imgui.h"
+#include "ImGUI/imgui_impl_glfw.h"
+#include "ImGUI/imgui_impl_opengl3.h"
 
 #include "Assertion.hpp"
 
@@ -18,8 +21,10 @@ namespace LowRenderer
 		, playerControler()
 		, transform(p_transform)
 		, name(p_name)
-		, collider(nullptr)
 		, rigidbody( &transform,false)
+		, collider(nullptr)
+		, occluder(false)
+		, isStatic(false)
 	{
 	}
 
@@ -28,8 +33,10 @@ namespace LowRenderer
 		, playerControler()
 		, transform (p_transform)
 		, name		(p_name)
-		, collider(nullptr)
 		, rigidbody( &transform, false)
+		, collider(nullptr)
+		, occluder(false)
+		, isStatic(false)
 	{
 	}
 
@@ -37,8 +44,10 @@ namespace LowRenderer
 		: model(p_gameObject.model)
 		, transform(p_gameObject.transform)
 		, name(p_gameObject.name)
-		, collider(nullptr)
 		, rigidbody( &transform, false)
+		, collider(nullptr)
+		, occluder(p_gameObject.occluder)
+		, isStatic(p_gameObject.isStatic)
 	{
 	}
 
@@ -47,24 +56,33 @@ namespace LowRenderer
 		if (playerControler.isEnable)
 			playerControler.Update(p_Inputs, rigidbody, *collider,transform.translation,p_deltaTime);
 
-		transform.matrix = p_transformParent.matrix * transform.GetLocalTransform();
+		transform.SetMatrix(p_transformParent.matrix * transform.GetLocalTransform());
 	}
 
-	void GameObject::Draw(Core::Maths::Mat4& p_vp, Core::Maths::Vec3 p_camPos, LightManager& p_lightManager, Core::Maths::Mat4 p_transformParent)
+	void GameObject::Draw(const Core::Maths::Mat4& p_vp, RenderList& p_list)
 	{
 		if (model.isEnable)
-		{
-			const int shaderProgram = GetShaderProgram();
-			glUseProgram(shaderProgram);
-
-			p_lightManager.Draw(shaderProgram, p_camPos);
-
-			model.Draw(transform.matrix, (p_vp * transform.matrix));
-		}
+			p_list.Add(model, transform.matrix, transform.normalMatrix, p_vp * transform.matrix);
 
 		//DrawImGui();
 	}
 
+	bool GameObject::GetBoundingSphere(Core::Maths::Vec3& p_center, float& p_radius) const
+	{
+		if (!model.isEnable)
+			return false;
+
+		// Sphere of the mesh around its origin, scaled by the largest axis of the transform
+		const float (&m)[4][4] = transform.matrix.mat;
+		float scale = 0.f;
+		for (unsigned int column = 0; column < 3; column++)
+			scale = std::max(scale, m[0][column] * m[0][column] + m[1][column] * m[1][column] + m[2][column] * m[2][column]);
+
+		p_center = Core::Maths::Vec3(m[0][3], m[1][3], m[2][3]);
+		p_radius = model.GetMesh()->GetRadius() * std::sqrt(scale);
+		return true;
+	}
+
 	void GameObject::Translate(const Core::Maths::Vec3& p_translation)
 	{
 		transform.translation += p_translation;
@@ -1,10 +1,11 @@
 #include "Graph.hpp"
 
-#include "Imgui/imgui.h"
-#include "Imgui/imgui_impl_glfw.h"
-#include "Imgui/imgui_impl_opengl3.h"
+#include "ImGUI/imgui.h"
+#include "ImGUI/imgui_impl_glfw.h"
+#include "ImGUI/imgui_impl_opengl3.h"
 
 #include "Log.hpp"
+#include "JobSystem.hpp"
 
 namespace Core::DataStructure
 {
@@ -33,18 +34,31 @@ namespace Core::DataStructure
 		}
 	}
 
-	void Graph::Draw(LowRenderer::Camera& p_camera, LowRenderer::LightManager& p_lightManager)
+	void Graph::Draw(const LowRenderer::CameraState& p_camera, LowRenderer::RenderQueue& p_queue)
 	{
+		drawables.clear();
+		spheres.Clear();
 		for (unsigned int i = 0; i < nodes.size(); i++)
 		{
 			if (ParentCheck(i) || !InitCheck(i))
 				continue;
-			
-			GetGameObject(i)->Draw(p_camera.GetViewProjection(), p_camera.GetTranslation(), p_lightManager);
 
-			for (unsigned int j = 0; j < GetNode(i).childsIndex.size(); j++)
-				DrawChild(p_camera, p_lightManager, GetNode(GetNode(i).childsIndex[j]));
+			AddDrawable(GetNode(i));
 		}
+
+		LowRenderer::CullSpheres(p_camera.frustum, spheres, visible);
+
+		CullOccluded(p_camera.viewProjection);
+
+		// Matrices and keys of the draws on the workers, the queue is submitted on the OpenGL thread
+		p_queue.Record((unsigned int)visible.size(), 512, [this, &p_camera](unsigned int p_begin, unsigned int p_end, LowRenderer::RenderList& p_list)
+		{
+			for (unsigned int i = p_begin; i < p_end; i++)
+			{
+				if (!occluded[i])
+					drawables[visible[i]]->Draw(p_camera.viewProjection, p_list);
+			}
+		});
 	}
 
 	void Graph::AddNode(int p_index)
@@ -99,12 +113,55 @@ namespace Core::DataStructure
 			UpdateChild(GetNode(p_child.childsIndex[i]), p_Inputs,p_deltaTime);
 	}
 
-	void Graph::DrawChild(LowRenderer::Camera& p_camera, LowRenderer::LightManager& p_lightManager, const GraphNode& p_child)
+	void Graph::AddDrawable(const GraphNode& p_node)
 	{
-		GetGameObject(p_child.indexGameObject)->Draw(p_camera.GetViewProjection(), p_camera.GetTranslation(), p_lightManager, GetMatrixModelParent(p_child));
+		LowRenderer::GameObject* gameObject = GetGameObject(p_node.indexGameObject);
+		Core::Maths::Vec3 center;
+		float radius;
+		if (gameObject->GetBoundingSphere(center, radius))
+		{
+			drawables.push_back(gameObject);
+			spheres.Add(center, radius);
+		}
 
-		for (unsigned int i = 0; i < p_child.childsIndex.size(); i++)
-			DrawChild(p_camera, p_lightManager, GetNode(p_child.childsIndex[i]));
+		for (unsigned int i = 0; i < p_node.childsIndex.size(); i++)
+			AddDrawable(GetNode(p_node.childsIndex[i]));
+	}
+
+	void Graph::CullOccluded(const Core::Maths::Mat4& p_viewProjection)
+	{
+		occluded.assign(visible.size(), false);
+
+		occlusion.Clear();
+		for (const unsigned int index : visible)
+		{
+			const LowRenderer::GameObject* gameObject = drawables[index];
+			if (gameObject->IsOccluder())
+			{
+				const Resources::Mesh* mesh = gameObject->GetModel().GetMesh();
+				occlusion.AddOccluder(mesh->GetVertexBuffer(), mesh->GetIndexBuffer(), p_viewProjection * gameObject->GetModelMatrix());
+			}
+		}
+
+		if (occlusion.GetNbTriangles() == 0)
+			return;
+
+		occlusion.Rasterize();
+		occlusion.BuildPyramid();
+
+		// The occluders are drawn, they are the ones hiding the others
+		Core::JobSystem::ParallelFor((unsigned int)visible.size(), 256, [this, &p_viewProjection](unsigned int p_begin, unsigned int p_end)
+		{
+			for (unsigned int i = p_begin; i < p_end; i++)
+			{
+				const unsigned int index = visible[i];
+				if (drawables[index]->IsOccluder())
+					continue;
+
+				const Core::Maths::Vec3 center(spheres.GetX()[index], spheres.GetY()[index], spheres.GetZ()[index]);
+				occluded[i] = occlusion.IsOccluded(center, spheres.GetRadius()[index], p_viewProjection);
+			}
+		});
 	}
 
 	bool Graph::ParentCheck(const unsigned int p_index) const
@@ -122,11 +179,6 @@ namespace Core::DataStructure
 		return false;
 	}
 
-	Core::Maths::Mat4& Graph::GetMatrixModelParent(const GraphNode& p_childs)
-	{
-		return GetGameObject(GetNode(p_childs.parentIndex).indexGameObject)->GetModelMatrix();
-	}
-
 	GraphNode& Graph::GetNode(const unsigned int p_index)
 	{
 		return nodes[p_index];
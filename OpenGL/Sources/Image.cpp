@@ -0,0 +1,76 @@
+#include "Image.hpp"
+
+#include <utility>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <STB_Image/stb_image.h>
+
+#include "Log.hpp"
+
+namespace Resources
+{
+	Image::Image()
+		: data(nullptr)
+		, width(0)
+		, height(0)
+		, nrChannels(0)
+	{
+	}
+
+	Image::~Image()
+	{
+		Free();
+	}
+
+	Image::Image(Image&& p_other) noexcept
+		: data(std::exchange(p_other.data, nullptr))
+		, width(std::exchange(p_other.width, 0))
+		, height(std::exchange(p_other.height, 0))
+		, nrChannels(std::exchange(p_other.nrChannels, 0))
+	{
+	}
+
+	Image& Image::operator=(Image&& p_other) noexcept
+	{
+		if (this != &p_other)
+		{
+			Free();
+			data = std::exchange(p_other.data, nullptr);
+			width = std::exchange(p_other.width, 0);
+			height = std::exchange(p_other.height, 0);
+			nrChannels = std::exchange(p_other.nrChannels, 0);
+		}
+		return *this;
+	}
+
+	bool Image::Decode(const void* p_buffer, const size_t p_size, const bool p_flipVertically, const int p_desiredChannels)
+	{
+		Free();
+
+		// The thread local flag overrides stbi_set_flip_vertically_on_load, only for this worker
+		stbi_set_flip_vertically_on_load_thread(p_flipVertically);
+
+		int fileChannels = 0;
+		data = stbi_load_from_memory(static_cast<const stbi_uc*>(p_buffer), (int)p_size, &width, &height, &fileChannels, p_desiredChannels);
+		if (!data)
+		{
+			Core::Debug::Log::Print(std::string("Fail to decode image : ") + stbi_failure_reason() + "\n", Core::Debug::LogLevel::Warning);
+			width = height = 0;
+			return false;
+		}
+
+		nrChannels = p_desiredChannels ? p_desiredChannels : fileChannels;
+		return true;
+	}
+
+	void Image::Free()
+	{
+		if (data)
+			stbi_image_free(data);
+
+		data = nullptr;
+		width = 0;
+		height = 0;
+		nrChannels = 0;
+	}
+}
\ No newline at end of file
@@ -132,7 +132,7 @@ namespace Core::Editor
 				ShowTransform(itemTransform, "Local Tranform", "Local ");
 				ImGui::Spacing();
 				ImGui::Separator();
-				itemTransform->matrix = itemTransform->GetLocalTransform();
+				itemTransform->SetMatrix(itemTransform->GetLocalTransform());
 			}
 
 			if (m_GoSelected->GetCollider() != nullptr)
@@ -0,0 +1,135 @@
+#include "JobSystem.hpp"
+
+#include <memory>
+#include <algorithm>
+#include <chrono>
+
+#include "Log.hpp"
+
+namespace Core
+{
+	std::vector<std::thread> JobSystem::workers;
+	SpinLock JobSystem::jobsLock;
+	std::deque<std::function<void()>> JobSystem::jobs;
+	std::atomic<unsigned int> JobSystem::nbJobs = 0;
+	std::atomic<bool> JobSystem::running = false;
+
+	// Shared with the workers : a worker may take its job after the loop returned, it then finds no chunk left
+	struct ParallelForState
+	{
+		std::atomic<unsigned int> nextChunk = 0;
+		std::atomic<unsigned int> nbDone = 0;
+		unsigned int nbChunks = 0;
+		unsigned int count = 0;
+		unsigned int grain = 0;
+		const std::function<void(unsigned int, unsigned int)>* function = nullptr;
+
+		void RunChunks()
+		{
+			for (unsigned int chunk = nextChunk++; chunk < nbChunks; chunk = nextChunk++)
+			{
+				const unsigned int begin = chunk * grain;
+				(*function)(begin, std::min(begin + grain, count));
+				nbDone++;
+			}
+		}
+	};
+
+	void JobSystem::Start(const unsigned int p_nbWorkers)
+	{
+		if (running)
+			return;
+
+		running = true;
+		for (unsigned int i = 0; i < p_nbWorkers; i++)
+			workers.push_back(std::thread(&JobSystem::Run));
+
+		Core::Debug::Log::Print("Job system : " + std::to_string(p_nbWorkers) + " workers\n", Core::Debug::LogLevel::Notification);
+	}
+
+	void JobSystem::Stop()
+	{
+		running = false;
+
+		for (std::thread& worker : workers)
+			worker.join();
+		workers.clear();
+	}
+
+	void JobSystem::ParallelFor(const unsigned int p_count, const unsigned int p_grain, const std::function<void(unsigned int, unsigned int)>& p_function)
+	{
+		const unsigned int grain = std::max(p_grain, 1u);
+		const unsigned int nbChunks = (p_count + grain - 1) / grain;
+		if (nbChunks == 0)
+			return;
+
+		if (nbChunks == 1 || workers.empty())
+		{
+			for (unsigned int begin = 0; begin < p_count; begin += grain)
+				p_function(begin, std::min(begin + grain, p_count));
+			return;
+		}
+
+		std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>();
+		state->nbChunks = nbChunks;
+		state->count = p_count;
+		state->grain = grain;
+		state->function = &p_function;
+
+		// The caller takes one of the chunks
+		const unsigned int nbHelpers = std::min((unsigned int)workers.size(), nbChunks - 1);
+		{
+			ScopedLock lock(jobsLock);
+			for (unsigned int i = 0; i < nbHelpers; i++)
+				jobs.push_back([state]() { state->RunChunks(); });
+			nbJobs += nbHelpers;
+		}
+
+		state->RunChunks();
+
+		// Only the chunks already taken by the workers are left
+		while (state->nbDone != state->nbChunks)
+			std::this_thread::yield();
+	}
+
+	unsigned int JobSystem::GetDefaultNbWorkers()
+	{
+		return std::max(std::thread::hardware_concurrency(), 2u) - 1;
+	}
+
+	void JobSystem::Run()
+	{
+		std::chrono::steady_clock::time_point idleStart = std::chrono::steady_clock::now();
+
+		while (true)
+		{
+			std::function<void()> job;
+			if (nbJobs != 0)
+			{
+				ScopedLock lock(jobsLock);
+				if (!jobs.empty())
+				{
+					job = std::move(jobs.front());
+					jobs.pop_front();
+					nbJobs--;
+				}
+			}
+
+			if (job)
+			{
+				job();
+				idleStart = std::chrono::steady_clock::now();
+				continue;
+			}
+
+			// The queued jobs are run before stopping
+			if (!running)
+				return;
+
+			if (std::chrono::steady_clock::now() - idleStart < std::chrono::microseconds(JOB_SPIN_MICROSECONDS))
+				std::this_thread::yield();
+			else
+				std::this_thread::sleep_for(std::chrono::microseconds(JOB_SLEEP_MICROSECONDS));
+		}
+	}
+}
\ No newline at end of file
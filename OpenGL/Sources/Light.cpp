@@ -1,9 +1,10 @@
 #include "Light.hpp"
 
-#include <GLFW/glfw3.h>
-#include <glad/glad.h>
+#include <cmath>
+#include <limits>
+#include <algorithm>
 
-#include <string>
+#include "UniformBlock.hpp"
 
 namespace LowRenderer
 {
@@ -11,15 +12,31 @@ namespace LowRenderer
 	//        Light
 	// --------------------
 
-	void Light::Update(const int p_shaderProgram, const Core::Maths::Vec3& p_camPosition, std::string& p_array)
+	void Light::Pack(UniformBlock& p_block) const
 	{
-		p_array += "lightData.";
+		p_block.BeginStruct();
+		p_block.AddVec3(position);
+		p_block.AddVec4(ambientColor);
+		p_block.AddVec4(diffuseColor);
+		p_block.AddVec4(specularColor);
+		p_block.EndStruct();
+	}
 
-		glUniform4f(glGetUniformLocation(p_shaderProgram, (p_array + "ambientColor").c_str()), ambientColor.x, ambientColor.y, ambientColor.z, ambientColor.w);
-		glUniform4f(glGetUniformLocation(p_shaderProgram, (p_array + "diffuseColor").c_str()), diffuseColor.x, diffuseColor.y, diffuseColor.z, diffuseColor.w);
-		glUniform4f(glGetUniformLocation(p_shaderProgram, (p_array + "specularColor").c_str()), specularColor.x, specularColor.y, specularColor.z, specularColor.w);
-		glUniform3f(glGetUniformLocation(p_shaderProgram, (p_array + "lightPos").c_str()), position.x, position.y, position.z);
-		glUniform3f(glGetUniformLocation(p_shaderProgram, (p_array + "viewPos").c_str()), p_camPosition.x, p_camPosition.y, p_camPosition.z);
+	void Light::Pack(std::vector<Core::Maths::Vec4>& p_texels, const float p_w) const
+	{
+		p_texels.push_back(Core::Maths::Vec4(position, p_w));
+		p_texels.push_back(ambientColor);
+		p_texels.push_back(diffuseColor);
+		p_texels.push_back(specularColor);
+	}
+
+	float Light::GetIntensity() const
+	{
+		float intensity = 0.f;
+		for (const Core::Maths::Vec4* color : { &ambientColor, &diffuseColor, &specularColor })
+			intensity = std::max({ intensity, color->x, color->y, color->z });
+
+		return intensity;
 	}
 
 	// --------------------
@@ -35,13 +52,12 @@ namespace LowRenderer
 		position = p_initLight.position;
 	}
 
-	void DirectionLight::Update(const int p_shaderProgram, const Core::Maths::Vec3& p_camPosition, const unsigned int p_index)
+	void DirectionLight::Pack(UniformBlock& p_block) const
 	{
-		std::string array = "directionLights[" + std::to_string(p_index) + "].";
-
-		glUniform3f(glGetUniformLocation(p_shaderProgram, (array + "direction").c_str()), direction.x, direction.y, direction.z);
-
-		Light::Update(p_shaderProgram, p_camPosition, array);
+		p_block.BeginStruct();
+		Light::Pack(p_block);
+		p_block.AddVec3(direction);
+		p_block.EndStruct();
 	}
 
 	// --------------------
@@ -59,15 +75,35 @@ namespace LowRenderer
 		position = p_initLight.position;
 	}
 
-	void PointLight::Update(const int p_shaderProgram, const Core::Maths::Vec3& p_camPosition, const unsigned int p_index)
+	void PointLight::Pack(UniformBlock& p_block) const
 	{
-		std::string array = "pointLights[" + std::to_string(p_index) + "].";
+		p_block.BeginStruct();
+		Light::Pack(p_block);
+		p_block.AddFloat(constant);
+		p_block.AddFloat(linear);
+		p_block.AddFloat(quadratic);
+		p_block.EndStruct();
+	}
 
-		glUniform1f(glGetUniformLocation(p_shaderProgram, (array + "constant").c_str()), constant);
-		glUniform1f(glGetUniformLocation(p_shaderProgram, (array + "linear").c_str()), linear);
-		glUniform1f(glGetUniformLocation(p_shaderProgram, (array + "quadratic").c_str()), quadratic);
+	void PointLight::Pack(std::vector<Core::Maths::Vec4>& p_texels) const
+	{
+		Light::Pack(p_texels, constant);
+		p_texels.push_back(Core::Maths::Vec4(linear, quadratic, 0.f, 0.f));
+	}
+
+	float PointLight::GetRange() const
+	{
+		// intensity / (constant + linear * d + quadratic * d^2) = LIGHT_CUTOFF
+		const float c = constant - GetIntensity() / LIGHT_CUTOFF;
+		if (c >= 0.f)
+			return 0.f;
 
-		Light::Update(p_shaderProgram, p_camPosition, array);
+		if (quadratic > 0.f)
+			return (-linear + sqrtf(linear * linear - 4.f * quadratic * c)) / (2.f * quadratic);
+		if (linear > 0.f)
+			return -c / linear;
+
+		return std::numeric_limits<float>::max();
 	}
 
 	// --------------------
@@ -85,14 +121,19 @@ namespace LowRenderer
 		position = p_initLight.position;
 	}
 
-	void SpotLight::Update(const int p_shaderProgram, const Core::Maths::Vec3& p_camPosition, const unsigned int p_index)
+	void SpotLight::Pack(UniformBlock& p_block) const
 	{
-		std::string array = "spotLights[" + std::to_string(p_index) + "].";
-
-		glUniform3f(glGetUniformLocation(p_shaderProgram, (array+ "direction").c_str()), direction.x, direction.y, direction.z);
-		glUniform1f(glGetUniformLocation(p_shaderProgram, (array + "cutOff").c_str()), cosf(Core::Maths::DEG2RAD * cutOff));
-		glUniform1f(glGetUniformLocation(p_shaderProgram, (array + "outerCutOff").c_str()), outerCutOff);
+		p_block.BeginStruct();
+		Light::Pack(p_block);
+		p_block.AddVec3(direction);
+		p_block.AddFloat(cosf(Core::Maths::DEG2RAD * cutOff));
+		p_block.AddFloat(outerCutOff);
+		p_block.EndStruct();
+	}
 
-		Light::Update(p_shaderProgram, p_camPosition, array);
+	void SpotLight::Pack(std::vector<Core::Maths::Vec4>& p_texels) const
+	{
+		Light::Pack(p_texels, cosf(Core::Maths::DEG2RAD * cutOff));
+		p_texels.push_back(Core::Maths::Vec4(direction, outerCutOff));
 	}
 }
\ No newline at end of file
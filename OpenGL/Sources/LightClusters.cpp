@@ -0,0 +1,244 @@
+#include "LightClusters.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "JobSystem.hpp"
+
+namespace LowRenderer
+{
+	ClusterLight ClusterLight::Point(const Core::Maths::Vec3& p_position, const float p_range)
+	{
+		ClusterLight light;
+		light.center = p_position;
+		light.radius = p_range;
+		return light;
+	}
+
+	ClusterLight ClusterLight::Spot(const Core::Maths::Vec3& p_position, const Core::Maths::Vec3& p_direction, const float p_angle, const float p_range)
+	{
+		ClusterLight light;
+		light.isSpot = true;
+		light.position = p_position;
+		light.direction = p_direction;
+		light.cosAngle = cosf(p_angle);
+		light.sinAngle = sinf(p_angle);
+		light.range = p_range;
+
+		// Smallest sphere around the cone : its base circle for the wide ones
+		if (light.cosAngle <= 0.f)
+		{
+			light.center = p_position;
+			light.radius = p_range;
+		}
+		else if (p_angle > (float)M_PI / 4.f)
+		{
+			light.center = p_position + p_direction * (light.cosAngle * p_range);
+			light.radius = light.sinAngle * p_range;
+		}
+		else
+		{
+			light.radius = p_range / (2.f * light.cosAngle);
+			light.center = p_position + p_direction * light.radius;
+		}
+
+		return light;
+	}
+
+	LightClusters::LightClusters()
+		: near(0.f)
+		, far(0.f)
+		, tanHalfFovY(0.f)
+		, aspect(0.f)
+		, clusterSpheres(NB_CLUSTERS)
+		, counts(NB_CLUSTERS, 0)
+		, lists(NB_CLUSTERS * MAX_LIGHTS_PER_CLUSTER)
+		, sliceOverflows(CLUSTER_Z, 0)
+		, grid(NB_CLUSTERS * 2, 0)
+		, nbOverflows(0)
+	{
+	}
+
+	void LightClusters::SetProjection(const float p_near, const float p_far, const float p_fovY, const float p_aspect)
+	{
+		const float tanHalf = tanf(Core::Maths::DEG2RAD * p_fovY / 2.f);
+		if (p_near == near && p_far == far && tanHalf == tanHalfFovY && p_aspect == aspect)
+			return;
+
+		near = p_near;
+		far = p_far;
+		tanHalfFovY = tanHalf;
+		aspect = p_aspect;
+
+		auto boundaries = [](std::vector<Core::Maths::Vec2>& p_boundaries, const unsigned int p_nbTiles, const float p_tan)
+		{
+			p_boundaries.clear();
+			for (unsigned int i = 0; i <= p_nbTiles; i++)
+			{
+				// Through the eye and the points at i / p_nbTiles of the screen
+				const float slope = (-1.f + 2.f * i / p_nbTiles) * p_tan;
+				const float length = sqrtf(1.f + slope * slope);
+				p_boundaries.push_back(Core::Maths::Vec2(1.f / length, slope / length));
+			}
+		};
+		boundaries(boundariesX, CLUSTER_X, tanHalfFovY * aspect);
+		boundaries(boundariesY, CLUSTER_Y, tanHalfFovY);
+
+		// Box around the 8 corners of each cluster
+		for (unsigned int z = 0; z < CLUSTER_Z; z++)
+		{
+			const float depths[2] = { GetSliceDepth(z), GetSliceDepth(z + 1) };
+			for (unsigned int y = 0; y < CLUSTER_Y; y++)
+			{
+				for (unsigned int x = 0; x < CLUSTER_X; x++)
+				{
+					Core::Maths::Vec3 min(1e30f, 1e30f, 1e30f), max(-1e30f, -1e30f, -1e30f);
+					for (unsigned int corner = 0; corner < 8; corner++)
+					{
+						const float depth = depths[corner >> 2];
+						const float screenX = -1.f + 2.f * (x + (corner & 1)) / CLUSTER_X;
+						const float screenY = -1.f + 2.f * (y + ((corner >> 1) & 1)) / CLUSTER_Y;
+						const Core::Maths::Vec3 point(screenX * tanHalfFovY * aspect * depth, screenY * tanHalfFovY * depth, -depth);
+
+						min = Core::Maths::Vec3(std::min(min.x, point.x), std::min(min.y, point.y), std::min(min.z, point.z));
+						max = Core::Maths::Vec3(std::max(max.x, point.x), std::max(max.y, point.y), std::max(max.z, point.z));
+					}
+
+					const Core::Maths::Vec3 center = (min + max) * 0.5f;
+					clusterSpheres[GetClusterIndex(x, y, z)] = Core::Maths::Vec4(center, (max - center).Magnitude());
+				}
+			}
+		}
+	}
+
+	void LightClusters::Build(const std::vector<ClusterLight>& p_lights)
+	{
+		ranges.resize(p_lights.size());
+		Core::JobSystem::ParallelFor((unsigned int)p_lights.size(), 64, [this, &p_lights](unsigned int p_begin, unsigned int p_end)
+		{
+			for (unsigned int i = p_begin; i < p_end; i++)
+				ranges[i] = GetRange(p_lights[i]);
+		});
+
+		// A slice only writes its own clusters
+		Core::JobSystem::ParallelFor(CLUSTER_Z, 1, [this, &p_lights](unsigned int p_begin, unsigned int p_end)
+		{
+			for (unsigned int slice = p_begin; slice < p_end; slice++)
+				BuildSlice(slice, p_lights);
+		});
+
+		indices.clear();
+		for (unsigned int cluster = 0; cluster < NB_CLUSTERS; cluster++)
+		{
+			grid[cluster * 2] = (uint32_t)indices.size();
+			grid[cluster * 2 + 1] = counts[cluster];
+
+			const uint32_t* list = lists.data() + (size_t)cluster * MAX_LIGHTS_PER_CLUSTER;
+			indices.insert(indices.end(), list, list + counts[cluster]);
+		}
+
+		nbOverflows = 0;
+		for (const unsigned int overflows : sliceOverflows)
+			nbOverflows += overflows;
+	}
+
+	// Before SetProjection every depth is in the first slice
+	float LightClusters::GetSliceScale() const
+	{
+		return near > 0.f ? CLUSTER_Z / logf(far / near) : 0.f;
+	}
+
+	float LightClusters::GetSliceBias() const
+	{
+		return near > 0.f ? -(CLUSTER_Z * logf(near)) / logf(far / near) : 0.f;
+	}
+
+	int LightClusters::GetSlice(const float p_depth) const
+	{
+		const int slice = (int)floorf(logf(p_depth) * GetSliceScale() + GetSliceBias());
+		return std::clamp(slice, 0, (int)CLUSTER_Z - 1);
+	}
+
+	ClusterRange LightClusters::GetRange(const ClusterLight& p_light) const
+	{
+		ClusterRange range;
+
+		const float depth = -p_light.center.z;
+		if (depth + p_light.radius < near || depth - p_light.radius > far)
+			return range;
+
+		// Tiles between a boundary on their left (or below) and one on their right (or above) touched by the sphere
+		auto tiles = [&p_light](const std::vector<Core::Maths::Vec2>& p_boundaries, const float p_coordinate, int& p_min, int& p_max)
+		{
+			p_min = 0;
+			p_max = -1;
+			for (int i = 0; i + 1 < (int)p_boundaries.size(); i++)
+			{
+				const float left = p_boundaries[i].x * p_coordinate + p_boundaries[i].y * p_light.center.z;
+				const float right = p_boundaries[i + 1].x * p_coordinate + p_boundaries[i + 1].y * p_light.center.z;
+				if (left < -p_light.radius || right > p_light.radius)
+					continue;
+
+				if (p_max < p_min)
+					p_min = i;
+				p_max = i;
+			}
+		};
+
+		tiles(boundariesX, p_light.center.x, range.minX, range.maxX);
+		tiles(boundariesY, p_light.center.y, range.minY, range.maxY);
+		if (range.maxX < range.minX || range.maxY < range.minY)
+			return ClusterRange();
+
+		range.minZ = GetSlice(std::max(depth - p_light.radius, near));
+		range.maxZ = GetSlice(std::min(depth + p_light.radius, far));
+		return range;
+	}
+
+	void LightClusters::BuildSlice(const unsigned int p_slice, const std::vector<ClusterLight>& p_lights)
+	{
+		const unsigned int first = GetClusterIndex(0, 0, p_slice);
+		std::fill(counts.begin() + first, counts.begin() + first + CLUSTER_X * CLUSTER_Y, 0);
+		unsigned int overflows = 0;
+
+		for (unsigned int i = 0; i < p_lights.size(); i++)
+		{
+			const ClusterRange& range = ranges[i];
+			if ((int)p_slice < range.minZ || (int)p_slice > range.maxZ)
+				continue;
+
+			const ClusterLight& light = p_lights[i];
+			for (int y = range.minY; y <= range.maxY; y++)
+			{
+				for (int x = range.minX; x <= range.maxX; x++)
+				{
+					const unsigned int cluster = GetClusterIndex(x, y, p_slice);
+
+					// Sphere of the cluster against the cone, the narrow cones are far smaller than their sphere
+					if (light.isSpot && light.cosAngle > 0.f)
+					{
+						const Core::Maths::Vec4& sphere = clusterSpheres[cluster];
+						const Core::Maths::Vec3 toCluster = Core::Maths::Vec3(sphere.x, sphere.y, sphere.z) - light.position;
+						const float alongAxis = toCluster.DotProduct(light.direction);
+						const float distanceSquared = toCluster.DotProduct(toCluster);
+						const float toAxis = sqrtf(std::max(distanceSquared - alongAxis * alongAxis, 0.f));
+						if (light.cosAngle * toAxis - alongAxis * light.sinAngle > sphere.w || alongAxis > sphere.w + light.range || alongAxis < -sphere.w)
+							continue;
+					}
+
+					if (counts[cluster] < MAX_LIGHTS_PER_CLUSTER)
+						lists[(size_t)cluster * MAX_LIGHTS_PER_CLUSTER + counts[cluster]++] = i;
+					else
+						overflows++;
+				}
+			}
+		}
+
+		sliceOverflows[p_slice] = overflows;
+	}
+
+	float LightClusters::GetSliceDepth(const unsigned int p_slice) const
+	{
+		return near * powf(far / near, (float)p_slice / CLUSTER_Z);
+	}
+}
\ No newline at end of file
@@ -3,11 +3,12 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
-#include "Imgui/imgui.h"
-#include "Imgui/imgui_impl_glfw.h"
-#include "Imgui/imgui_impl_opengl3.h"
+#include "ImGUI/imgui.h"
+#include "ImGUI/imgui_impl_glfw.h"
+#include "ImGUI/imgui_impl_opengl3.h"
 
 #include "Log.hpp"
+#include "Shader.hpp"
 
 namespace LowRenderer
 {
@@ -15,23 +16,83 @@ namespace LowRenderer
 		: directionLights()
 		, pointLights()
 		, spotLights()
+		, block()
+		, buffer(Resources::LIGHTS_BLOCK_BINDING)
+		, lightsTexture(Resources::CLUSTER_LIGHTS_TEXTURE_UNIT, GL_RGBA32F)
+		, gridTexture(Resources::CLUSTER_GRID_TEXTURE_UNIT, GL_RG32UI)
+		, indicesTexture(Resources::CLUSTER_INDICES_TEXTURE_UNIT, GL_R32UI)
 	{
+		UpdateDefines();
 	}
 
-	void LightManager::Draw(const int p_shaderProgram, const Core::Maths::Vec3& p_camPosition)
+	void LightManager::Update(const Core::Maths::Vec3& p_camPosition)
 	{
-		glUniform1f(glGetUniformLocation(p_shaderProgram, "nbDirectionLight"), directionLights.size());
-		glUniform1f(glGetUniformLocation(p_shaderProgram, "nbPointLight"), pointLights.size());
-		glUniform1f(glGetUniformLocation(p_shaderProgram, "nbSpotLight"), spotLights.size());
+		block.Clear();
+		Pack(block, p_camPosition);
+		buffer.Upload(block);
 
-		for (unsigned int i = 0; i < directionLights.size(); i++)
-			directionLights[i].Update(p_shaderProgram, p_camPosition, i);
+		texels.clear();
+		PackLights(texels);
+		lightsTexture.Upload(texels.data(), texels.size() * sizeof(Core::Maths::Vec4));
+		gridTexture.Upload(clusters.GetGrid().data(), clusters.GetGrid().size() * sizeof(uint32_t));
+		indicesTexture.Upload(clusters.GetIndices().data(), clusters.GetIndices().size() * sizeof(uint32_t));
+	}
 
-		for (unsigned int i = 0; i < pointLights.size(); i++)
-			pointLights[i].Update(p_shaderProgram, p_camPosition, i);
+	void LightManager::Pack(UniformBlock& p_block, const Core::Maths::Vec3& p_camPosition) const
+	{
+		p_block.AddVec3(p_camPosition);
+		p_block.AddInt((int32_t)directionLights.size());
+		p_block.AddInt((int32_t)pointLights.size());
+		p_block.AddInt((int32_t)spotLights.size());
 
-		for (unsigned int i = 0; i < spotLights.size(); i++)
-			spotLights[i].Update(p_shaderProgram, p_camPosition, i);
+		// The ambient of the spot lights is not limited to their cone, it lights every fragment
+		Core::Maths::Vec4 spotAmbient;
+		for (const SpotLight& light : spotLights)
+			spotAmbient += light.GetAmbientColor();
+		p_block.AddVec4(spotAmbient);
+		p_block.AddVec4(Core::Maths::Vec4(clusters.GetSliceScale(), clusters.GetSliceBias(), 0.f, 0.f));
+
+		// The array always has its full size, the unused lights are zero
+		for (unsigned int i = 0; i < MAX_DIRECTION_LIGHT; i++)
+			(i < directionLights.size() ? directionLights[i] : DirectionLight(InitLight(), Core::Maths::Vec3())).Pack(p_block);
+	}
+
+	void LightManager::PackLights(std::vector<Core::Maths::Vec4>& p_texels) const
+	{
+		for (const PointLight& light : pointLights)
+			light.Pack(p_texels);
+
+		for (const SpotLight& light : spotLights)
+			light.Pack(p_texels);
+	}
+
+	void LightManager::AssignClusters(const Core::Maths::Mat4& p_view, const float p_near, const float p_far, const float p_fovY, const float p_aspect)
+	{
+		clusters.SetProjection(p_near, p_far, p_fovY, p_aspect);
+
+		const float (&m)[4][4] = p_view.mat;
+		auto toView = [&m](const Core::Maths::Vec3& p_vector, const float p_w)
+		{
+			return Core::Maths::Vec3(
+				m[0][0] * p_vector.x + m[0][1] * p_vector.y + m[0][2] * p_vector.z + m[0][3] * p_w,
+				m[1][0] * p_vector.x + m[1][1] * p_vector.y + m[1][2] * p_vector.z + m[1][3] * p_w,
+				m[2][0] * p_vector.x + m[2][1] * p_vector.y + m[2][2] * p_vector.z + m[2][3] * p_w);
+		};
+
+		// Same order as PackLights, the index of a volume is the index of the light in the buffer
+		volumes.clear();
+		for (const PointLight& light : pointLights)
+			volumes.push_back(ClusterLight::Point(toView(light.GetPosition(), 1.f), light.GetRange()));
+
+		// No attenuation, the cone goes up to the far plane
+		for (const SpotLight& light : spotLights)
+		{
+			Core::Maths::Vec3 direction = toView(light.GetDirection(), 0.f);
+			direction.Normalize();
+			volumes.push_back(ClusterLight::Spot(toView(light.GetPosition(), 1.f), direction, Core::Maths::DEG2RAD * light.GetCutOff(), p_far));
+		}
+
+		clusters.Build(volumes);
 	}
 
 	void LightManager::DrawImGui()
@@ -87,6 +148,7 @@ namespace LowRenderer
 			return;
 		}
 		directionLights.push_back(p_light);
+		UpdateDefines();
 		Core::Debug::Log::Print("Add direction light\n", Core::Debug::LogLevel::Notification);
 	}
 
@@ -98,6 +160,7 @@ namespace LowRenderer
 			return;
 		}
 		pointLights.push_back(LowRenderer::PointLight(p_light));
+		UpdateDefines();
 		Core::Debug::Log::Print("Add point light\n", Core::Debug::LogLevel::Notification);
 	}
 
@@ -109,6 +172,13 @@ namespace LowRenderer
 			return;
 		}
 		spotLights.push_back(LowRenderer::SpotLight(p_light));
+		UpdateDefines();
 		Core::Debug::Log::Print("Add spot light\n", Core::Debug::LogLevel::Notification);
 	}
+
+	void LightManager::UpdateDefines()
+	{
+		// The point and spot lights are read from their cluster, their numbers do not need variants
+		defines.Set("NB_DIRECTION_LIGHT", (int)directionLights.size());
+	}
 }
\ No newline at end of file
@@ -1,8 +1,10 @@
 #include "Log.hpp"
 
 #include <iostream>
+#ifdef _WIN32
 #include <Windows.h>
 #include <debugapi.h>
+#endif
 
 #include "Assertion.hpp"
 
@@ -11,22 +13,40 @@ namespace Core::Debug
 	void DebugLog(const std::string p_filename, const int p_line, const std::string p_functionName, const std::string p_log)
 	{
 		std::string message = p_filename + '(' + std::to_string(p_line) + "): " + p_functionName + ": " + p_log + '\n';
+#ifdef _WIN32
 		OutputDebugStringA(message.c_str());
+#endif
 		Log::Print(message, LogLevel::Critical);
 	}
 
+	// Console attribute on Windows, ANSI escape code elsewhere
+	static void SetColor(const unsigned short p_attribute, const char* p_code)
+	{
+#ifdef _WIN32
+		(void)p_code;
+		SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), p_attribute);
+#else
+		(void)p_attribute;
+		std::cout << p_code;
+#endif
+	}
+
 	std::ofstream Log::logFile;
+	SpinLock Log::printLock;
 	
 	void Log::OpenFile(std::filesystem::path const& p_filename)
 	{
-		if (logFile && logFile.is_open())
+		bool isOpen = false;
 		{
-			Log::Print("Log file already open\n", LogLevel::Warning);
-			return;
+			ScopedLock lock(printLock);
+			isOpen = logFile && logFile.is_open();
+			if (!isOpen)
+				logFile.open(p_filename, std::ios::out);
 		}
 
-		logFile.open(p_filename, std::ios::out);
-		if (!logFile)
+		if (isOpen)
+			Log::Print("Log file already open\n", LogLevel::Warning);
+		else if (!logFile)
 			Log::Print("Fail to open log file " + p_filename.string() + "\n", LogLevel::Warning);
 		else
 			Log::Print("Open log file " + p_filename.string() + "\n", LogLevel::Notification);
@@ -34,39 +54,39 @@ namespace Core::Debug
 
 	void Log::Print(const std::string& p_log, const LogLevel& p_level)
 	{
-		HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
+		ScopedLock lock(printLock);
 		std::string log;
 
 		switch (p_level)
 		{
 		case LogLevel::Notification:
-			SetConsoleTextAttribute(handle, 11); // blue
+			SetColor(11, "\033[96m"); // blue
 			std::cout << "[Notification]";
-			SetConsoleTextAttribute(handle, 15); // white (default)
+			SetColor(15, "\033[0m"); // white (default)
 			std::cout << " " << p_log;
 			log = "[Notification] " + p_log;
 			break;
 
 		case LogLevel::Test:
-			SetConsoleTextAttribute(handle, 10); // green
+			SetColor(10, "\033[92m"); // green
 			std::cout << "[Test]";
-			SetConsoleTextAttribute(handle, 15); // white (default)
+			SetColor(15, "\033[0m"); // white (default)
 			std::cout << " " << p_log;
 			log = "[Test] " + p_log;
 			break;
 
 		case LogLevel::Warning:
-			SetConsoleTextAttribute(handle, 14); // yellow
+			SetColor(14, "\033[93m"); // yellow
 			std::cout << "[Warning]";
-			SetConsoleTextAttribute(handle, 15); // white (default)
+			SetColor(15, "\033[0m"); // white (default)
 			std::cout << " " << p_log;
 			log = "[Warning] " + p_log;
 			break;
 
 		case LogLevel::Critical:
-			SetConsoleTextAttribute(handle, 207); // red
+			SetColor(207, "\033[97;41m"); // red
 			std::cout << "[Critical]";
-			SetConsoleTextAttribute(handle, 15); // white (default)
+			SetColor(15, "\033[0m"); // white (default)
 			std::cout << " " << p_log;
 			log = "[Critical] " + p_log;
 			break;
@@ -83,7 +103,10 @@ namespace Core::Debug
 
 	void Log::CloseFile()
 	{
-		logFile.close();
+		{
+			ScopedLock lock(printLock);
+			logFile.close();
+		}
 		Log::Print("Close log file\n", LogLevel::Notification);
 	}
 }
\ No newline at end of file
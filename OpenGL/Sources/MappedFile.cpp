@@ -0,0 +1,118 @@
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "Log.hpp"
+
+namespace Core
+{
+	MappedFile::MappedFile()
+		: data(nullptr)
+		, size(0)
+#ifdef _WIN32
+		, file(INVALID_HANDLE_VALUE)
+		, mapping(nullptr)
+#else
+		, file(-1)
+#endif
+	{
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open(const std::string& p_path)
+	{
+		Close();
+
+#ifdef _WIN32
+		file = CreateFileA(p_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		LARGE_INTEGER fileSize;
+		if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+		{
+			Debug::Log::Print("Fail to map file " + p_path + "\n", Debug::LogLevel::Warning);
+			Close();
+			return false;
+		}
+
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping)
+			data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		size = (size_t)fileSize.QuadPart;
+#else
+		file = open(p_path.c_str(), O_RDONLY | O_CLOEXEC);
+		struct stat fileStat;
+		if (file == -1 || fstat(file, &fileStat) == -1 || fileStat.st_size == 0)
+		{
+			Debug::Log::Print("Fail to map file " + p_path + "\n", Debug::LogLevel::Warning);
+			Close();
+			return false;
+		}
+
+		void* view = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		if (view != MAP_FAILED)
+			data = static_cast<const unsigned char*>(view);
+		size = (size_t)fileStat.st_size;
+#endif
+
+		if (!data)
+		{
+			Debug::Log::Print("Fail to map file " + p_path + "\n", Debug::LogLevel::Warning);
+			Close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+#ifdef _WIN32
+		if (data)
+			UnmapViewOfFile(data);
+		if (mapping)
+			CloseHandle(mapping);
+		if (file != INVALID_HANDLE_VALUE)
+			CloseHandle(file);
+		mapping = nullptr;
+		file = INVALID_HANDLE_VALUE;
+#else
+		if (data)
+			munmap(const_cast<unsigned char*>(data), size);
+		if (file != -1)
+			close(file);
+		file = -1;
+#endif
+		data = nullptr;
+		size = 0;
+	}
+
+	void MappedFile::Prefetch(const size_t p_offset, const size_t p_size) const
+	{
+		if (!data || p_offset >= size)
+			return;
+
+		const size_t length = p_size < size - p_offset ? p_size : size - p_offset;
+
+#ifdef _WIN32
+		WIN32_MEMORY_RANGE_ENTRY range;
+		range.VirtualAddress = const_cast<unsigned char*>(data + p_offset);
+		range.NumberOfBytes = length;
+		PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+		// madvise needs a page aligned address
+		const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+		const size_t begin = p_offset - p_offset % pageSize;
+		madvise(const_cast<unsigned char*>(data + begin), length + p_offset - begin, MADV_WILLNEED);
+#endif
+	}
+}
\ No newline at end of file
@@ -3,16 +3,35 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <sstream>
+#include <algorithm>
+#include <cstddef>
 
 #include "Assertion.hpp"
 #include "OBJParser.hpp"
+#include "MeshArena.hpp"
 
 namespace Resources
 {
+	InstanceData::InstanceData(const Core::Maths::Mat4& p_model, const Core::Maths::Mat4& p_normalMatrix)
+	{
+		// The matrices of the engine are in rows
+		for (unsigned int column = 0; column < 4; column++)
+		{
+			for (unsigned int row = 0; row < 4; row++)
+				model[column * 4 + row] = p_model.mat[row][column];
+		}
+		for (unsigned int column = 0; column < 3; column++)
+		{
+			for (unsigned int row = 0; row < 3; row++)
+				normalMatrix[column * 3 + row] = p_normalMatrix.mat[row][column];
+		}
+	}
+
 	Mesh::Mesh(const std::string& p_name, const std::string& p_path1, const std::string& p_path2, const unsigned int p_id)
 		: EBO(0)
 		, VBO(0)
 		, VAO(0)
+		, radius(0.f)
 	{
 		name = p_name;
 		path1 = p_path1;
@@ -22,6 +41,7 @@ namespace Resources
 
 	Mesh::~Mesh()
 	{
+		MeshArena::RemoveFromAll(*this);
 		glDeleteVertexArrays(1, &VAO);
 		glDeleteBuffers(1, &VBO);
 		glDeleteBuffers(1, &EBO);
@@ -29,8 +49,15 @@ namespace Resources
 
 	void Mesh::Init()
 	{
-		if(path1.size() > 3)
-			OBJ::Parse(path1, vertexBuffer, indexBuffer);
+		if (path1.size() > 3 && !OBJ::Parse(path1, vertexBuffer, indexBuffer))
+		{
+			stat = StatResource::FAILED;
+			return;
+		}
+
+		for (const Vertex& vertex : vertexBuffer)
+			radius = std::max(radius, vertex.position.Magnitude());
+
 		stat = StatResource::INITIALIZED;
 	}
 
@@ -40,12 +67,71 @@ namespace Resources
 		stat = StatResource::LOADED;
 	}
 
+	IResource* Mesh::CreateReload() const
+	{
+		return new Mesh(name, path1, path2, id);
+	}
+
+	void Mesh::SwapReload(IResource& p_reloaded)
+	{
+		Mesh& reloaded = static_cast<Mesh&>(p_reloaded);
+		std::swap(VAO, reloaded.VAO);
+		std::swap(VBO, reloaded.VBO);
+		std::swap(EBO, reloaded.EBO);
+		vertexBuffer.swap(reloaded.vertexBuffer);
+		indexBuffer.swap(reloaded.indexBuffer);
+		std::swap(radius, reloaded.radius);
+	}
+
+	ResourceMemory Mesh::GetMemoryUsage() const
+	{
+		ResourceMemory memory;
+
+		// The buffers are kept after the upload
+		memory.cpu = vertexBuffer.capacity() * sizeof(Vertex) + indexBuffer.capacity() * sizeof(unsigned int);
+		if (VAO)
+			memory.gpu = vertexBuffer.size() * sizeof(Vertex) + indexBuffer.size() * sizeof(unsigned int);
+
+		return memory;
+	}
+
 	void Mesh::Draw() const
 	{
-		glBindVertexArray(VAO); // seeing as we only have a single VAO there's no need to bind it every time, but we'll do so to keep things a bit more organized
+		Bind();
+		DrawElements();
+	}
+
+	void Mesh::Bind() const
+	{
+		glBindVertexArray(VAO);
+	}
+
+	void Mesh::DrawElements() const
+	{
 		glDrawElements(GL_TRIANGLES, indexBuffer.size(), GL_UNSIGNED_INT, 0);
 	}
 
+	void Mesh::BindInstances(const size_t p_offset)
+	{
+		for (unsigned int column = 0; column < 4; column++)
+		{
+			glVertexAttribPointer(INSTANCE_MODEL_ATTRIBUTE + column, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)(p_offset + column * 4 * sizeof(float)));
+			glVertexAttribDivisor(INSTANCE_MODEL_ATTRIBUTE + column, 1);
+			glEnableVertexAttribArray(INSTANCE_MODEL_ATTRIBUTE + column);
+		}
+		for (unsigned int column = 0; column < 3; column++)
+		{
+			glVertexAttribPointer(INSTANCE_NORMAL_ATTRIBUTE + column, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)(p_offset + offsetof(InstanceData, normalMatrix) + column * 3 * sizeof(float)));
+			glVertexAttribDivisor(INSTANCE_NORMAL_ATTRIBUTE + column, 1);
+			glEnableVertexAttribArray(INSTANCE_NORMAL_ATTRIBUTE + column);
+		}
+	}
+
+	void Mesh::DrawInstances(const unsigned int p_nbInstances) const
+	{
+		glDrawElementsInstanced(GL_TRIANGLES, indexBuffer.size(), GL_UNSIGNED_INT, 0, p_nbInstances);
+	}
+
 	void Mesh::LoadMesh()
 	{
 		glGenBuffers(1, &VBO);
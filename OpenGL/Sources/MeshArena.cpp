@@ -0,0 +1,223 @@
+#include "MeshArena.hpp"
+
+#include <algorithm>
+
+#include <glad/glad.h>
+
+#include "Assertion.hpp"
+
+namespace Resources
+{
+	ArenaAllocator::ArenaAllocator(const size_t p_capacity)
+		: capacity(0)
+		, used(0)
+	{
+		Grow(p_capacity);
+	}
+
+	size_t ArenaAllocator::Allocate(const size_t p_size)
+	{
+		if (p_size == 0)
+			return 0;
+
+		for (auto range = freeRanges.begin(); range != freeRanges.end(); range++)
+		{
+			if (range->second < p_size)
+				continue;
+
+			const size_t offset = range->first;
+			const size_t left = range->second - p_size;
+			freeRanges.erase(range);
+			if (left > 0)
+				freeRanges.emplace(offset + p_size, left);
+
+			used += p_size;
+			return offset;
+		}
+
+		return ARENA_FULL;
+	}
+
+	void ArenaAllocator::Free(const size_t p_offset, const size_t p_size)
+	{
+		if (p_size == 0)
+			return;
+
+		size_t offset = p_offset;
+		size_t size = p_size;
+
+		// With the free range just after, then the one just before
+		auto next = freeRanges.lower_bound(offset);
+		if (next != freeRanges.end() && next->first == offset + size)
+		{
+			size += next->second;
+			next = freeRanges.erase(next);
+		}
+		if (next != freeRanges.begin())
+		{
+			auto previous = std::prev(next);
+			if (previous->first + previous->second == offset)
+			{
+				offset = previous->first;
+				size += previous->second;
+				freeRanges.erase(previous);
+			}
+		}
+
+		freeRanges.emplace(offset, size);
+		used -= p_size;
+	}
+
+	void ArenaAllocator::Grow(const size_t p_capacity)
+	{
+		if (p_capacity <= capacity)
+			return;
+
+		const size_t oldCapacity = capacity;
+		capacity = p_capacity;
+		used += capacity - oldCapacity; // Given back by Free
+		Free(oldCapacity, capacity - oldCapacity);
+	}
+
+	size_t ArenaAllocator::GetFreeTail() const
+	{
+		if (freeRanges.empty())
+			return 0;
+
+		const auto last = std::prev(freeRanges.end());
+		return last->first + last->second == capacity ? last->second : 0;
+	}
+
+	std::vector<MeshArena*> MeshArena::arenas;
+
+	MeshArena::MeshArena()
+		: VAO(0)
+		, VBO(0)
+		, EBO(0)
+	{
+		arenas.push_back(this);
+	}
+
+	MeshArena::~MeshArena()
+	{
+		arenas.erase(std::find(arenas.begin(), arenas.end(), this));
+
+		if (VAO)
+		{
+			glDeleteVertexArrays(1, &VAO);
+			glDeleteBuffers(1, &VBO);
+			glDeleteBuffers(1, &EBO);
+		}
+	}
+
+	const ArenaRange& MeshArena::Add(const Mesh& p_mesh)
+	{
+		auto found = ranges.find(&p_mesh);
+		if (found != ranges.end())
+		{
+			if (found->second.source == p_mesh.GetVertexBuffer().data() && found->second.nbVertices == p_mesh.GetVertexBuffer().size()
+				&& found->second.nbIndices == p_mesh.GetIndexBuffer().size())
+				return found->second;
+			Remove(p_mesh);
+		}
+
+		ArenaRange range;
+		range.nbVertices = p_mesh.GetVertexBuffer().size();
+		range.nbIndices = p_mesh.GetIndexBuffer().size();
+		range.source = p_mesh.GetVertexBuffer().data();
+
+		range.firstVertex = vertices.Allocate(range.nbVertices);
+		range.firstIndex = indices.Allocate(range.nbIndices);
+		if (!VAO || range.firstVertex == ARENA_FULL || range.firstIndex == ARENA_FULL)
+		{
+			if (range.firstVertex != ARENA_FULL)
+				vertices.Free(range.firstVertex, range.nbVertices);
+			if (range.firstIndex != ARENA_FULL)
+				indices.Free(range.firstIndex, range.nbIndices);
+
+			Grow(range.nbVertices, range.nbIndices);
+			range.firstVertex = vertices.Allocate(range.nbVertices);
+			range.firstIndex = indices.Allocate(range.nbIndices);
+			Assertion(range.firstVertex != ARENA_FULL && range.firstIndex != ARENA_FULL, "fail to grow the mesh arena for " + p_mesh.GetName());
+		}
+
+		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+		glBufferSubData(GL_ARRAY_BUFFER, range.firstVertex * sizeof(Vertex), range.nbVertices * sizeof(Vertex), p_mesh.GetVertexBuffer().data());
+		glBindBuffer(GL_COPY_WRITE_BUFFER, EBO);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, range.firstIndex * sizeof(unsigned int), range.nbIndices * sizeof(unsigned int), p_mesh.GetIndexBuffer().data());
+
+		return ranges[&p_mesh] = range;
+	}
+
+	void MeshArena::Remove(const Mesh& p_mesh)
+	{
+		auto found = ranges.find(&p_mesh);
+		if (found == ranges.end())
+			return;
+
+		vertices.Free(found->second.firstVertex, found->second.nbVertices);
+		indices.Free(found->second.firstIndex, found->second.nbIndices);
+		ranges.erase(found);
+	}
+
+	void MeshArena::Bind() const
+	{
+		glBindVertexArray(VAO);
+	}
+
+	void MeshArena::RemoveFromAll(const Mesh& p_mesh)
+	{
+		for (MeshArena* arena : arenas)
+			arena->Remove(p_mesh);
+	}
+
+	void MeshArena::Grow(const size_t p_nbVertices, const size_t p_nbIndices)
+	{
+		// The free elements are fragmented : only the free tail is contiguous with the new ones
+		size_t vertexCapacity = std::max(vertices.GetCapacity(), ARENA_VERTICES);
+		while (vertexCapacity - vertices.GetCapacity() + vertices.GetFreeTail() < p_nbVertices)
+			vertexCapacity *= 2;
+		size_t indexCapacity = std::max(indices.GetCapacity(), ARENA_INDICES);
+		while (indexCapacity - indices.GetCapacity() + indices.GetFreeTail() < p_nbIndices)
+			indexCapacity *= 2;
+
+		// New buffers, the meshes already uploaded are copied on the GPU
+		unsigned int buffers[2];
+		glGenBuffers(2, buffers);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, buffers[0]);
+		glBufferData(GL_COPY_WRITE_BUFFER, vertexCapacity * sizeof(Vertex), nullptr, GL_STATIC_DRAW);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, buffers[1]);
+		glBufferData(GL_COPY_WRITE_BUFFER, indexCapacity * sizeof(unsigned int), nullptr, GL_STATIC_DRAW);
+
+		if (VAO)
+		{
+			glBindBuffer(GL_COPY_READ_BUFFER, VBO);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, buffers[0]);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, vertices.GetCapacity() * sizeof(Vertex));
+			glBindBuffer(GL_COPY_READ_BUFFER, EBO);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, buffers[1]);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, indices.GetCapacity() * sizeof(unsigned int));
+			glDeleteBuffers(1, &VBO);
+			glDeleteBuffers(1, &EBO);
+		}
+		else
+			glGenVertexArrays(1, &VAO);
+
+		VBO = buffers[0];
+		EBO = buffers[1];
+		vertices.Grow(vertexCapacity);
+		indices.Grow(indexCapacity);
+
+		// Same layout as Mesh::LoadMesh
+		glBindVertexArray(VAO);
+		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sizeof(Core::Maths::Vec3)));
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(2 * sizeof(Core::Maths::Vec3)));
+		glEnableVertexAttribArray(2);
+		glBindVertexArray(0);
+	}
+}
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include "Model.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 namespace LowRenderer
 {
 
@@ -27,13 +30,34 @@ namespace LowRenderer
 	}
 
 
-	void Model::Draw(const Core::Maths::Mat4& p_transform, const Core::Maths::Mat4& p_mvp) const
+	void Model::Draw(const Core::Maths::Mat4& p_transform, const Core::Maths::Mat4& p_normalMatrix, const Core::Maths::Mat4& p_mvp) const
 	{
-		texture->Draw(shader->GetShaderProgram());
-		shader->Draw(p_transform, p_mvp);
+		RequestTextureSize(p_mvp);
+
+		texture->Draw(*shader);
+		shader->Draw(p_transform, p_normalMatrix, p_mvp);
 		mesh->Draw();
 	}
 
+	void Model::Draw(const Core::Maths::Mat4& p_transform, const Core::Maths::Mat4& p_mvp) const
+	{
+		Draw(p_transform, p_transform.GetNormalMatrix(), p_mvp);
+	}
+
+	void Model::RequestTextureSize(const Core::Maths::Mat4& p_mvp) const
+	{
+		texture->RequestScreenSize(GetScreenSize(p_mvp));
+	}
+
+	float Model::GetScreenSize(const Core::Maths::Mat4& p_mvp) const
+	{
+		// Size of the bounding sphere on screen : the clip w of the origin is its depth,
+		// the row y of the mvp holds the scale and the focal of the projection
+		const float depth = std::max(p_mvp.mat[3][3], 0.1f);
+		const float scaleY = std::sqrt(p_mvp.mat[1][0] * p_mvp.mat[1][0] + p_mvp.mat[1][1] * p_mvp.mat[1][1] + p_mvp.mat[1][2] * p_mvp.mat[1][2]);
+		return mesh->GetRadius() * scaleY / depth;
+	}
+
 	bool Model::InitCheck()const
 	{
 		if ( texture && shader && mesh && texture->GetStat() == Resources::StatResource::LOADED
@@ -866,6 +866,30 @@ namespace Core::Maths
 		return inverse;
 	}
 
+	Mat4 Mat4::GetNormalMatrix() const
+	{
+		// The translation has no effect on the normals. The inverse transpose of the 3x3 part is its cofactor
+		// matrix over its determinant, each row of cofactors is the cross product of the two other rows.
+		const Vec3 row0(mat[0][0], mat[0][1], mat[0][2]);
+		const Vec3 row1(mat[1][0], mat[1][1], mat[1][2]);
+		const Vec3 row2(mat[2][0], mat[2][1], mat[2][2]);
+
+		const Vec3 cofactors[3] = { row1.CrossProduct(row2), row2.CrossProduct(row0), row0.CrossProduct(row1) };
+		const float determinant = row0.DotProduct(cofactors[0]);
+		if (determinant == 0.f)
+			return Mat4::Identity();
+
+		const float inverseDeterminant = 1.f / determinant;
+		Mat4 normal = Mat4::Identity();
+		for (int i = 0; i < 3; i++)
+		{
+			normal.mat[i][0] = cofactors[i].x * inverseDeterminant;
+			normal.mat[i][1] = cofactors[i].y * inverseDeterminant;
+			normal.mat[i][2] = cofactors[i].z * inverseDeterminant;
+		}
+		return normal;
+	}
+
 	float Mat4::Determinant() const
 	{
 		return mat[0][0] * (mat[1][1] * (mat[2][2] * mat[3][3] - mat[2][3] * mat[3][2]) - mat[1][2] * (mat[2][1] * mat[3][3] - mat[3][1] * mat[2][3]) + mat[1][3] * (mat[2][1] * mat[3][2] - mat[2][2] * mat[3][1]))
@@ -0,0 +1,336 @@
+#include "OcclusionCulling.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <immintrin.h>
+
+#include "JobSystem.hpp"
+
+namespace LowRenderer
+{
+	static Core::Maths::Vec4 ToClip(const Core::Maths::Mat4& p_mvp, const Core::Maths::Vec3& p_position)
+	{
+		const float (&m)[4][4] = p_mvp.mat;
+		return Core::Maths::Vec4(
+			m[0][0] * p_position.x + m[0][1] * p_position.y + m[0][2] * p_position.z + m[0][3],
+			m[1][0] * p_position.x + m[1][1] * p_position.y + m[1][2] * p_position.z + m[1][3],
+			m[2][0] * p_position.x + m[2][1] * p_position.y + m[2][2] * p_position.z + m[2][3],
+			m[3][0] * p_position.x + m[3][1] * p_position.y + m[3][2] * p_position.z + m[3][3]);
+	}
+
+	// Pixels with y up, depth in [0, 1]
+	static Core::Maths::Vec3 ToScreen(const Core::Maths::Vec4& p_clip)
+	{
+		return Core::Maths::Vec3(
+			(p_clip.x / p_clip.w * 0.5f + 0.5f) * OCCLUSION_WIDTH,
+			(p_clip.y / p_clip.w * 0.5f + 0.5f) * OCCLUSION_HEIGHT,
+			p_clip.z / p_clip.w * 0.5f + 0.5f);
+	}
+
+	OcclusionBuffer::OcclusionBuffer()
+		: bins((OCCLUSION_HEIGHT + OCCLUSION_BAND - 1) / OCCLUSION_BAND)
+		, depth(OCCLUSION_WIDTH * OCCLUSION_HEIGHT, 1.f)
+	{
+		unsigned int width = OCCLUSION_WIDTH, height = OCCLUSION_HEIGHT;
+		while (true)
+		{
+			OcclusionLevel level;
+			level.width = width;
+			level.height = height;
+			level.minDepth.assign(width * height, 1.f);
+			level.maxDepth.assign(width * height, 1.f);
+			pyramid.push_back(std::move(level));
+
+			if (width == 1 && height == 1)
+				break;
+			width = (width + 1) / 2;
+			height = (height + 1) / 2;
+		}
+	}
+
+	void OcclusionBuffer::Clear()
+	{
+		triangles.clear();
+		for (std::vector<unsigned int>& bin : bins)
+			bin.clear();
+		std::fill(depth.begin(), depth.end(), 1.f);
+	}
+
+	void OcclusionBuffer::AddOccluder(const std::vector<Resources::Vertex>& p_vertices, const std::vector<unsigned int>& p_indices, const Core::Maths::Mat4& p_mvp)
+	{
+		projected.clear();
+		for (const Resources::Vertex& vertex : p_vertices)
+			projected.push_back(ToClip(p_mvp, vertex.position));
+
+		for (size_t i = 0; i + 2 < p_indices.size(); i += 3)
+		{
+			const Core::Maths::Vec4* corners[3] = { &projected[p_indices[i]], &projected[p_indices[i + 1]], &projected[p_indices[i + 2]] };
+
+			// Clipped against the near plane (z >= -w) as the GPU does : the part closer to the eye hides nothing
+			Core::Maths::Vec4 polygon[4];
+			unsigned int nbCorners = 0;
+			for (unsigned int edge = 0; edge < 3; edge++)
+			{
+				const Core::Maths::Vec4& from = *corners[edge];
+				const Core::Maths::Vec4& to = *corners[(edge + 1) % 3];
+				const float fromDistance = from.z + from.w;
+				const float toDistance = to.z + to.w;
+
+				if (fromDistance >= 0.f)
+					polygon[nbCorners++] = from;
+				if ((fromDistance >= 0.f) != (toDistance >= 0.f))
+				{
+					const float t = fromDistance / (fromDistance - toDistance);
+					polygon[nbCorners++] = Core::Maths::Vec4(from.x + (to.x - from.x) * t, from.y + (to.y - from.y) * t,
+						from.z + (to.z - from.z) * t, from.w + (to.w - from.w) * t);
+				}
+			}
+
+			for (unsigned int corner = 1; corner + 1 < nbCorners; corner++)
+				AddTriangle(polygon[0], polygon[corner], polygon[corner + 1]);
+		}
+	}
+
+	void OcclusionBuffer::AddTriangle(const Core::Maths::Vec4& p_clip0, const Core::Maths::Vec4& p_clip1, const Core::Maths::Vec4& p_clip2)
+	{
+		Core::Maths::Vec3 v0 = ToScreen(p_clip0), v1 = ToScreen(p_clip1), v2 = ToScreen(p_clip2);
+		float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+		if (area == 0.f)
+			return;
+
+		// Both faces are drawn, turned counter clockwise
+		if (area < 0.f)
+		{
+			std::swap(v1, v2);
+			area = -area;
+		}
+
+		OcclusionTriangle triangle;
+		// Clamped as floats, the vertices close to the eye project far away
+		triangle.minX = (int)std::floor(std::max(std::min({ v0.x, v1.x, v2.x }), 0.f));
+		triangle.minY = (int)std::floor(std::max(std::min({ v0.y, v1.y, v2.y }), 0.f));
+		triangle.maxX = (int)std::ceil(std::min(std::max({ v0.x, v1.x, v2.x }), (float)OCCLUSION_WIDTH));
+		triangle.maxY = (int)std::ceil(std::min(std::max({ v0.y, v1.y, v2.y }), (float)OCCLUSION_HEIGHT));
+		if (triangle.minX >= triangle.maxX || triangle.minY >= triangle.maxY)
+			return;
+
+		const Core::Maths::Vec3* vertices[3] = { &v0, &v1, &v2 };
+		for (unsigned int edge = 0; edge < 3; edge++)
+		{
+			const Core::Maths::Vec3& from = *vertices[edge];
+			const Core::Maths::Vec3& to = *vertices[(edge + 1) % 3];
+			triangle.edgeA[edge] = from.y - to.y;
+			triangle.edgeB[edge] = to.x - from.x;
+			triangle.edgeC[edge] = -triangle.edgeA[edge] * from.x - triangle.edgeB[edge] * from.y;
+		}
+
+		const float dx1 = v1.x - v0.x, dy1 = v1.y - v0.y, dz1 = v1.z - v0.z;
+		const float dx2 = v2.x - v0.x, dy2 = v2.y - v0.y, dz2 = v2.z - v0.z;
+		triangle.depthA = (dz1 * dy2 - dz2 * dy1) / area;
+		triangle.depthB = (dx1 * dz2 - dx2 * dz1) / area;
+		triangle.depthC = v0.z - triangle.depthA * v0.x - triangle.depthB * v0.y;
+
+		const unsigned int index = (unsigned int)triangles.size();
+		triangles.push_back(triangle);
+		for (int band = triangle.minY / OCCLUSION_BAND; band * (int)OCCLUSION_BAND < triangle.maxY; band++)
+			bins[band].push_back(index);
+	}
+
+	void OcclusionBuffer::Rasterize()
+	{
+		// Bands do not share pixels, no synchronisation between the jobs
+		Core::JobSystem::ParallelFor((unsigned int)bins.size(), 1, [this](unsigned int p_begin, unsigned int p_end)
+		{
+			for (unsigned int band = p_begin; band < p_end; band++)
+				RasterizeBand(band);
+		});
+	}
+
+	void OcclusionBuffer::RasterizeScalar()
+	{
+		for (unsigned int band = 0; band < bins.size(); band++)
+			RasterizeBandScalar(band);
+	}
+
+	void OcclusionBuffer::RasterizeBand(const unsigned int p_band)
+	{
+		const int bandMinY = p_band * OCCLUSION_BAND;
+		const int bandMaxY = std::min(bandMinY + (int)OCCLUSION_BAND, (int)OCCLUSION_HEIGHT);
+		const __m128 laneOffset = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+		const __m128 zero = _mm_setzero_ps();
+
+		for (const unsigned int index : bins[p_band])
+		{
+			const OcclusionTriangle& triangle = triangles[index];
+			const int minY = std::max(triangle.minY, bandMinY);
+			const int maxY = std::min(triangle.maxY, bandMaxY);
+			const int minX = triangle.minX & ~3;
+
+			const __m128 edgeA0 = _mm_set1_ps(triangle.edgeA[0]);
+			const __m128 edgeA1 = _mm_set1_ps(triangle.edgeA[1]);
+			const __m128 edgeA2 = _mm_set1_ps(triangle.edgeA[2]);
+			const __m128 depthA = _mm_set1_ps(triangle.depthA);
+
+			for (int y = minY; y < maxY; y++)
+			{
+				// Same operations as the scalar reference : A * x + (B * y + C)
+				const float pixelY = y + 0.5f;
+				const __m128 row0 = _mm_set1_ps(triangle.edgeB[0] * pixelY + triangle.edgeC[0]);
+				const __m128 row1 = _mm_set1_ps(triangle.edgeB[1] * pixelY + triangle.edgeC[1]);
+				const __m128 row2 = _mm_set1_ps(triangle.edgeB[2] * pixelY + triangle.edgeC[2]);
+				const __m128 rowDepth = _mm_set1_ps(triangle.depthB * pixelY + triangle.depthC);
+				float* line = depth.data() + y * OCCLUSION_WIDTH;
+
+				for (int x = minX; x < triangle.maxX; x += 4)
+				{
+					const __m128 pixelX = _mm_add_ps(_mm_set1_ps((float)x), laneOffset);
+					__m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA0, pixelX), row0), zero);
+					inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA1, pixelX), row1), zero));
+					inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA2, pixelX), row2), zero));
+					if (_mm_movemask_ps(inside) == 0)
+						continue;
+
+					const __m128 pixelDepth = _mm_add_ps(_mm_mul_ps(depthA, pixelX), rowDepth);
+					const __m128 previous = _mm_loadu_ps(line + x);
+					const __m128 nearest = _mm_min_ps(previous, pixelDepth);
+					_mm_storeu_ps(line + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, previous)));
+				}
+			}
+		}
+	}
+
+	void OcclusionBuffer::RasterizeBandScalar(const unsigned int p_band)
+	{
+		const int bandMinY = p_band * OCCLUSION_BAND;
+		const int bandMaxY = std::min(bandMinY + (int)OCCLUSION_BAND, (int)OCCLUSION_HEIGHT);
+
+		for (const unsigned int index : bins[p_band])
+		{
+			const OcclusionTriangle& triangle = triangles[index];
+			const int minY = std::max(triangle.minY, bandMinY);
+			const int maxY = std::min(triangle.maxY, bandMaxY);
+
+			for (int y = minY; y < maxY; y++)
+			{
+				const float pixelY = y + 0.5f;
+				const float row0 = triangle.edgeB[0] * pixelY + triangle.edgeC[0];
+				const float row1 = triangle.edgeB[1] * pixelY + triangle.edgeC[1];
+				const float row2 = triangle.edgeB[2] * pixelY + triangle.edgeC[2];
+				const float rowDepth = triangle.depthB * pixelY + triangle.depthC;
+
+				for (int x = triangle.minX & ~3; x < triangle.maxX; x++)
+				{
+					const float pixelX = (float)(x & ~3) + ((x & 3) + 0.5f);
+					if (triangle.edgeA[0] * pixelX + row0 < 0.f || triangle.edgeA[1] * pixelX + row1 < 0.f || triangle.edgeA[2] * pixelX + row2 < 0.f)
+						continue;
+
+					float& pixel = depth[y * OCCLUSION_WIDTH + x];
+					pixel = std::min(pixel, triangle.depthA * pixelX + rowDepth);
+				}
+			}
+		}
+	}
+
+	void OcclusionBuffer::BuildPyramid()
+	{
+		pyramid[0].minDepth = depth;
+		pyramid[0].maxDepth = depth;
+
+		for (size_t i = 1; i < pyramid.size(); i++)
+		{
+			const OcclusionLevel& fine = pyramid[i - 1];
+			OcclusionLevel& level = pyramid[i];
+
+			for (unsigned int y = 0; y < level.height; y++)
+			{
+				for (unsigned int x = 0; x < level.width; x++)
+				{
+					// 2x2 texels of the finer level, fewer on the odd borders
+					float minDepth = 1.f, maxDepth = 0.f;
+					for (unsigned int fineY = y * 2; fineY < std::min(y * 2 + 2, fine.height); fineY++)
+					{
+						for (unsigned int fineX = x * 2; fineX < std::min(x * 2 + 2, fine.width); fineX++)
+						{
+							minDepth = std::min(minDepth, fine.minDepth[fineY * fine.width + fineX]);
+							maxDepth = std::max(maxDepth, fine.maxDepth[fineY * fine.width + fineX]);
+						}
+					}
+
+					level.minDepth[y * level.width + x] = minDepth;
+					level.maxDepth[y * level.width + x] = maxDepth;
+				}
+			}
+		}
+	}
+
+	bool OcclusionBuffer::IsOccluded(const Core::Maths::Vec3& p_center, const float p_radius, const Core::Maths::Mat4& p_viewProjection) const
+	{
+		// Screen rectangle and nearest depth of the 8 corners of the box around the sphere
+		float minX = (float)OCCLUSION_WIDTH, minY = (float)OCCLUSION_HEIGHT, maxX = 0.f, maxY = 0.f;
+		float nearest = 1.f;
+		for (unsigned int corner = 0; corner < 8; corner++)
+		{
+			const Core::Maths::Vec3 position(
+				p_center.x + (corner & 1 ? p_radius : -p_radius),
+				p_center.y + (corner & 2 ? p_radius : -p_radius),
+				p_center.z + (corner & 4 ? p_radius : -p_radius));
+
+			const Core::Maths::Vec4 clip = ToClip(p_viewProjection, position);
+			if (clip.w < OCCLUSION_MIN_W)
+				return false;
+
+			const Core::Maths::Vec3 screen = ToScreen(clip);
+			minX = std::min(minX, screen.x);
+			minY = std::min(minY, screen.y);
+			maxX = std::max(maxX, screen.x);
+			maxY = std::max(maxY, screen.y);
+			nearest = std::min(nearest, screen.z);
+		}
+
+		// Out of the screen, left to the frustum culling
+		if (minX >= OCCLUSION_WIDTH || minY >= OCCLUSION_HEIGHT || maxX < 0.f || maxY < 0.f)
+			return false;
+
+		const int pixelMinX = (int)std::max(minX, 0.f);
+		const int pixelMinY = (int)std::max(minY, 0.f);
+		const int pixelMaxX = (int)std::min(maxX, OCCLUSION_WIDTH - 1.f);
+		const int pixelMaxY = (int)std::min(maxY, OCCLUSION_HEIGHT - 1.f);
+
+		// Coarsest level where the rectangle still covers 2x2 texels at most
+		unsigned int level = 0;
+		while (level + 1 < pyramid.size() && ((pixelMaxX >> level) - (pixelMinX >> level) > 1 || (pixelMaxY >> level) - (pixelMinY >> level) > 1))
+			level++;
+
+		return IsRegionOccluded(level, pixelMinX, pixelMinY, pixelMaxX, pixelMaxY, nearest);
+	}
+
+	bool OcclusionBuffer::IsRegionOccluded(const unsigned int p_level, const int p_minX, const int p_minY, const int p_maxX, const int p_maxY, const float p_depth) const
+	{
+		const OcclusionLevel& level = pyramid[p_level];
+
+		for (int y = p_minY >> p_level; y <= p_maxY >> p_level; y++)
+		{
+			for (int x = p_minX >> p_level; x <= p_maxX >> p_level; x++)
+			{
+				const unsigned int texel = y * level.width + x;
+
+				// Behind every occluder of the texel
+				if (p_depth > level.maxDepth[texel])
+					continue;
+
+				// In front of a part of the texel
+				if (p_level == 0 || p_depth <= level.minDepth[texel])
+					return false;
+
+				// Between the two, the finer texels covered by the rectangle decide
+				const int size = 1 << p_level;
+				if (!IsRegionOccluded(p_level - 1,
+					std::max(p_minX, x * size), std::max(p_minY, y * size),
+					std::min(p_maxX, (x + 1) * size - 1), std::min(p_maxY, (y + 1) * size - 1), p_depth))
+					return false;
+			}
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -1,8 +1,8 @@
 #include "PhysicManager.hpp"
 
 
-#include <GLFW/glfw3.h>
 #include <glad/glad.h>
+#include <GLFW/glfw3.h>
 
 namespace Physics
 {
@@ -88,7 +88,7 @@ namespace Physics
 
 
 
-	void PhysicsManager::DrawColliders(Core::Maths::Mat4& p_vp)
+	void PhysicsManager::DrawColliders(const Core::Maths::Mat4& p_vp)
 	{
 		glPolygonMode(GL_FRONT_AND_BACK,GL_LINE);
 		for (size_t i = 0; i < colliders.size(); i++)
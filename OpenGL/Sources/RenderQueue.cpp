@@ -0,0 +1,393 @@
+#include "RenderQueue.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+#include <glad/glad.h>
+
+#include "JobSystem.hpp"
+
+namespace LowRenderer
+{
+	void RenderList::Clear()
+	{
+		keys.clear();
+		draws.clear();
+		screenSizes.clear();
+	}
+
+	void RenderList::Add(Model& p_model, const Core::Maths::Mat4& p_transform, const Core::Maths::Mat4& p_normalMatrix, const Core::Maths::Mat4& p_mvp, const RenderPass p_pass)
+	{
+		RenderDraw draw{ p_model.GetShader(), p_model.GetTexture(), p_model.GetMesh(), &p_transform, &p_normalMatrix, p_mvp };
+		keys.push_back(RenderQueue::MakeKey(p_pass, draw.shader->GetId(), draw.texture->GetId(), draw.mesh->GetId(), p_mvp.mat[3][3]));
+		draws.push_back(draw);
+
+		// Few textures per list : the objects of a chunk share them
+		const float screenSize = p_model.GetScreenSize(p_mvp);
+		auto size = std::find_if(screenSizes.begin(), screenSizes.end(), [&draw](const std::pair<Resources::Texture*, float>& p_size) { return p_size.first == draw.texture; });
+		if (size == screenSizes.end())
+			screenSizes.emplace_back(draw.texture, screenSize);
+		else
+			size->second = std::max(size->second, screenSize);
+	}
+
+	RenderQueue::RenderQueue()
+		: nbLists(0)
+		, addOpen(false)
+		, instanceBuffer(0)
+		, instancing(true)
+		, indirect(false)
+		, indirectBuffer(0)
+		, instancedFrom(0)
+	{
+	}
+
+	RenderQueue::~RenderQueue()
+	{
+		if (instanceBuffer)
+			glDeleteBuffers(1, &instanceBuffer);
+		if (indirectBuffer)
+			glDeleteBuffers(1, &indirectBuffer);
+	}
+
+	void RenderQueue::Clear()
+	{
+		nbLists = 0;
+		addOpen = false;
+		commands.clear();
+		draws.clear();
+	}
+
+	void RenderQueue::Add(Model& p_model, const Core::Maths::Mat4& p_transform, const Core::Maths::Mat4& p_normalMatrix, const Core::Maths::Mat4& p_mvp, const RenderPass p_pass)
+	{
+		if (!addOpen)
+		{
+			NextList();
+			addOpen = true;
+		}
+		lists[nbLists - 1].Add(p_model, p_transform, p_normalMatrix, p_mvp, p_pass);
+	}
+
+	void RenderQueue::Record(const unsigned int p_count, const unsigned int p_grain, const std::function<void(unsigned int, unsigned int, RenderList&)>& p_record)
+	{
+		const unsigned int grain = std::max(p_grain, 1u);
+		const unsigned int first = nbLists;
+		for (unsigned int begin = 0; begin < p_count; begin += grain)
+			NextList();
+		addOpen = false;
+
+		// The chunks of ParallelFor start on the multiples of the grain
+		Core::JobSystem::ParallelFor(p_count, grain, [this, first, grain, &p_record](unsigned int p_begin, unsigned int p_end)
+		{
+			p_record(p_begin, p_end, lists[first + p_begin / grain]);
+		});
+	}
+
+	RenderList& RenderQueue::NextList()
+	{
+		if (nbLists == lists.size())
+			lists.emplace_back();
+
+		RenderList& list = lists[nbLists++];
+		list.Clear();
+		return list;
+	}
+
+	void RenderQueue::Gather()
+	{
+		std::vector<unsigned int> offsets(nbLists + 1, 0);
+		for (unsigned int i = 0; i < nbLists; i++)
+			offsets[i + 1] = offsets[i] + (unsigned int)lists[i].GetDraws().size();
+
+		// The draws stay in their list, each list writes its own range
+		commands.resize(offsets[nbLists]);
+		draws.resize(offsets[nbLists]);
+		Core::JobSystem::ParallelFor(nbLists, 1, [this, &offsets](unsigned int p_begin, unsigned int p_end)
+		{
+			for (unsigned int i = p_begin; i < p_end; i++)
+			{
+				const std::vector<uint64_t>& keys = lists[i].GetKeys();
+				for (unsigned int draw = 0; draw < keys.size(); draw++)
+				{
+					commands[offsets[i] + draw] = RenderCommand{ keys[draw], offsets[i] + draw };
+					draws[offsets[i] + draw] = &lists[i].GetDraws()[draw];
+				}
+			}
+		});
+
+		for (unsigned int i = 0; i < nbLists; i++)
+		{
+			for (const std::pair<Resources::Texture*, float>& size : lists[i].GetScreenSizes())
+				size.first->RequestScreenSize(size.second);
+		}
+	}
+
+	void RenderQueue::Sort()
+	{
+		Gather();
+		RadixSort(commands, sorted);
+		BuildBatches();
+	}
+
+	void RenderQueue::BuildBatches()
+	{
+		// Same pass, shader, texture and mesh as the command before : only the depth differ
+		batchStarts.resize(commands.size());
+		Core::JobSystem::ParallelFor((unsigned int)commands.size(), SORT_GRAIN, [this](unsigned int p_begin, unsigned int p_end)
+		{
+			for (unsigned int i = p_begin; i < p_end; i++)
+			{
+				if (i == 0 || (commands[i].key >> 16) != (commands[i - 1].key >> 16))
+				{
+					batchStarts[i] = 1;
+					continue;
+				}
+				const RenderDraw& draw = *draws[commands[i].draw];
+				const RenderDraw& previous = *draws[commands[i - 1].draw];
+				batchStarts[i] = draw.shader != previous.shader || draw.texture != previous.texture || draw.mesh != previous.mesh;
+			}
+		});
+
+		batches.clear();
+		unsigned int nbInstances = 0;
+		for (unsigned int first = 0; first < commands.size();)
+		{
+			unsigned int last = first + 1;
+			while (last < commands.size() && !batchStarts[last])
+				last++;
+
+			// Indirect, every draw reads its matrices from the instances
+			RenderBatch batch{ first, last - first, nbInstances };
+			if (indirect || (instancing && batch.nbDraws >= MIN_INSTANCES))
+				nbInstances += batch.nbDraws;
+			batches.push_back(batch);
+			first = last;
+		}
+
+		// Each chunk of commands fills the instances of its part of the batches
+		instances.clear();
+		instances.resize(nbInstances);
+		Core::JobSystem::ParallelFor((unsigned int)commands.size(), SORT_GRAIN, [this](unsigned int p_begin, unsigned int p_end)
+		{
+			std::vector<RenderBatch>::const_iterator batch = std::upper_bound(batches.begin(), batches.end(), p_begin,
+				[](unsigned int p_command, const RenderBatch& p_batch) { return p_command < p_batch.first; }) - 1;
+
+			for (; batch != batches.end() && batch->first < p_end; batch++)
+			{
+				if (!indirect && !(instancing && batch->nbDraws >= MIN_INSTANCES))
+					continue;
+
+				const unsigned int last = std::min(batch->first + batch->nbDraws, p_end);
+				for (unsigned int i = std::max(batch->first, p_begin); i < last; i++)
+				{
+					const RenderDraw& draw = *draws[commands[i].draw];
+					instances[batch->firstInstance + i - batch->first] = Resources::InstanceData(*draw.transform, *draw.normalMatrix);
+				}
+			}
+		});
+	}
+
+	void RenderQueue::Submit(const Resources::ShaderDefines& p_defines, const Core::Maths::Mat4& p_viewProjection)
+	{
+		stats = RenderQueueStats();
+		stats.nbDraws = (unsigned int)commands.size();
+
+		if (!instances.empty())
+		{
+			if (!instanceBuffer)
+				glGenBuffers(1, &instanceBuffer);
+
+			glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+			glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(Resources::InstanceData), instances.data(), GL_STREAM_DRAW);
+
+			if (instancedFrom != p_defines.GetKey())
+			{
+				instancedFrom = p_defines.GetKey();
+				instancedDefines = p_defines;
+				instancedDefines.Set(INSTANCED_DEFINE);
+			}
+		}
+
+		if (indirect)
+		{
+			SubmitIndirect(p_viewProjection);
+			return;
+		}
+
+		Resources::Shader* shader = nullptr;
+		Resources::Texture* texture = nullptr;
+		Resources::Mesh* mesh = nullptr;
+		bool instanced = false;
+
+		for (const RenderBatch& batch : batches)
+		{
+			const RenderDraw& first = *draws[commands[batch.first].draw];
+			const bool instancedBatch = instancing && batch.nbDraws >= MIN_INSTANCES;
+
+			if (first.shader != shader || instancedBatch != instanced)
+			{
+				shader = first.shader;
+				instanced = instancedBatch;
+				shader->Use(instanced ? instancedDefines : p_defines);
+				texture = nullptr; // The texture uniforms belong to the program
+				stats.nbShaderChanges++;
+			}
+
+			if (first.texture != texture)
+			{
+				texture = first.texture;
+				texture->Draw(*shader);
+				stats.nbTextureChanges++;
+			}
+
+			if (first.mesh != mesh)
+			{
+				mesh = first.mesh;
+				mesh->Bind();
+				stats.nbMeshChanges++;
+			}
+
+			if (instanced)
+			{
+				mesh->BindInstances(batch.firstInstance * sizeof(Resources::InstanceData));
+				shader->DrawInstances(p_viewProjection);
+				mesh->DrawInstances(batch.nbDraws);
+				stats.nbDrawCalls++;
+				stats.nbInstanced += batch.nbDraws;
+				continue;
+			}
+
+			for (unsigned int i = batch.first; i < batch.first + batch.nbDraws; i++)
+			{
+				const RenderDraw& draw = *draws[commands[i].draw];
+				shader->Draw(*draw.transform, *draw.normalMatrix, draw.mvp);
+				mesh->DrawElements();
+				stats.nbDrawCalls++;
+			}
+		}
+	}
+
+	void RenderQueue::SubmitIndirect(const Core::Maths::Mat4& p_viewProjection)
+	{
+		BuildIndirect(batches, commands, draws, arena, indirectCommands, runs);
+		if (runs.empty())
+			return;
+
+		if (!indirectBuffer)
+			glGenBuffers(1, &indirectBuffer);
+
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+		glBufferData(GL_DRAW_INDIRECT_BUFFER, indirectCommands.size() * sizeof(DrawElementsIndirectCommand), indirectCommands.data(), GL_STREAM_DRAW);
+
+		// Once per frame : the base instance of each command offsets the instanced attributes
+		arena.Bind();
+		glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+		Resources::Mesh::BindInstances(0);
+		stats.nbMeshChanges = 1;
+		stats.nbInstanced = stats.nbDraws;
+
+		Resources::Shader* shader = nullptr;
+		for (const IndirectRun& run : runs)
+		{
+			if (run.shader != shader)
+			{
+				shader = run.shader;
+				shader->Use(instancedDefines);
+				shader->DrawInstances(p_viewProjection);
+				stats.nbShaderChanges++;
+			}
+
+			// Following runs of a shader have another texture
+			run.texture->Draw(*shader);
+			stats.nbTextureChanges++;
+
+			glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (void*)(run.firstCommand * sizeof(DrawElementsIndirectCommand)), run.nbCommands, 0);
+			stats.nbDrawCalls++;
+		}
+	}
+
+	void RenderQueue::BuildIndirect(const std::vector<RenderBatch>& p_batches, const std::vector<RenderCommand>& p_commands, const std::vector<const RenderDraw*>& p_draws,
+		Resources::MeshArena& p_arena, std::vector<DrawElementsIndirectCommand>& p_indirectCommands, std::vector<IndirectRun>& p_runs)
+	{
+		p_indirectCommands.clear();
+		p_runs.clear();
+
+		for (const RenderBatch& batch : p_batches)
+		{
+			const RenderDraw& draw = *p_draws[p_commands[batch.first].draw];
+			const Resources::ArenaRange& range = p_arena.Add(*draw.mesh);
+			p_indirectCommands.push_back(DrawElementsIndirectCommand{ (uint32_t)range.nbIndices, batch.nbDraws, (uint32_t)range.firstIndex, (int32_t)range.firstVertex, batch.firstInstance });
+
+			// Sorted by shader then texture : a run ends with them
+			if (p_runs.empty() || p_runs.back().shader != draw.shader || p_runs.back().texture != draw.texture)
+				p_runs.push_back(IndirectRun{ draw.shader, draw.texture, (unsigned int)p_indirectCommands.size() - 1, 0 });
+			p_runs.back().nbCommands++;
+		}
+	}
+
+	uint64_t RenderQueue::MakeKey(const RenderPass p_pass, const int p_shader, const int p_texture, const int p_mesh, const float p_depth)
+	{
+		// The bits of a positive float sort as the float, the 16 high bits keep the exponent and 7 bits of mantissa
+		const float depth = std::max(p_depth, 0.f);
+		uint32_t depthBits;
+		memcpy(&depthBits, &depth, sizeof(depthBits));
+		uint64_t depthKey = depthBits >> 16;
+		if (p_pass == RenderPass::Transparent)
+			depthKey = 0xFFFF - depthKey;
+
+		return ((uint64_t)p_pass & 0xF) << 60
+			| ((uint64_t)p_shader & 0xFFF) << 48
+			| ((uint64_t)p_texture & 0xFFFF) << 32
+			| ((uint64_t)p_mesh & 0xFFFF) << 16
+			| depthKey;
+	}
+
+	void RenderQueue::RadixSort(std::vector<RenderCommand>& p_commands, std::vector<RenderCommand>& p_buffer)
+	{
+		// Least significant byte first, stable : 8 passes of counting sort at most.
+		// Each chunk counts its bytes, then writes after the same bytes of the chunks before it
+		const unsigned int count = (unsigned int)p_commands.size();
+		const unsigned int nbChunks = (count + SORT_GRAIN - 1) / SORT_GRAIN;
+		std::vector<unsigned int> offsets(nbChunks * 256);
+		p_buffer.resize(p_commands.size());
+
+		for (unsigned int shift = 0; shift < 64; shift += 8)
+		{
+			std::fill(offsets.begin(), offsets.end(), 0);
+			Core::JobSystem::ParallelFor(count, SORT_GRAIN, [&p_commands, &offsets, shift](unsigned int p_begin, unsigned int p_end)
+			{
+				unsigned int* chunkOffsets = &offsets[p_begin / SORT_GRAIN * 256];
+				for (unsigned int i = p_begin; i < p_end; i++)
+					chunkOffsets[(p_commands[i].key >> shift) & 0xFF]++;
+			});
+
+			// Every key has the same byte : the pass would not move anything
+			const unsigned int byte = (p_commands.empty() ? 0 : p_commands[0].key >> shift) & 0xFF;
+			unsigned int nbSame = 0;
+			for (unsigned int chunk = 0; chunk < nbChunks; chunk++)
+				nbSame += offsets[chunk * 256 + byte];
+			if (nbSame == count)
+				continue;
+
+			unsigned int offset = 0;
+			for (unsigned int value = 0; value < 256; value++)
+			{
+				for (unsigned int chunk = 0; chunk < nbChunks; chunk++)
+				{
+					const unsigned int nb = offsets[chunk * 256 + value];
+					offsets[chunk * 256 + value] = offset;
+					offset += nb;
+				}
+			}
+
+			Core::JobSystem::ParallelFor(count, SORT_GRAIN, [&p_commands, &p_buffer, &offsets, shift](unsigned int p_begin, unsigned int p_end)
+			{
+				unsigned int* chunkOffsets = &offsets[p_begin / SORT_GRAIN * 256];
+				for (unsigned int i = p_begin; i < p_end; i++)
+					p_buffer[chunkOffsets[(p_commands[i].key >> shift) & 0xFF]++] = p_commands[i];
+			});
+
+			p_commands.swap(p_buffer);
+		}
+	}
+}
\ No newline at end of file
@@ -1,49 +1,373 @@
 #include "ResourcesManager.hpp"
 
+#include <filesystem>
+#include <algorithm>
+#include <functional>
+#include <fstream>
+#include <unordered_set>
+
+#include "AssetPack.hpp"
+#include "ImGUI/imgui.h"
+
 namespace Resources
 {
 	ResourceManager::ResourceManager()
-		: resources()
+		: shards()
+		, nextId(0)
+		, sources()
+		, nbShared(0)
+		, bytesShared(0)
 	{
 	}
 
 	void ResourceManager::Delete(const std::string p_name)
 	{
-		resources.erase(p_name);
+		std::shared_ptr<IResource> resource;
+		{
+			ResourceShard& shard = GetShard(p_name);
+			Core::ScopedLock lock(shard.lock);
+			auto it = shard.resources.find(p_name);
+			if (it == shard.resources.end())
+				return;
+
+			resource = std::move(it->second);
+			shard.resources.erase(it);
+		}
+
+		// Released outside of the lock, the destructor can be long (OpenGL objects)
+		resource.reset();
 		Core::Debug::Log::Print("Delete element " + p_name + " from resources\n", Core::Debug::LogLevel::Notification);
 	}
 
 	void ResourceManager::DeleteResources()
 	{
-		std::unordered_map<std::string, std::unique_ptr<IResource>>::iterator it = resources.begin();
 		std::vector<std::string> nameResourceToDelete;
 
-		while (it != resources.end())
+		for (const ResourceShard& shard : shards)
 		{
-			const std::string nameResource = it->first;
-			
-			if (nameResource != "Menu" && nameResource != "Credit" && nameResource != "Setting")
-				nameResourceToDelete.push_back(nameResource);
-
-			it++;
+			Core::ScopedSharedLock lock(shard.lock);
+			for (const auto& [nameResource, resource] : shard.resources)
+			{
+				if (nameResource != "Menu" && nameResource != "Credit" && nameResource != "Setting")
+					nameResourceToDelete.push_back(nameResource);
+			}
 		}
 
 		for (std::string name : nameResourceToDelete)
 			Delete(name);
+		atlas.Clear();
+		streamer.Clear();
+
+		Core::ScopedLock lock(sourcesLock);
+		sources.clear();
+		nbShared = 0;
+		bytesShared = 0;
+		FileCache::Clear();
+	}
+
+	bool ResourceManager::MountPack(const std::string& p_path)
+	{
+		std::shared_ptr<AssetPack> pack = std::make_shared<AssetPack>();
+		if (!pack->Mount(p_path))
+			return false;
+
+		FileCache::Mount(pack);
+		return true;
+	}
+
+	void ResourceManager::UnmountPack()
+	{
+		FileCache::Mount(nullptr);
+	}
+
+	const bool ResourceManager::CheckAllResourcesLoaded() const
+	{
+		for (const ResourceShard& shard : shards)
+		{
+			Core::ScopedSharedLock lock(shard.lock);
+			for (const auto& [name, resource] : shard.resources)
+			{
+				if (resource->GetStat() != StatResource::LOADED)
+					return false;
+			}
+		}
+
+		return true;
 	}
 
-	const bool ResourceManager::CheckAllResourcesLoaded()
+	std::vector<IResource*> ResourceManager::GetResourcesFromPath(const std::string& p_path) const
 	{
-		std::unordered_map<std::string, std::unique_ptr<IResource>>::iterator it = resources.begin();
+		const std::string path = FileCache::Canonicalize(p_path);
+		std::vector<IResource*> result;
 
-		while (it != resources.end())
+		for (const ResourceShard& shard : shards)
 		{
-			if (it->second.get()->GetStat() != StatResource::LOADED)
-				return false;
+			Core::ScopedSharedLock lock(shard.lock);
+			for (const auto& [name, resource] : shard.resources)
+			{
+				const bool usePath = (!resource->GetPath1().empty() && FileCache::Canonicalize(resource->GetPath1()) == path)
+					|| (!resource->GetPath2().empty() && FileCache::Canonicalize(resource->GetPath2()) == path)
+					|| resource->DependsOn(path);
 
-			it++;
+				// Shared resources are listed once
+				if (usePath && std::find(result.begin(), result.end(), resource.get()) == result.end())
+					result.push_back(resource.get());
+			}
 		}
 
+		return result;
+	}
+
+	void ResourceManager::PrintSharingReport()
+	{
+		const FileCacheStats stats = FileCache::GetStats();
+
+		Core::ScopedLock lock(sourcesLock);
+		Core::Debug::Log::Print("---------\n", Core::Debug::LogLevel::None);
+		Core::Debug::Log::Print(std::to_string(nbShared) + " resources shared with another name, "
+			+ std::to_string(bytesShared / 1024) + " KB of source not loaded twice\n", Core::Debug::LogLevel::Notification);
+		Core::Debug::Log::Print(std::to_string(stats.nbRead) + " files read (" + std::to_string(stats.bytesRead / 1024) + " KB), "
+			+ std::to_string(stats.nbShared) + " reads shared (" + std::to_string(stats.bytesSaved / 1024) + " KB saved)\n", Core::Debug::LogLevel::Notification);
+	}
+
+	MemoryReport ResourceManager::GetMemoryReport() const
+	{
+		std::vector<std::shared_ptr<IResource>> loaded;
+		std::unordered_set<const IResource*> alreadyIn;
+
+		for (const ResourceShard& shard : shards)
+		{
+			Core::ScopedSharedLock lock(shard.lock);
+			for (const auto& [name, resource] : shard.resources)
+			{
+				// Resources in loading are still written by the workers
+				if (alreadyIn.insert(resource.get()).second && resource->GetStat() == StatResource::LOADED)
+					loaded.push_back(resource);
+			}
+		}
+
+		MemoryReport report;
+		std::vector<const IResource*> used;
+
+		auto addResource = [&report](const IResource& p_resource)
+		{
+			const ResourceMemory memory = p_resource.GetMemoryUsage();
+			report.resources.push_back({ p_resource.GetName(), p_resource.GetTypeName(), memory });
+			report.types[p_resource.GetTypeName()] += memory;
+			report.total += memory;
+		};
+
+		for (const std::shared_ptr<IResource>& resource : loaded)
+		{
+			addResource(*resource);
+
+			used.clear();
+			resource->GetUsedResources(used);
+			if (used.empty())
+				continue;
+
+			ResourceMemory& scene = report.scenes[resource->GetName()];
+			for (const IResource* usedResource : used)
+			{
+				if (usedResource->GetStat() != StatResource::LOADED)
+					continue;
+				scene += usedResource->GetMemoryUsage();
+
+				// Owned by the scene itself (static batch meshes) : counted once in the totals too
+				if (alreadyIn.insert(usedResource).second)
+					addResource(*usedResource);
+			}
+		}
+
+		std::sort(report.resources.begin(), report.resources.end(), [](const ResourceMemoryEntry& p_a, const ResourceMemoryEntry& p_b)
+			{ return p_a.memory.cpu + p_a.memory.gpu > p_b.memory.cpu + p_b.memory.gpu; });
+
+		return report;
+	}
+
+	bool ResourceManager::DumpMemoryReport(const std::string& p_path) const
+	{
+		const MemoryReport report = GetMemoryReport();
+
+		std::ofstream file(p_path, std::ios::out | std::ios::trunc);
+		if (!file)
+		{
+			Core::Debug::Log::Print("Fail to write memory report " + p_path + "\n", Core::Debug::LogLevel::Warning);
+			return false;
+		}
+
+		auto memoryToJson = [](const ResourceMemory& p_memory)
+		{
+			return "\"cpu\": " + std::to_string(p_memory.cpu) + ", \"gpu\": " + std::to_string(p_memory.gpu);
+		};
+
+		auto groupToJson = [&memoryToJson](std::ofstream& p_file, const std::map<std::string, ResourceMemory>& p_group)
+		{
+			p_file << "{";
+			for (auto it = p_group.begin(); it != p_group.end(); it++)
+				p_file << (it == p_group.begin() ? "\n" : ",\n") << "\t\t\"" << it->first << "\": { " << memoryToJson(it->second) << " }";
+			p_file << "\n\t}";
+		};
+
+		// Names are resource names, they never contain characters to escape
+		file << "{\n\t\"total\": { " << memoryToJson(report.total) << " },\n";
+		file << "\t\"types\": ";
+		groupToJson(file, report.types);
+		file << ",\n\t\"scenes\": ";
+		groupToJson(file, report.scenes);
+		file << ",\n\t\"resources\": [";
+		for (size_t i = 0; i < report.resources.size(); i++)
+		{
+			const ResourceMemoryEntry& entry = report.resources[i];
+			file << (i == 0 ? "\n" : ",\n") << "\t\t{ \"name\": \"" << entry.name << "\", \"type\": \"" << entry.type << "\", " << memoryToJson(entry.memory) << " }";
+		}
+		file << "\n\t]\n}\n";
+
+		Core::Debug::Log::Print("Write memory report " + p_path + "\n", Core::Debug::LogLevel::Notification);
 		return true;
 	}
+
+	void ResourceManager::DrawMemoryWindow() const
+	{
+		const MemoryReport report = GetMemoryReport();
+		auto toKB = [](const size_t p_bytes) { return (float)p_bytes / 1024.f; };
+
+		ImGui::Begin("Memory");
+		ImGui::Text("Total : CPU %.1f KB, GPU %.1f KB", toKB(report.total.cpu), toKB(report.total.gpu));
+		ImGui::Text("Texture streaming : %u textures, %.1f / %.1f KB", streamer.GetNbTextures(), toKB(streamer.GetResidentSize()), toKB(streamer.GetBudget()));
+
+		auto drawGroup = [&toKB](const char* p_name, const std::map<std::string, ResourceMemory>& p_group)
+		{
+			if (!ImGui::CollapsingHeader(p_name, ImGuiTreeNodeFlags_DefaultOpen) || !ImGui::BeginTable(p_name, 3))
+				return;
+
+			ImGui::TableSetupColumn("Name");
+			ImGui::TableSetupColumn("CPU (KB)");
+			ImGui::TableSetupColumn("GPU (KB)");
+			ImGui::TableHeadersRow();
+			for (const auto& [name, memory] : p_group)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn(); ImGui::TextUnformatted(name.c_str());
+				ImGui::TableNextColumn(); ImGui::Text("%.1f", toKB(memory.cpu));
+				ImGui::TableNextColumn(); ImGui::Text("%.1f", toKB(memory.gpu));
+			}
+			ImGui::EndTable();
+		};
+
+		drawGroup("Types", report.types);
+		drawGroup("Scenes", report.scenes);
+
+		if (ImGui::CollapsingHeader("Resources") && ImGui::BeginTable("Resources", 4, ImGuiTableFlags_ScrollY, ImVec2(0.f, 300.f)))
+		{
+			ImGui::TableSetupColumn("Name");
+			ImGui::TableSetupColumn("Type");
+			ImGui::TableSetupColumn("CPU (KB)");
+			ImGui::TableSetupColumn("GPU (KB)");
+			ImGui::TableHeadersRow();
+			for (const ResourceMemoryEntry& entry : report.resources)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn(); ImGui::TextUnformatted(entry.name.c_str());
+				ImGui::TableNextColumn(); ImGui::TextUnformatted(entry.type.c_str());
+				ImGui::TableNextColumn(); ImGui::Text("%.1f", toKB(entry.memory.cpu));
+				ImGui::TableNextColumn(); ImGui::Text("%.1f", toKB(entry.memory.gpu));
+			}
+			ImGui::EndTable();
+		}
+
+		if (ImGui::Button("Dump"))
+			DumpMemoryReport(MEMORY_REPORT_PATH);
+
+		ImGui::End();
+	}
+
+	unsigned int ResourceManager::GetNbResources() const
+	{
+		unsigned int nbResources = 0;
+
+		for (const ResourceShard& shard : shards)
+		{
+			Core::ScopedSharedLock lock(shard.lock);
+			nbResources += shard.resources.size();
+		}
+
+		return nbResources;
+	}
+
+	ResourceShard& ResourceManager::GetShard(const std::string& p_name)
+	{
+		return shards[std::hash<std::string>{}(p_name) % NB_RESOURCE_SHARDS];
+	}
+
+	const ResourceShard& ResourceManager::GetShard(const std::string& p_name) const
+	{
+		return shards[std::hash<std::string>{}(p_name) % NB_RESOURCE_SHARDS];
+	}
+
+	IResource* ResourceManager::Find(const std::string& p_name) const
+	{
+		const ResourceShard& shard = GetShard(p_name);
+		Core::ScopedSharedLock lock(shard.lock);
+
+		auto it = shard.resources.find(p_name);
+		if (it == shard.resources.end())
+			return nullptr;
+
+		return it->second.get();
+	}
+
+	void ResourceManager::Insert(const std::string& p_name, const std::shared_ptr<IResource>& p_resource)
+	{
+		// A replaced resource is released after the shard is unlocked
+		std::shared_ptr<IResource> previous;
+		{
+			ResourceShard& shard = GetShard(p_name);
+			Core::ScopedLock lock(shard.lock);
+
+			auto [it, inserted] = shard.resources.try_emplace(p_name, p_resource);
+			if (!inserted)
+			{
+				previous = std::move(it->second);
+				it->second = p_resource;
+			}
+		}
+	}
+
+	std::string ResourceManager::GetSourceKey(const std::string& p_type, const std::string& p_path1, const std::string& p_path2) const
+	{
+		// Resources without file (scenes, primitives) are never shared
+		if (p_path1.empty() && p_path2.empty())
+			return "";
+
+		return p_type + '|' + FileCache::Canonicalize(p_path1) + '|' + FileCache::Canonicalize(p_path2);
+	}
+
+	IResource* ResourceManager::ShareResource(const std::string& p_name, const std::string& p_key)
+	{
+		// sourcesLock is locked by the caller
+		auto source = sources.find(p_key);
+		if (source == sources.end())
+			return nullptr;
+
+		std::shared_ptr<IResource> resource = source->second.lock();
+		if (!resource)
+			return nullptr;
+
+		// The same name registered again is not a new share
+		if (Find(p_name) == resource.get())
+			return resource.get();
+
+		Insert(p_name, resource);
+
+		for (const std::string& path : { resource->GetPath1(), resource->GetPath2() })
+		{
+			if (!path.empty())
+				bytesShared += FileCache::GetSourceSize(path);
+		}
+		nbShared++;
+
+		Core::Debug::Log::Print("Share element " + resource->GetName() + " with " + p_name + "\n", Core::Debug::LogLevel::Notification);
+		return resource.get();
+	}
 }
\ No newline at end of file
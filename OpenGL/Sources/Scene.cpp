@@ -1,11 +1,14 @@
 #include "Scene.hpp"
 
-#include "Imgui/imgui.h"
-#include "Imgui/imgui_impl_glfw.h"
-#include "Imgui/imgui_impl_opengl3.h"
+#include <algorithm>
+
+#include "ImGUI/imgui.h"
+#include "ImGUI/imgui_impl_glfw.h"
+#include "ImGUI/imgui_impl_opengl3.h"
 
 #include "Log.hpp"
 #include "App.hpp"
+#include "ResourcesManager.hpp"
 
 namespace Resources
 {
@@ -14,6 +17,7 @@ namespace Resources
 		, gameObjects()
 		, lightManager()
 		, graph(gameObjects)
+		, resources(nullptr)
 	{
 		name = p_name;
 		path1 = p_path1;
@@ -46,6 +50,15 @@ namespace Resources
 
 		m_physicsManager.UpdateCollision(p_deltaTime);
 		graph.Update(p_Inputs,p_deltaTime);
+
+		// Once every static object is loaded and placed by the update of the graph
+		if (!staticBatch.IsBuilt() && staticBatch.Build(gameObjects))
+		{
+			for (LowRenderer::GameObject* batch : staticBatch.GetBatches())
+				AddGameObject(batch);
+		}
+		else if (staticBatch.IsBuilt())
+			staticBatch.Update(); // After a hot reload of a merged mesh
 	}
 
 	void Scene::Draw(const Core::Inputs& p_Inputs, std::chrono::duration<double>& elapsedMono, std::chrono::duration<double>& elapsedMulti)
@@ -53,17 +66,46 @@ namespace Resources
 		StartImGui();
 
 		DrawTimer(elapsedMono, elapsedMulti);
-		graph.Draw(*camera, lightManager);
+
+		// Same camera for every pass of the frame
+		const LowRenderer::CameraState& cameraState = camera->GetState();
+		lightManager.AssignClusters(cameraState.view, cameraState.near, cameraState.far, cameraState.fovY, cameraState.aspect);
+		lightManager.Update(cameraState.position);
+
+		renderQueue.Clear();
+		graph.Draw(cameraState, renderQueue);
+		renderQueue.Sort();
+		renderQueue.Submit(lightManager.GetDefines(), cameraState.viewProjection);
 
 		if (p_Inputs.editor)
 		{
-			m_physicsManager.DrawColliders(camera->GetViewProjection());
+			m_physicsManager.DrawColliders(cameraState.viewProjection);
 			m_editor.DrawEditorWindow(graph);
+			if (resources)
+				resources->DrawMemoryWindow();
 		}
 
 		EndImGui();
 	}
 
+	void Scene::GetUsedResources(std::vector<const IResource*>& p_resources) const
+	{
+		std::vector<const LowRenderer::Model*> models;
+		for (const LowRenderer::GameObject* gameObject : gameObjects)
+			models.push_back(&gameObject->GetModel());
+		for (const Physics::Collider* collider : m_physicsManager.colliders)
+			models.push_back(&collider->m_meshCollider);
+
+		for (const LowRenderer::Model* model : models)
+		{
+			for (const IResource* resource : { (const IResource*)model->GetMesh(), (const IResource*)model->GetShader(), (const IResource*)model->GetTexture() })
+			{
+				if (resource && std::find(p_resources.begin(), p_resources.end(), resource) == p_resources.end())
+					p_resources.push_back(resource);
+			}
+		}
+	}
+
 	void Scene::AddGameObject(LowRenderer::GameObject* p_gameObject, LowRenderer::GOType p_type)
 	{
 		switch (p_type)
@@ -110,15 +152,19 @@ namespace Resources
 
 	void Scene::StartImGui() const
 	{
-		ImGui_ImplOpenGL3_NewFrame();
-		ImGui_ImplGlfw_NewFrame();
+		if (!Core::App::IsHeadless())
+		{
+			ImGui_ImplOpenGL3_NewFrame();
+			ImGui_ImplGlfw_NewFrame();
+		}
 		ImGui::NewFrame();
 	}
 
 	void Scene::EndImGui() const
 	{
 		ImGui::Render();
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		if (!Core::App::IsHeadless())
+			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 	}
 
 	void Scene::ReturnToMenu()
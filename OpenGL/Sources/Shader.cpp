@@ -4,13 +4,16 @@
 #include <GLFW/glfw3.h>
 
 #include "Assertion.hpp"
+#include "FileCache.hpp"
+#include "LightManager.hpp"
+
+#include <vector>
+#include <algorithm>
 
 namespace Resources
 {
 	Shader::Shader(const std::string& p_name, const std::string& p_path1, const std::string& p_path2, const unsigned int p_id)
-		: vertexShader(0)
-		, fragmentShader(0)
-		, shaderProgram(0)
+		: current(nullptr)
 	{
 		name = p_name;
 		path1 = p_path1;
@@ -18,121 +21,331 @@ namespace Resources
 		id = p_id;
 	}
 
+	Shader::~Shader()
+	{
+		for (const auto& [key, variant] : variants)
+			glDeleteProgram(variant.program);
+	}
+
 	void Shader::Init()
 	{
-		// Init Vertex
-		std::ifstream sourcefileV;
-		//std::string tempSourceV;
-		std::string lineV;
-		OpenShader(path1, sourcefileV);
-		while (std::getline(sourcefileV, lineV))
-			tempSourceV += "\n" + lineV;
-		CloseShader(path1, sourcefileV);
-		// sourceVertex = new const char* (tempSourceV.c_str());
-		sourceVertex = tempSourceV.c_str();
-
-		// Init Fragment
-		std::ifstream sourcefileF;
-		//std::string tempSourceF;
-		std::string lineF;
-		OpenShader(path2, sourcefileF);
-		while (std::getline(sourcefileF, lineF))
-			tempSourceF += "\n" + lineF;
-		CloseShader(path2, sourcefileF);
-		//sourceFragment = new const char* (tempSourceF.c_str());
-		sourceFragment = tempSourceF.c_str();
+		std::shared_ptr<const std::string> vertexFile = FileCache::Read(path1);
+		std::shared_ptr<const std::string> fragmentFile = FileCache::Read(path2);
+		if (!vertexFile || !fragmentFile)
+		{
+			stat = StatResource::FAILED;
+			return;
+		}
+
+		PreprocessedShader vertex = ShaderPreprocessor::ResolveIncludes(*vertexFile, path1, &FileCache::Read);
+		PreprocessedShader fragment = ShaderPreprocessor::ResolveIncludes(*fragmentFile, path2, &FileCache::Read);
+		for (const std::string* error : { &vertex.error, &fragment.error })
+		{
+			if (error->empty())
+				continue;
+
+			Core::Debug::Log::Print(*error + "\n", Core::Debug::LogLevel::Warning);
+			stat = StatResource::FAILED;
+			return;
+		}
+
+		sourceVertex = std::make_shared<const std::string>(std::move(vertex.source));
+		sourceFragment = std::make_shared<const std::string>(std::move(fragment.source));
+
+		includes.clear();
+		for (const std::vector<std::string>* files : { &vertex.files, &fragment.files })
+			includes.insert(includes.end(), files->begin() + 1, files->end());
 
 		stat = StatResource::INITIALIZED;
 	}
 
 	void Shader::InitOpenGL()
 	{
-		// build and compile our shader program
-		Assertion(SetVertexShader(), "Fail on SetVertexShader()");
-		Assertion(SetFragmentShader(), "Fail on SetFragmentShader()");
-		Assertion(Link(), "Fail on link shader");
+		// The variant without defines of the draw, the others are compiled on their first use.
+		// A reload compiles every variant in use before the swap : a failure keeps the live version.
+		reloadVariants.insert(reloadVariants.begin(), ShaderDefines());
+		for (const ShaderDefines& variantDefines : reloadVariants)
+		{
+			if (variants.find(variantDefines.GetKey()) == variants.end() && !CompileVariant(variantDefines))
+			{
+				stat = StatResource::FAILED;
+				return;
+			}
+		}
+		reloadVariants.clear();
+
+		current = &variants.at(ShaderDefines().GetKey());
 		stat = StatResource::LOADED;
 	}
 
-	void Shader::Draw(const Core::Maths::Mat4& p_transform, const Core::Maths::Mat4& p_mvp)
+	IResource* Shader::CreateReload() const
 	{
-		glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_TRUE, &p_transform.mat[0][0]);
-		glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "mvp"), 1, GL_TRUE, &p_mvp.mat[0][0]);
+		Shader* reload = new Shader(name, path1, path2, id);
+		reload->SetDefines(defines);
+		for (const auto& [key, variant] : variants)
+			reload->reloadVariants.push_back(variant.defines);
+		return reload;
 	}
 
-	bool Shader::SetVertexShader()
+	void Shader::SwapReload(IResource& p_reloaded)
 	{
-		// vertex shader
-		vertexShader = glCreateShader(GL_VERTEX_SHADER);
-		glShaderSource(vertexShader, 1, &sourceVertex, NULL);
-		glCompileShader(vertexShader);
+		// The other variants of the new sources are compiled again on their next use
+		Shader& reloaded = static_cast<Shader&>(p_reloaded);
+		std::swap(sourceVertex, reloaded.sourceVertex);
+		std::swap(sourceFragment, reloaded.sourceFragment);
+		includes.swap(reloaded.includes);
+		variants.swap(reloaded.variants);
+		std::swap(current, reloaded.current);
+	}
 
-		// check for shader compile errors
-		int success;
-		char infoLog[512];
-		glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-		if (!success)
+	ResourceMemory Shader::GetMemoryUsage() const
+	{
+		ResourceMemory memory;
+
+		if (sourceVertex)
+			memory.cpu += sourceVertex->size();
+		if (sourceFragment)
+			memory.cpu += sourceFragment->size();
+		for (const auto& [key, variant] : variants)
+			memory.gpu += variant.programSize;
+
+		return memory;
+	}
+
+	bool Shader::DependsOn(const std::string& p_canonicalPath) const
+	{
+		return stat == StatResource::LOADED && std::find(includes.begin(), includes.end(), p_canonicalPath) != includes.end();
+	}
+
+	void Shader::Draw(const Core::Maths::Mat4& p_transform, const Core::Maths::Mat4& p_normalMatrix, const Core::Maths::Mat4& p_mvp)
+	{
+		SetMat4(current->modelLocation, p_transform);
+		SetMat3(current->normalMatrixLocation, p_normalMatrix);
+		SetMat4(current->mvpLocation, p_mvp);
+	}
+
+	void Shader::DrawInstances(const Core::Maths::Mat4& p_viewProjection)
+	{
+		SetMat4(current->viewProjectionLocation, p_viewProjection);
+	}
+
+	void Shader::Use(const ShaderDefines& p_defines)
+	{
+		current = &GetVariant(p_defines);
+		glUseProgram(current->program);
+	}
+
+	int Shader::GetLocation(const uint64_t p_name) const
+	{
+		if (!current)
+			return -1;
+
+		auto it = current->uniforms.find(p_name);
+		return it != current->uniforms.end() ? it->second : -1;
+	}
+
+	void Shader::SetInt(const int p_location, const int p_value)
+	{
+		if (p_location != -1)
+			glUniform1i(p_location, p_value);
+	}
+
+	void Shader::SetFloat(const int p_location, const float p_value)
+	{
+		if (p_location != -1)
+			glUniform1f(p_location, p_value);
+	}
+
+	void Shader::SetVec3(const int p_location, const Core::Maths::Vec3& p_value)
+	{
+		if (p_location != -1)
+			glUniform3f(p_location, p_value.x, p_value.y, p_value.z);
+	}
+
+	void Shader::SetVec4(const int p_location, const Core::Maths::Vec4& p_value)
+	{
+		if (p_location != -1)
+			glUniform4f(p_location, p_value.x, p_value.y, p_value.z, p_value.w);
+	}
+
+	void Shader::SetMat3(const int p_location, const Core::Maths::Mat4& p_value)
+	{
+		if (p_location == -1)
+			return;
+
+		const float value[9] = {
+			p_value.mat[0][0], p_value.mat[0][1], p_value.mat[0][2],
+			p_value.mat[1][0], p_value.mat[1][1], p_value.mat[1][2],
+			p_value.mat[2][0], p_value.mat[2][1], p_value.mat[2][2] };
+		glUniformMatrix3fv(p_location, 1, GL_TRUE, value);
+	}
+
+	void Shader::SetMat4(const int p_location, const Core::Maths::Mat4& p_value)
+	{
+		if (p_location != -1)
+			glUniformMatrix4fv(p_location, 1, GL_TRUE, &p_value.mat[0][0]);
+	}
+
+	const ShaderDefines& Shader::GetEngineDefines()
+	{
+		static const ShaderDefines engineDefines = []()
 		{
-			glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-			DEBUG_LOG("ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" + *infoLog);
-			return false;
+			ShaderDefines defines;
+			defines.Set("MAX_DIRECTION_LIGHT", (int)LowRenderer::MAX_DIRECTION_LIGHT);
+			defines.Set("CLUSTER_X", (int)LowRenderer::CLUSTER_X);
+			defines.Set("CLUSTER_Y", (int)LowRenderer::CLUSTER_Y);
+			defines.Set("CLUSTER_Z", (int)LowRenderer::CLUSTER_Z);
+			return defines;
+		}();
+
+		return engineDefines;
+	}
+
+	ShaderVariant& Shader::GetVariant(const ShaderDefines& p_defines)
+	{
+		auto it = variants.find(p_defines.GetKey());
+		if (it != variants.end())
+			return it->second;
+
+		ShaderVariant* variant = CompileVariant(p_defines);
+		Assertion(variant, "Fail on shader " + name);
+		return *variant;
+	}
+
+	ShaderVariant* Shader::CompileVariant(const ShaderDefines& p_defines)
+	{
+		ShaderDefines variantDefines = GetEngineDefines();
+		variantDefines.Merge(defines);
+		variantDefines.Merge(p_defines);
+
+		// build and compile our shader program
+		ShaderVariant variant;
+		variant.defines = p_defines;
+		const int vertexShader = Compile(GL_VERTEX_SHADER, ShaderPreprocessor::InjectDefines(*sourceVertex, variantDefines));
+		const int fragmentShader = Compile(GL_FRAGMENT_SHADER, ShaderPreprocessor::InjectDefines(*sourceFragment, variantDefines));
+		if (!vertexShader || !fragmentShader)
+		{
+			glDeleteShader(vertexShader);
+			glDeleteShader(fragmentShader);
+			Core::Debug::Log::Print("Fail to compile shader " + name + " (" + path1 + ", " + path2 + ")\n", Core::Debug::LogLevel::Warning);
+			return nullptr;
 		}
-		return true;
+		if (!Link(variant, vertexShader, fragmentShader))
+		{
+			glDeleteProgram(variant.program);
+			Core::Debug::Log::Print("Fail to link shader " + name + "\n", Core::Debug::LogLevel::Warning);
+			return nullptr;
+		}
+
+		Core::Debug::Log::Print("Shader " + name + " : variant " + std::to_string(variants.size()) + " compiled\n", Core::Debug::LogLevel::Notification);
+		return &variants.emplace(p_defines.GetKey(), std::move(variant)).first->second;
 	}
 
-	bool Shader::SetFragmentShader()
+	int Shader::Compile(const int p_type, const std::string& p_source) const
 	{
-		// fragment shader
-		fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-		glShaderSource(fragmentShader, 1, &sourceFragment, NULL);
-		glCompileShader(fragmentShader);
+		const int shader = glCreateShader(p_type);
+		const char* source = p_source.c_str();
+		glShaderSource(shader, 1, &source, NULL);
+		glCompileShader(shader);
 
 		// check for shader compile errors
 		int success;
 		char infoLog[512];
-		glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
 		if (!success)
 		{
-			glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-			DEBUG_LOG("ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" + *infoLog);
-			return false;
+			glGetShaderInfoLog(shader, 512, NULL, infoLog);
+			DEBUG_LOG(std::string(p_type == GL_VERTEX_SHADER ? "ERROR::SHADER::VERTEX" : "ERROR::SHADER::FRAGMENT") + "::COMPILATION_FAILED\n" + infoLog);
+			glDeleteShader(shader);
+			return 0;
 		}
-		return true;
+		return shader;
 	}
 
-	bool Shader::Link()
+	bool Shader::Link(ShaderVariant& p_variant, const int p_vertexShader, const int p_fragmentShader) const
 	{
 		// link shaders
-		shaderProgram = glCreateProgram();
-		glAttachShader(shaderProgram, vertexShader);
-		glAttachShader(shaderProgram, fragmentShader);
-		glLinkProgram(shaderProgram);
+		p_variant.program = glCreateProgram();
+		glAttachShader(p_variant.program, p_vertexShader);
+		glAttachShader(p_variant.program, p_fragmentShader);
+		glLinkProgram(p_variant.program);
+		glDeleteShader(p_vertexShader);
+		glDeleteShader(p_fragmentShader);
 
 		// check for linking errors
 		int success;
 		char infoLog[512];
-		glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
+		glGetProgramiv(p_variant.program, GL_LINK_STATUS, &success);
 		if (!success) {
-			glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-			DEBUG_LOG("ERROR::SHADER::PROGRAM::LINKING_FAILED\n" + *infoLog);
+			glGetProgramInfoLog(p_variant.program, 512, NULL, infoLog);
+			DEBUG_LOG(std::string("ERROR::SHADER::PROGRAM::LINKING_FAILED\n") + infoLog);
 			return false;
 		}
 
-		glDeleteShader(vertexShader);
-		glDeleteShader(fragmentShader);
+		glGetProgramiv(p_variant.program, GL_PROGRAM_BINARY_LENGTH, &p_variant.programSize);
+		ReflectUniforms(p_variant);
+
+		// "#version 330" has no binding qualifier, the blocks are bound to their buffer here
+		const GLuint lightsBlock = glGetUniformBlockIndex(p_variant.program, "Lights");
+		if (lightsBlock != GL_INVALID_INDEX)
+			glUniformBlockBinding(p_variant.program, lightsBlock, LIGHTS_BLOCK_BINDING);
+
+		// Same for the units of the texture buffers, set once per program
+		const std::pair<uint64_t, unsigned int> textureBuffers[] = {
+			{ UniformHash("clusterLights"), CLUSTER_LIGHTS_TEXTURE_UNIT },
+			{ UniformHash("clusterGrid"), CLUSTER_GRID_TEXTURE_UNIT },
+			{ UniformHash("clusterLightIndices"), CLUSTER_INDICES_TEXTURE_UNIT } };
+		for (const auto& [name, unit] : textureBuffers)
+		{
+			auto it = p_variant.uniforms.find(name);
+			if (it != p_variant.uniforms.end())
+				glProgramUniform1i(p_variant.program, it->second, (GLint)unit);
+		}
+
 		return true;
 	}
 
-	void Shader::OpenShader(const std::string& p_path, std::ifstream& p_source)
+	void Shader::ReflectUniforms(ShaderVariant& p_variant) const
 	{
-		p_source.open(p_path, std::ios::in);
-		Assertion(p_source.is_open(), "Fail to open shader " + p_path);
-		Core::Debug::Log::Print("Open shader " + p_path + "\n", Core::Debug::LogLevel::Notification);
-	}
+		GLint nbUniforms = 0;
+		GLint maxLength = 0;
+		glGetProgramiv(p_variant.program, GL_ACTIVE_UNIFORMS, &nbUniforms);
+		glGetProgramiv(p_variant.program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+		std::vector<char> name((size_t)std::max(maxLength, 1));
 
-	void Shader::CloseShader(const std::string& p_path, std::ifstream& p_source)
-	{
-		p_source.close();
-		Core::Debug::Log::Print("Close shader " + p_path + "\n", Core::Debug::LogLevel::Notification);
+		for (GLint i = 0; i < nbUniforms; i++)
+		{
+			GLsizei length = 0;
+			GLint size = 0;
+			GLenum type = 0;
+			glGetActiveUniform(p_variant.program, (GLuint)i, (GLsizei)name.size(), &length, &size, &type, name.data());
+			std::string uniformName(name.data(), (size_t)length);
+
+			// Arrays of basic types are reported once as "name[0]", each element gets its own entry
+			const size_t arrayEnd = uniformName.size() > 3 ? uniformName.size() - 3 : std::string::npos;
+			if (arrayEnd != std::string::npos && uniformName.compare(arrayEnd, 3, "[0]") == 0)
+			{
+				const std::string arrayName = uniformName.substr(0, arrayEnd);
+				p_variant.uniforms[UniformHash(arrayName.c_str())] = glGetUniformLocation(p_variant.program, uniformName.c_str());
+				for (GLint element = 0; element < size; element++)
+				{
+					const std::string elementName = arrayName + '[' + std::to_string(element) + ']';
+					p_variant.uniforms[UniformHash(elementName.c_str())] = glGetUniformLocation(p_variant.program, elementName.c_str());
+				}
+			}
+			else
+			{
+				// Members of uniform blocks have no location
+				const GLint location = glGetUniformLocation(p_variant.program, uniformName.c_str());
+				if (location != -1)
+					p_variant.uniforms[UniformHash(uniformName.c_str())] = location;
+			}
+		}
+
+		auto location = [&p_variant](const uint64_t p_name) { auto it = p_variant.uniforms.find(p_name); return it != p_variant.uniforms.end() ? it->second : -1; };
+		p_variant.modelLocation = location(UniformHash("model"));
+		p_variant.mvpLocation = location(UniformHash("mvp"));
+		p_variant.normalMatrixLocation = location(UniformHash("normalMatrix"));
+		p_variant.viewProjectionLocation = location(UniformHash("viewProjection"));
 	}
 }
\ No newline at end of file
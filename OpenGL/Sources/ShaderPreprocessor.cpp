@@ -0,0 +1,175 @@
+#include "ShaderPreprocessor.hpp"
+
+#include <filesystem>
+#include <algorithm>
+
+#include "FileCache.hpp"
+
+namespace Resources
+{
+	// --------------------
+	//    Shader defines
+	// --------------------
+
+	ShaderDefines::ShaderDefines()
+		: key(0)
+	{
+		UpdateKey();
+	}
+
+	void ShaderDefines::Set(const std::string& p_name, const std::string& p_value)
+	{
+		defines[p_name] = p_value;
+		UpdateKey();
+	}
+
+	void ShaderDefines::Set(const std::string& p_name, const int p_value)
+	{
+		Set(p_name, std::to_string(p_value));
+	}
+
+	void ShaderDefines::Merge(const ShaderDefines& p_defines)
+	{
+		for (const auto& [name, value] : p_defines.defines)
+			defines[name] = value;
+		UpdateKey();
+	}
+
+	std::string ShaderDefines::GetLines() const
+	{
+		std::string lines;
+		for (const auto& [name, value] : defines)
+			lines += "#define " + name + (value.empty() ? "" : " " + value) + '\n';
+
+		return lines;
+	}
+
+	void ShaderDefines::UpdateKey()
+	{
+		std::string text;
+		for (const auto& [name, value] : defines)
+			text += name + '=' + value + '\n';
+
+		key = FileCache::Hash(text.data(), text.size());
+	}
+
+	// --------------------
+	//  Shader preprocessor
+	// --------------------
+
+	PreprocessedShader ShaderPreprocessor::ResolveIncludes(const std::string& p_source, const std::string& p_path, const ShaderReader& p_reader)
+	{
+		PreprocessedShader result;
+		result.files.push_back(FileCache::Canonicalize(p_path));
+		Include(p_source, p_path, p_reader, result);
+
+		return result;
+	}
+
+	std::string ShaderPreprocessor::InjectDefines(const std::string& p_source, const ShaderDefines& p_defines)
+	{
+		if (p_defines.IsEmpty())
+			return p_source;
+
+		// The #version line must stay the first one
+		size_t lineStart = 0;
+		unsigned int lineNumber = 1;
+		while (lineStart < p_source.size())
+		{
+			const size_t first = p_source.find_first_not_of(" \t", lineStart);
+			size_t lineEnd = p_source.find('\n', lineStart);
+			lineEnd = lineEnd == std::string::npos ? p_source.size() : lineEnd + 1;
+
+			if (first != std::string::npos && p_source.compare(first, 8, "#version") == 0)
+			{
+				// "#version 330" : the line after "#line n" is numbered n + 1
+				return p_source.substr(0, lineEnd) + (lineEnd == p_source.size() && p_source.back() != '\n' ? "\n" : "")
+					+ p_defines.GetLines() + "#line " + std::to_string(lineNumber) + " 0\n" + p_source.substr(lineEnd);
+			}
+
+			lineStart = lineEnd;
+			lineNumber++;
+		}
+
+		return p_defines.GetLines() + "#line 0 0\n" + p_source;
+	}
+
+	void ShaderPreprocessor::Include(const std::string& p_source, const std::string& p_path, const ShaderReader& p_reader, PreprocessedShader& p_result)
+	{
+		const unsigned int fileIndex = (unsigned int)p_result.files.size() - 1;
+		const std::filesystem::path directory = std::filesystem::path(p_path).parent_path();
+
+		size_t lineStart = 0;
+		unsigned int lineNumber = 1;
+		while (lineStart < p_source.size())
+		{
+			size_t lineEnd = p_source.find('\n', lineStart);
+			lineEnd = lineEnd == std::string::npos ? p_source.size() : lineEnd + 1;
+			const std::string line = p_source.substr(lineStart, lineEnd - lineStart);
+
+			std::string file;
+			const bool include = ParseInclude(line, file);
+			if (include && file.empty())
+			{
+				if (p_result.error.empty())
+					p_result.error = "Wrong #include in " + p_path + " : " + line.substr(0, line.find_last_not_of("\r\n") + 1);
+				p_result.source += '\n';
+			}
+			else if (!include)
+			{
+				p_result.source += line;
+				if (lineEnd == p_source.size() && line.back() != '\n')
+					p_result.source += '\n';
+			}
+			else
+			{
+				const std::string path = (directory / file).generic_string();
+				const std::string canonicalPath = FileCache::Canonicalize(path);
+
+				// Included once, like a #pragma once in every file
+				if (std::find(p_result.files.begin(), p_result.files.end(), canonicalPath) == p_result.files.end())
+				{
+					// Reported to the shader, a typo while editing must not stop the app
+					const std::shared_ptr<const std::string> content = p_reader(path);
+					if (!content)
+					{
+						if (p_result.error.empty())
+							p_result.error = "Fail to include " + path + " in " + p_path;
+						p_result.source += '\n';
+						lineStart = lineEnd;
+						lineNumber++;
+						continue;
+					}
+
+					p_result.files.push_back(canonicalPath);
+					p_result.source += "#line 0 " + std::to_string(p_result.files.size() - 1) + '\n';
+					Include(*content, path, p_reader, p_result);
+					p_result.source += "#line " + std::to_string(lineNumber) + ' ' + std::to_string(fileIndex) + '\n';
+				}
+				else
+				{
+					p_result.source += '\n';
+				}
+			}
+
+			lineStart = lineEnd;
+			lineNumber++;
+		}
+	}
+
+	bool ShaderPreprocessor::ParseInclude(const std::string& p_line, std::string& p_file)
+	{
+		size_t position = p_line.find_first_not_of(" \t");
+		if (position == std::string::npos || p_line[position] != '#')
+			return false;
+
+		position = p_line.find_first_not_of(" \t", position + 1);
+		if (position == std::string::npos || p_line.compare(position, 7, "include") != 0)
+			return false;
+
+		const size_t begin = p_line.find('"', position + 7);
+		const size_t end = begin == std::string::npos ? std::string::npos : p_line.find('"', begin + 1);
+		p_file = end == std::string::npos ? std::string() : p_line.substr(begin + 1, end - begin - 1);
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "StaticBatch.hpp"
+
+#include <algorithm>
+
+#include "Log.hpp"
+#include "JobSystem.hpp"
+
+namespace LowRenderer
+{
+	StaticBatch::StaticBatch()
+		: built(false)
+	{
+	}
+
+	bool StaticBatch::Build(const std::vector<GameObject*>& p_gameObjects)
+	{
+		groups.clear();
+		std::vector<GameObject*> sources;
+		for (GameObject* gameObject : p_gameObjects)
+		{
+			Model model = gameObject->GetModel();
+			if (!gameObject->IsStatic() || !model.isEnable)
+				continue;
+			if (!model.InitCheck())
+				return false;
+
+			Resources::Shader* shader = model.GetShader();
+			Resources::Texture* texture = model.GetTexture();
+			auto group = std::find_if(groups.begin(), groups.end(), [shader, texture, gameObject](const StaticGroup& p_group)
+				{ return p_group.shader == shader && p_group.texture == texture && p_group.occluder == gameObject->IsOccluder(); });
+			if (group == groups.end())
+				group = groups.insert(groups.end(), StaticGroup{ shader, texture, gameObject->IsOccluder(), {}, {}, {} });
+
+			group->meshes.push_back(model.GetMesh());
+			group->transforms.push_back(&gameObject->GetTransform());
+			sources.push_back(gameObject);
+		}
+
+		for (StaticGroup& group : groups)
+		{
+			std::unique_ptr<Resources::Mesh> mesh = MergeGroup(group, (unsigned int)meshes.size());
+			GameObject* batch = new GameObject(Model(mesh.get(), group.shader, group.texture), Physics::Transform(), mesh->GetName());
+			batch->SetOccluder(group.occluder);
+			batches.push_back(batch);
+			meshes.push_back(std::move(mesh));
+		}
+
+		for (GameObject* source : sources)
+			source->SetEnableModel(false);
+
+		Core::Debug::Log::Print("Static batch : " + std::to_string(sources.size()) + " objects merged in " + std::to_string(batches.size()) + " meshes\n", Core::Debug::LogLevel::Notification);
+		built = true;
+		return true;
+	}
+
+	unsigned int StaticBatch::Update()
+	{
+		unsigned int nbMerged = 0;
+		for (size_t i = 0; i < groups.size(); i++)
+		{
+			StaticGroup& group = groups[i];
+			bool reloaded = false;
+			for (size_t j = 0; j < group.meshes.size() && !reloaded; j++)
+				reloaded = group.meshes[j]->GetVertexBuffer().data() != group.sources[j];
+			if (!reloaded)
+				continue;
+
+			// Swapped as a hot reload : the batch keeps its mesh, the previous buffers leave with the merged one
+			std::unique_ptr<Resources::Mesh> merged = MergeGroup(group, (unsigned int)i);
+			meshes[i]->SwapReload(*merged);
+			nbMerged++;
+		}
+
+		if (nbMerged > 0)
+			Core::Debug::Log::Print("Static batch : " + std::to_string(nbMerged) + " meshes merged again\n", Core::Debug::LogLevel::Notification);
+		return nbMerged;
+	}
+
+	std::unique_ptr<Resources::Mesh> StaticBatch::MergeGroup(StaticGroup& p_group, const unsigned int p_index) const
+	{
+		std::unique_ptr<Resources::Mesh> mesh = std::make_unique<Resources::Mesh>("StaticBatch" + std::to_string(p_index), "", "", STATIC_BATCH_MESH_ID + p_index);
+		Merge(p_group.meshes, p_group.transforms, mesh->GetVertexBuffer(), mesh->GetIndexBuffer());
+		mesh->Init();
+		mesh->InitOpenGL();
+
+		p_group.sources.clear();
+		for (const Resources::Mesh* source : p_group.meshes)
+			p_group.sources.push_back(source->GetVertexBuffer().data());
+		return mesh;
+	}
+
+	void StaticBatch::Merge(const std::vector<const Resources::Mesh*>& p_meshes, const std::vector<const Physics::Transform*>& p_transforms,
+		std::vector<Resources::Vertex>& p_vertices, std::vector<unsigned int>& p_indices)
+	{
+		std::vector<size_t> vertexOffsets(p_meshes.size() + 1, 0);
+		std::vector<size_t> indexOffsets(p_meshes.size() + 1, 0);
+		for (size_t i = 0; i < p_meshes.size(); i++)
+		{
+			vertexOffsets[i + 1] = vertexOffsets[i] + p_meshes[i]->GetVertexBuffer().size();
+			indexOffsets[i + 1] = indexOffsets[i] + p_meshes[i]->GetIndexBuffer().size();
+		}
+		p_vertices.resize(vertexOffsets.back());
+		p_indices.resize(indexOffsets.back());
+
+		// Each mesh to its own range
+		Core::JobSystem::ParallelFor((unsigned int)p_meshes.size(), 1, [&](unsigned int p_begin, unsigned int p_end)
+		{
+			for (unsigned int i = p_begin; i < p_end; i++)
+			{
+				const float (&m)[4][4] = p_transforms[i]->matrix.mat;
+				const float (&n)[4][4] = p_transforms[i]->normalMatrix.mat;
+				const std::vector<Resources::Vertex>& vertices = p_meshes[i]->GetVertexBuffer();
+				for (size_t vertex = 0; vertex < vertices.size(); vertex++)
+				{
+					const Core::Maths::Vec3& p = vertices[vertex].position;
+					const Core::Maths::Vec3& normal = vertices[vertex].normal;
+					Resources::Vertex& merged = p_vertices[vertexOffsets[i] + vertex];
+
+					merged.position = Core::Maths::Vec3(
+						m[0][0] * p.x + m[0][1] * p.y + m[0][2] * p.z + m[0][3],
+						m[1][0] * p.x + m[1][1] * p.y + m[1][2] * p.z + m[1][3],
+						m[2][0] * p.x + m[2][1] * p.y + m[2][2] * p.z + m[2][3]);
+					merged.normal = Core::Maths::Vec3(
+						n[0][0] * normal.x + n[0][1] * normal.y + n[0][2] * normal.z,
+						n[1][0] * normal.x + n[1][1] * normal.y + n[1][2] * normal.z,
+						n[2][0] * normal.x + n[2][1] * normal.y + n[2][2] * normal.z);
+					merged.normal.Normalize();
+					merged.uv = vertices[vertex].uv;
+				}
+
+				const std::vector<unsigned int>& indices = p_meshes[i]->GetIndexBuffer();
+				for (size_t index = 0; index < indices.size(); index++)
+					p_indices[indexOffsets[i] + index] = indices[index] + (unsigned int)vertexOffsets[i];
+			}
+		});
+	}
+}
\ No newline at end of file
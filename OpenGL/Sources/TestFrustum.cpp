@@ -0,0 +1,76 @@
+#include "TestFrustum.hpp"
+
+#include <random>
+
+#include "Frustum.hpp"
+#include "Assertion.hpp"
+
+using namespace LowRenderer;
+
+namespace Core::Debug
+{
+	// Projection of the Camera : 100 degrees, near 0.1, far 100
+	static Core::Maths::Mat4 GetTestViewProjection()
+	{
+		const float near = 0.1f, far = 100.f;
+		const float a = 1.f / tanf(Core::Maths::DEG2RAD * 100.f / 2.f);
+		const Core::Maths::Mat4 projection(
+			a / (16.f / 9.f), 0.f, 0.f,							 0.f,
+			0.f,			  a,   0.f,							 0.f,
+			0.f,			  0.f, -(far + near) / (far - near), -(2 * far * near) / (far - near),
+			0.f,			  0.f, -1.f,						 0.f);
+
+		// Camera at (0, 0, 5) looking toward -z
+		return projection * Core::Maths::Mat4::CreateTranslationMatrix(Core::Maths::Vec3(0.f, 0.f, -5.f));
+	}
+
+	void TestFrustum()
+	{
+		TestFrustumPlanes();
+		TestFrustumCulling();
+		Log::Print("Frustum : OK\n", Core::Debug::LogLevel::Test);
+	}
+
+	void TestFrustumPlanes()
+	{
+		const Frustum frustum = Frustum::FromViewProjection(GetTestViewProjection());
+
+		// Near and far planes face each other along z, 99.9 apart
+		const Plane& near = frustum.planes[4];
+		const Plane& far = frustum.planes[5];
+		Assertion(std::abs(near.normal.z + 1.f) < 1e-4f && std::abs(far.normal.z - 1.f) < 1e-4f, "fail on frustum planes : near and far normals");
+		Assertion(std::abs(near.distance - 4.9f) < 1e-3f && std::abs(far.distance - 95.f) < 1e-2f, "fail on frustum planes : near and far distances");
+
+		BoundingSpheres spheres;
+		spheres.Add(Core::Maths::Vec3(0.f, 0.f, -10.f), 1.f);  // In front
+		spheres.Add(Core::Maths::Vec3(0.f, 0.f, 10.f), 1.f);   // Behind
+		spheres.Add(Core::Maths::Vec3(0.f, 0.f, 5.5f), 1.f);   // Around the camera
+		spheres.Add(Core::Maths::Vec3(0.f, 0.f, -200.f), 1.f); // Beyond far
+		spheres.Add(Core::Maths::Vec3(300.f, 0.f, -10.f), 1.f); // Right
+
+		std::vector<unsigned int> visible;
+		CullSpheres(frustum, spheres, visible);
+		Assertion(visible == std::vector<unsigned int>({ 0, 2 }), "fail on frustum planes : culled spheres");
+	}
+
+	void TestFrustumCulling()
+	{
+		// Every batch width and a tail, the SIMD results match the scalar reference
+		std::mt19937 random(7);
+		std::uniform_real_distribution<float> position(-150.f, 150.f);
+		std::uniform_real_distribution<float> size(0.f, 10.f);
+		const Frustum frustum = Frustum::FromViewProjection(GetTestViewProjection());
+
+		for (const unsigned int count : { 0u, 3u, 4u, 13u, 1000u, 1003u })
+		{
+			BoundingSpheres spheres;
+			for (unsigned int i = 0; i < count; i++)
+				spheres.Add(Core::Maths::Vec3(position(random), position(random), position(random)), size(random));
+
+			std::vector<unsigned int> visible, expected;
+			CullSpheres(frustum, spheres, visible);
+			CullSpheresScalar(frustum, spheres, expected);
+			Assertion(visible == expected, "fail on frustum culling : " + std::to_string(count) + " spheres");
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,223 @@
+#include "TestLightManager.hpp"
+
+#include <cstring>
+#include <cmath>
+#include <random>
+#include <algorithm>
+
+#include "LightManager.hpp"
+#include "JobSystem.hpp"
+#include "Assertion.hpp"
+
+using namespace LowRenderer;
+
+namespace Core::Debug
+{
+	float TestBlockFloat(const UniformBlock& p_block, const size_t p_offset)
+	{
+		float value;
+		memcpy(&value, p_block.GetData() + p_offset, sizeof(float));
+		return value;
+	}
+
+	int32_t TestBlockInt(const UniformBlock& p_block, const size_t p_offset)
+	{
+		int32_t value;
+		memcpy(&value, p_block.GetData() + p_offset, sizeof(int32_t));
+		return value;
+	}
+
+	// Packing only, the block is never uploaded. The offsets are the ones the driver gives for std140.
+	void TestLightManager()
+	{
+		TestStd140Scalars();
+		TestStd140Structs();
+		TestLightsBlock();
+		TestLightRange();
+		TestLightClusters();
+		TestLightClustersCoverage();
+		Log::Print("LightManager : OK\n", Core::Debug::LogLevel::Test);
+	}
+
+	void TestStd140Scalars()
+	{
+		UniformBlock block;
+		Assertion(block.AddFloat(1.f) == 0, "fail on std140 : float");
+		Assertion(block.AddVec3(Maths::Vec3(1.f, 2.f, 3.f)) == 16, "fail on std140 : vec3 aligned on 16");
+		Assertion(block.AddFloat(4.f) == 28, "fail on std140 : float after a vec3");
+		Assertion(block.AddVec4(Maths::Vec4()) == 32, "fail on std140 : vec4");
+		Assertion(block.AddInt(5) == 48, "fail on std140 : int");
+		Assertion(block.AddVec3(Maths::Vec3()) == 64, "fail on std140 : vec3 after an int");
+		Assertion(block.GetSize() == 76, "fail on std140 : size " + std::to_string(block.GetSize()));
+
+		Assertion(TestBlockFloat(block, 20) == 2.f && TestBlockFloat(block, 28) == 4.f && TestBlockInt(block, 48) == 5, "fail on std140 : values");
+		Assertion(TestBlockFloat(block, 4) == 0.f, "fail on std140 : padding not zero");
+	}
+
+	void TestStd140Structs()
+	{
+		UniformBlock block;
+		block.AddFloat(1.f);
+
+		// struct { vec3 a; float b; } s[2]; float c;
+		for (unsigned int i = 0; i < 2; i++)
+		{
+			Assertion(block.BeginStruct() == 16 + i * 16, "fail on std140 : struct " + std::to_string(i) + " start");
+			block.AddVec3(Maths::Vec3());
+			Assertion(block.AddFloat(2.f) == 28 + i * 16, "fail on std140 : struct " + std::to_string(i) + " member");
+			block.EndStruct();
+		}
+		Assertion(block.AddFloat(3.f) == 48, "fail on std140 : member after an array of structs");
+
+		// struct { float a; } s; float b; : the struct is still rounded to 16
+		block.BeginStruct();
+		block.AddFloat(4.f);
+		block.EndStruct();
+		Assertion(block.AddFloat(5.f) == 80, "fail on std140 : member after a small struct");
+	}
+
+	void TestLightsBlock()
+	{
+		LightManager lights;
+		const InitLight initLight{ Maths::Vec3(1.f, 2.f, 3.f), Maths::Vec4(0.1f, 0.1f, 0.1f, 1.f), Maths::Vec4(1.f, 1.f, 1.f, 1.f), Maths::Vec4(0.5f, 0.5f, 0.5f, 1.f) };
+		lights.AddDirectionLight(DirectionLight(initLight, Maths::Vec3(0.f, -1.f, 0.f)));
+		lights.AddPointLight(PointLight(initLight, 1.f, 0.09f, 0.032f));
+		lights.AddPointLight(PointLight(initLight, 1.f, 0.7f, 1.8f));
+		lights.AddSpotLight(SpotLight(initLight, Maths::Vec3(0.f, 0.f, -1.f), 60.f, 0.5f));
+
+		UniformBlock block;
+		lights.Pack(block, Maths::Vec3(7.f, 8.f, 9.f));
+
+		// Offsets written in Lights.glsl
+		Assertion(block.GetSize() == 464, "fail on lights block : size " + std::to_string(block.GetSize()));
+		Assertion(TestBlockFloat(block, 8) == 9.f, "fail on lights block : viewPos");
+		Assertion(TestBlockInt(block, 12) == 1 && TestBlockInt(block, 16) == 2 && TestBlockInt(block, 20) == 1, "fail on lights block : number of lights");
+		Assertion(TestBlockFloat(block, 32) == 0.1f, "fail on lights block : ambient of the spot lights");
+
+		const size_t direction = 64;
+		Assertion(TestBlockFloat(block, direction + 4) == 2.f, "fail on lights block : direction light position");
+		Assertion(TestBlockFloat(block, direction + 48) == 0.5f, "fail on lights block : direction light specular");
+		Assertion(TestBlockFloat(block, direction + 68) == -1.f, "fail on lights block : direction");
+		Assertion(TestBlockFloat(block, direction + 80 + 4) == 0.f, "fail on lights block : unused direction light");
+
+		// Texels read by GetPointLight and GetSpotLight
+		std::vector<Maths::Vec4> texels;
+		lights.PackLights(texels);
+		Assertion(texels.size() == 3 * LIGHT_TEXELS, "fail on lights texels : size");
+		Assertion(texels[0].w == 1.f && texels[LIGHT_TEXELS + 4].x == 0.7f && texels[LIGHT_TEXELS + 4].y == 1.8f, "fail on lights texels : point light attenuation");
+		Assertion(fabsf(texels[2 * LIGHT_TEXELS].w - 0.5f) < 1e-6f && texels[2 * LIGHT_TEXELS + 4].w == 0.5f && texels[2 * LIGHT_TEXELS + 4].z == -1.f, "fail on lights texels : spot light");
+	}
+
+	void TestLightRange()
+	{
+		const InitLight initLight{ Maths::Vec3(), Maths::Vec4(0.1f, 0.1f, 0.1f, 1.f), Maths::Vec4(1.f, 0.5f, 0.5f, 1.f), Maths::Vec4(0.5f, 0.5f, 0.5f, 1.f) };
+		for (PointLight light : { PointLight(initLight, 1.f, 0.09f, 0.032f), PointLight(initLight, 1.f, 0.7f, 1.8f), PointLight(initLight, 1.f, 0.5f, 0.f) })
+		{
+			const float range = light.GetRange();
+			const float attenuation = 1.f / (1.f + light.GetLinear() * range + light.GetQuadratic() * range * range);
+			Assertion(range > 0.f && fabsf(attenuation - LIGHT_CUTOFF) < 1e-4f, "fail on light range : " + std::to_string(range));
+		}
+
+		Assertion(PointLight(initLight, 100.f, 0.f, 1.f).GetRange() == 0.f, "fail on light range : never lit");
+	}
+
+	// Cluster holding a view position, as GetCluster in Lights.glsl
+	static unsigned int TestGetCluster(const LightClusters& p_clusters, const Maths::Vec3& p_position, const float p_tanHalfFovY, const float p_aspect)
+	{
+		const float depth = -p_position.z;
+		const float screenX = p_position.x / (depth * p_tanHalfFovY * p_aspect) * 0.5f + 0.5f;
+		const float screenY = p_position.y / (depth * p_tanHalfFovY) * 0.5f + 0.5f;
+		const int x = std::clamp((int)(screenX * CLUSTER_X), 0, (int)CLUSTER_X - 1);
+		const int y = std::clamp((int)(screenY * CLUSTER_Y), 0, (int)CLUSTER_Y - 1);
+		return LightClusters::GetClusterIndex(x, y, p_clusters.GetSlice(depth));
+	}
+
+	static bool TestClusterHasLight(const LightClusters& p_clusters, const unsigned int p_cluster, const uint32_t p_light)
+	{
+		const uint32_t* first = p_clusters.GetIndices().data() + p_clusters.GetGrid()[p_cluster * 2];
+		const uint32_t* last = first + p_clusters.GetGrid()[p_cluster * 2 + 1];
+		return std::find(first, last, p_light) != last;
+	}
+
+	void TestLightClusters()
+	{
+		const float tanHalfFovY = tanf(Maths::DEG2RAD * 50.f), aspect = 16.f / 9.f;
+		LightClusters clusters;
+		clusters.SetProjection(0.1f, 100.f, 100.f, aspect);
+		clusters.Build({
+			ClusterLight::Point(Maths::Vec3(0.f, 0.f, -10.f), 1.f),	 // In front
+			ClusterLight::Point(Maths::Vec3(0.f, 0.f, 10.f), 1.f),	 // Behind
+			ClusterLight::Point(Maths::Vec3(0.f, 0.f, -300.f), 5.f), // Beyond far
+			ClusterLight::Spot(Maths::Vec3(0.f, 5.f, -20.f), Maths::Vec3(0.f, -1.f, 0.f), Maths::DEG2RAD * 10.f, 100.f) });
+
+		const unsigned int inFront = TestGetCluster(clusters, Maths::Vec3(0.f, 0.f, -10.f), tanHalfFovY, aspect);
+		Assertion(TestClusterHasLight(clusters, inFront, 0), "fail on light clusters : point light");
+		Assertion(!TestClusterHasLight(clusters, TestGetCluster(clusters, Maths::Vec3(0.f, 0.f, -50.f), tanHalfFovY, aspect), 0), "fail on light clusters : behind the point light");
+		Assertion(!TestClusterHasLight(clusters, TestGetCluster(clusters, Maths::Vec3(-10.f, 0.f, -10.f), tanHalfFovY, aspect), 0), "fail on light clusters : beside the point light");
+
+		// Under the spot, not beside it
+		Assertion(TestClusterHasLight(clusters, TestGetCluster(clusters, Maths::Vec3(0.f, -2.f, -20.f), tanHalfFovY, aspect), 3), "fail on light clusters : in the cone");
+		Assertion(!TestClusterHasLight(clusters, TestGetCluster(clusters, Maths::Vec3(15.f, -2.f, -20.f), tanHalfFovY, aspect), 3), "fail on light clusters : out of the cone");
+
+		for (unsigned int cluster = 0; cluster < NB_CLUSTERS; cluster++)
+			Assertion(!TestClusterHasLight(clusters, cluster, 1) && !TestClusterHasLight(clusters, cluster, 2), "fail on light clusters : light out of the frustum");
+	}
+
+	void TestLightClustersCoverage()
+	{
+		// Every point lit by a light is in a cluster listing it, the same lists on the workers and on one thread
+		std::mt19937 random(7);
+		std::uniform_real_distribution<float> unit(-1.f, 1.f);
+		std::uniform_real_distribution<float> depth(0.5f, 80.f);
+		std::uniform_real_distribution<float> size(0.5f, 8.f);
+		std::uniform_real_distribution<float> angle(0.1f, 1.4f);
+		const float tanHalfFovY = tanf(Maths::DEG2RAD * 50.f), aspect = 16.f / 9.f;
+
+		std::vector<ClusterLight> lights;
+		for (unsigned int i = 0; i < 300; i++)
+		{
+			const float z = -depth(random);
+			const Maths::Vec3 position(unit(random) * -z * tanHalfFovY * aspect * 1.2f, unit(random) * -z * tanHalfFovY * 1.2f, z);
+			if (i % 3)
+				lights.push_back(ClusterLight::Point(position, size(random)));
+			else
+			{
+				Maths::Vec3 direction(unit(random), unit(random), unit(random));
+				direction.Normalize();
+				lights.push_back(ClusterLight::Spot(position, direction, angle(random), size(random) * 2.f));
+			}
+		}
+
+		LightClusters clusters, threaded;
+		clusters.SetProjection(0.1f, 100.f, 100.f, aspect);
+		threaded.SetProjection(0.1f, 100.f, 100.f, aspect);
+		clusters.Build(lights);
+		Core::JobSystem::Start(3);
+		threaded.Build(lights);
+		Core::JobSystem::Stop();
+		Assertion(clusters.GetGrid() == threaded.GetGrid() && clusters.GetIndices() == threaded.GetIndices(), "fail on light clusters : workers");
+		Assertion(clusters.GetNbOverflows() == 0, "fail on light clusters : overflow");
+
+		for (uint32_t i = 0; i < lights.size(); i++)
+		{
+			const ClusterLight& light = lights[i];
+			for (unsigned int sample = 0; sample < 50; sample++)
+			{
+				// In the volume of the light
+				const Maths::Vec3 offset = Maths::Vec3(unit(random), unit(random), unit(random)) * (light.isSpot ? light.range : light.radius);
+				if (offset.Magnitude() > (light.isSpot ? light.range : light.radius))
+					continue;
+				const Maths::Vec3 point = (light.isSpot ? light.position : light.center) + offset;
+				if (light.isSpot && offset.DotProduct(light.direction) < offset.Magnitude() * light.cosAngle)
+					continue;
+
+				// In the frustum
+				const float pointDepth = -point.z;
+				if (pointDepth < 0.1f || pointDepth > 100.f || fabsf(point.x) > pointDepth * tanHalfFovY * aspect || fabsf(point.y) > pointDepth * tanHalfFovY)
+					continue;
+
+				Assertion(TestClusterHasLight(clusters, TestGetCluster(clusters, point, tanHalfFovY, aspect), i), "fail on light clusters : light " + std::to_string(i) + " missing");
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "TestMeshArena.hpp"
+
+#include "MeshArena.hpp"
+#include "RenderQueue.hpp"
+#include "GLRecorder.hpp"
+#include "Assertion.hpp"
+
+using namespace LowRenderer;
+
+namespace Core::Debug
+{
+	static void TestFillMesh(Resources::Mesh& p_mesh, const unsigned int p_nbVertices)
+	{
+		for (unsigned int i = 0; i < p_nbVertices; i++)
+			p_mesh.GetVertexBuffer().push_back({ Core::Maths::Vec3((float)i, 0.f, 0.f), Core::Maths::Vec3(0.f, 0.f, 1.f), Core::Maths::Vec2(0.f, 0.f) });
+		for (unsigned int i = 0; i + 2 < p_nbVertices; i++)
+			p_mesh.GetIndexBuffer().insert(p_mesh.GetIndexBuffer().end(), { i, i + 1, i + 2 });
+	}
+
+	// The arena and the indirect commands run on the recorder, no OpenGL context
+	void TestMeshArena()
+	{
+		TestArenaAllocator();
+		TestMeshArenaAdd();
+		TestMeshArenaFragmented();
+		TestRenderIndirect();
+		Log::Print("MeshArena : OK\n", Core::Debug::LogLevel::Test);
+	}
+
+	void TestArenaAllocator()
+	{
+		Resources::ArenaAllocator allocator(100);
+		const size_t a = allocator.Allocate(30), b = allocator.Allocate(30), c = allocator.Allocate(30);
+		Assertion(a == 0 && b == 30 && c == 60 && allocator.GetUsed() == 90, "fail on arena allocator : allocate");
+		Assertion(allocator.Allocate(20) == Resources::ARENA_FULL && allocator.Allocate(0) == 0, "fail on arena allocator : full");
+
+		// First fit in the hole left by b
+		allocator.Free(b, 30);
+		Assertion(allocator.GetNbFreeRanges() == 2, "fail on arena allocator : free");
+		Assertion(allocator.Allocate(25) == 30 && allocator.GetNbFreeRanges() == 2, "fail on arena allocator : first fit");
+
+		// Merged with both neighbours
+		allocator.Free(a, 30);
+		allocator.Free(c, 30);
+		allocator.Free(30, 25);
+		Assertion(allocator.GetNbFreeRanges() == 1 && allocator.GetUsed() == 0, "fail on arena allocator : merge");
+
+		allocator.Allocate(80);
+		allocator.Grow(200);
+		Assertion(allocator.GetCapacity() == 200 && allocator.GetNbFreeRanges() == 1, "fail on arena allocator : grow");
+		Assertion(allocator.Allocate(120) == 80 && allocator.GetUsed() == 200, "fail on arena allocator : after grow");
+	}
+
+	void TestMeshArenaAdd()
+	{
+		GLRecorder recorder;
+		Resources::Mesh quad("Quad", "", "", 1), strip("Strip", "", "", 2), big("Big", "", "", 3);
+		TestFillMesh(quad, 4);
+		TestFillMesh(strip, 10);
+		TestFillMesh(big, (unsigned int)Resources::ARENA_VERTICES);
+
+		Resources::MeshArena arena;
+		const Resources::ArenaRange first = arena.Add(quad);
+		const Resources::ArenaRange second = arena.Add(strip);
+		Assertion(first.firstVertex == 0 && first.nbVertices == 4 && first.firstIndex == 0 && first.nbIndices == 6, "fail on mesh arena : first range");
+		Assertion(second.firstVertex == 4 && second.nbVertices == 10 && second.firstIndex == 6 && second.nbIndices == 24, "fail on mesh arena : second range");
+
+		// Already in the arena : nothing uploaded
+		GLRecorder::Reset();
+		arena.Add(quad);
+		Assertion(GLRecorder::GetCalls().bufferUpload == 0, "fail on mesh arena : added twice");
+
+		// Full : new buffers twice as large, the two meshes copied on the GPU
+		arena.Add(big);
+		Assertion(arena.GetVertices().GetCapacity() == 2 * Resources::ARENA_VERTICES && arena.GetVertices().GetUsed() == 14 + Resources::ARENA_VERTICES, "fail on mesh arena : grow");
+		Assertion(GLRecorder::GetCalls().bufferUpload == 6, "fail on mesh arena : grow uploads " + std::to_string(GLRecorder::GetCalls().bufferUpload));
+		Assertion(arena.Add(strip).firstVertex == 4, "fail on mesh arena : range kept by the grow");
+
+		// Reloaded with another size : moved to a new range
+		TestFillMesh(quad, 4);
+		const Resources::ArenaRange reloaded = arena.Add(quad);
+		Assertion(reloaded.nbVertices == 8 && reloaded.firstVertex == 14 + Resources::ARENA_VERTICES, "fail on mesh arena : reload");
+
+		arena.Remove(big);
+		Assertion(arena.GetVertices().GetUsed() == 18 && arena.GetIndices().GetUsed() == 36, "fail on mesh arena : remove");
+
+		// A deleted mesh gives its range back
+		{
+			Resources::Mesh deleted("Deleted", "", "", 4);
+			TestFillMesh(deleted, 6);
+			arena.Add(deleted);
+			Assertion(arena.GetNbMeshes() == 3, "fail on mesh arena : add before delete");
+		}
+		Assertion(arena.GetNbMeshes() == 2 && arena.GetVertices().GetUsed() == 18, "fail on mesh arena : deleted mesh");
+	}
+
+	void TestMeshArenaFragmented()
+	{
+		GLRecorder recorder;
+		Resources::Mesh first("First", "", "", 1), second("Second", "", "", 2), large("Large", "", "", 3);
+		TestFillMesh(first, 30000);
+		TestFillMesh(second, 30000);
+		TestFillMesh(large, 32000);
+
+		// Enough free elements in total, but in the hole of the first mesh and the tail
+		Resources::MeshArena arena;
+		arena.Add(first);
+		arena.Add(second);
+		arena.Remove(first);
+		Assertion(arena.GetVertices().GetCapacity() - arena.GetVertices().GetUsed() >= large.GetVertexBuffer().size(), "fail on mesh arena fragmented : free elements");
+
+		const Resources::ArenaRange range = arena.Add(large);
+		Assertion(range.firstVertex == 60000 && range.firstIndex == 2 * first.GetIndexBuffer().size(), "fail on mesh arena fragmented : range after the tail");
+		Assertion(arena.GetVertices().GetCapacity() == 2 * Resources::ARENA_VERTICES && arena.GetIndices().GetCapacity() == 2 * Resources::ARENA_INDICES, "fail on mesh arena fragmented : grow");
+	}
+
+	void TestRenderIndirect()
+	{
+		GLRecorder recorder;
+
+		Resources::Shader shader("TestRenderQueue", "Resources/Shaders/VertexShaderSource.vert", "Resources/Shaders/FragmentShaderSource.frag", 1);
+		shader.Init();
+		shader.InitOpenGL();
+		Resources::Texture wall("Wall", "", "", 2), sample("Sample", "", "", 3);
+		Resources::Mesh cube("Cube", "", "", 4), sphere("Sphere", "", "", 5);
+		TestFillMesh(cube, 4);
+		TestFillMesh(sphere, 5);
+		Model box(&cube, &shader, &wall), crate(&cube, &shader, &sample), ball(&sphere, &shader, &sample);
+		const Core::Maths::Mat4 identity = Core::Maths::Mat4::Identity();
+
+		// Three boxes, then a crate and a ball alone : three commands, one multi-draw per texture
+		RenderQueue queue;
+		queue.SetIndirect(true);
+		queue.Add(box, identity, identity, identity);
+		queue.Add(ball, identity, identity, identity);
+		queue.Add(box, identity, identity, identity);
+		queue.Add(crate, identity, identity, identity);
+		queue.Add(box, identity, identity, identity);
+		queue.Sort();
+		Assertion(queue.GetInstances().size() == 5, "fail on render indirect : every draw instanced");
+
+		// The second frame only draws : the arena and the instanced variant are ready
+		queue.Submit(Resources::ShaderDefines(), identity);
+		GLRecorder::Reset();
+		queue.Submit(Resources::ShaderDefines(), identity);
+		const std::vector<DrawElementsIndirectCommand>& commands = queue.GetIndirectCommands();
+		const std::vector<IndirectRun>& runs = queue.GetIndirectRuns();
+		Assertion(commands.size() == 3 && runs.size() == 2 && runs[1].firstCommand == 1 && runs[1].nbCommands == 2, "fail on render indirect : runs");
+
+		const DrawElementsIndirectCommand& boxes = commands[0];
+		const DrawElementsIndirectCommand& balls = commands[2];
+		Assertion(boxes.count == 6 && boxes.instanceCount == 3 && boxes.firstIndex == 0 && boxes.baseVertex == 0 && boxes.baseInstance == 0, "fail on render indirect : boxes");
+		Assertion(commands[1].firstIndex == 0 && commands[1].baseInstance == 3, "fail on render indirect : crate shares the mesh");
+		Assertion(balls.count == 9 && balls.instanceCount == 1 && balls.firstIndex == 6 && balls.baseVertex == 4 && balls.baseInstance == 4, "fail on render indirect : ball");
+
+		const GLCalls& calls = GLRecorder::GetCalls();
+		Assertion(calls.draw == 2 && calls.indices == 6 * 3 + 6 + 9, "fail on render indirect : draw calls");
+		Assertion(calls.useProgram == 1 && calls.bindVertexArray == 1 && calls.bufferUpload == 2 && queue.GetStats().nbInstanced == 5, "fail on render indirect : binds");
+	}
+}
\ No newline at end of file
@@ -395,6 +395,7 @@ namespace Core::Debug
         TestRotationYMat4();
         TestRotationZMat4();
         TestScaleMat4();
+        TestNormalMatrixMat4();
         Log::Print("Mat4 : OK\n", Core::Debug::LogLevel::Test);
     }
 
@@ -472,4 +473,22 @@ namespace Core::Debug
 
         Assertion(myResult == glmResult, "fail on scale : " + myResult.ToString() + "!=\n" + glmResult.ToString());
     }
-}
+
+    void TestNormalMatrixMat4()
+    {
+        // Non uniform scale : the normals are not transformed by the model matrix
+        glm::mat4 mat = glm::translate(glm::mat4(1.f), { 1.f, -2.f, 3.f });
+        mat = glm::rotate(mat, glm::radians(30.f), { 0.f, 1.f, 0.f });
+        mat = glm::rotate(mat, glm::radians(45.f), { 1.f, 0.f, 0.f });
+        mat = glm::scale(mat, { 2.f, 0.5f, 3.f });
+
+        Mat4 myResult = GlmMatToMat(mat).GetNormalMatrix();
+        Mat4 glmResult = GlmMatToMat(glm::mat4(glm::transpose(glm::inverse(glm::mat3(mat)))));
+
+        for (int i = 0; i < 4; i++)
+        {
+            for (int j = 0; j < 4; j++)
+                Assertion(fabsf(myResult.mat[i][j] - glmResult.mat[i][j]) < 1e-5f, "fail on normal matrix : " + myResult.ToString() + "!=\n" + glmResult.ToString());
+        }
+    }
+}
\ No newline at end of file
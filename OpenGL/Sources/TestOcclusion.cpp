@@ -0,0 +1,153 @@
+#include "TestOcclusion.hpp"
+
+#include <random>
+#include <algorithm>
+
+#include "OcclusionCulling.hpp"
+#include "JobSystem.hpp"
+#include "Assertion.hpp"
+
+using namespace LowRenderer;
+
+namespace Core::Debug
+{
+	// Projection of the Camera : 100 degrees, near 0.1, far 100, at (0, 0, 5) looking toward -z
+	static Core::Maths::Mat4 GetTestViewProjection()
+	{
+		const float near = 0.1f, far = 100.f;
+		const float a = 1.f / tanf(Core::Maths::DEG2RAD * 100.f / 2.f);
+		const Core::Maths::Mat4 projection(
+			a / (16.f / 9.f), 0.f, 0.f,							 0.f,
+			0.f,			  a,   0.f,							 0.f,
+			0.f,			  0.f, -(far + near) / (far - near), -(2 * far * near) / (far - near),
+			0.f,			  0.f, -1.f,						 0.f);
+
+		return projection * Core::Maths::Mat4::CreateTranslationMatrix(Core::Maths::Vec3(0.f, 0.f, -5.f));
+	}
+
+	// Cube from -1 to 1, as the one of the resources
+	static void GetTestBox(std::vector<Resources::Vertex>& p_vertices, std::vector<unsigned int>& p_indices)
+	{
+		p_vertices.clear();
+		for (unsigned int corner = 0; corner < 8; corner++)
+			p_vertices.push_back({ Core::Maths::Vec3(corner & 1 ? 1.f : -1.f, corner & 2 ? 1.f : -1.f, corner & 4 ? 1.f : -1.f), Core::Maths::Vec3(), Core::Maths::Vec2() });
+
+		p_indices = { 0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6, 0, 1, 4, 1, 5, 4, 2, 6, 3, 3, 6, 7, 0, 4, 2, 2, 4, 6, 1, 3, 5, 3, 7, 5 };
+	}
+
+	void TestOcclusion()
+	{
+		TestOcclusionRasterizer();
+		TestOcclusionPyramid();
+		TestOcclusionQueries();
+		TestOcclusionNearPlane();
+		Log::Print("Occlusion : OK\n", Core::Debug::LogLevel::Test);
+	}
+
+	void TestOcclusionRasterizer()
+	{
+		// Random triangles, some crossing the borders and the eye : the SIMD bands on the workers match the scalar reference
+		std::mt19937 random(7);
+		std::uniform_real_distribution<float> position(-30.f, 30.f);
+		std::vector<Resources::Vertex> vertices;
+		std::vector<unsigned int> indices;
+		for (unsigned int i = 0; i < 300; i++)
+		{
+			vertices.push_back({ Core::Maths::Vec3(position(random), position(random), position(random) - 30.f), Core::Maths::Vec3(), Core::Maths::Vec2() });
+			indices.push_back(i);
+		}
+
+		OcclusionBuffer simd, scalar;
+		simd.AddOccluder(vertices, indices, GetTestViewProjection());
+		scalar.AddOccluder(vertices, indices, GetTestViewProjection());
+		Assertion(simd.GetNbTriangles() > 0, "fail on occlusion rasterizer : no triangle");
+
+		Core::JobSystem::Start(3);
+		simd.Rasterize();
+		Core::JobSystem::Stop();
+		scalar.RasterizeScalar();
+
+		Assertion(simd.GetDepth() == scalar.GetDepth(), "fail on occlusion rasterizer : SIMD and scalar depths");
+		Assertion(std::count(simd.GetDepth().begin(), simd.GetDepth().end(), 1.f) < (long)simd.GetDepth().size(), "fail on occlusion rasterizer : nothing drawn");
+	}
+
+	void TestOcclusionPyramid()
+	{
+		std::vector<Resources::Vertex> vertices;
+		std::vector<unsigned int> indices;
+		GetTestBox(vertices, indices);
+
+		OcclusionBuffer buffer;
+		buffer.AddOccluder(vertices, indices, GetTestViewProjection() * Core::Maths::Mat4::CreateTranslationMatrix(Core::Maths::Vec3(3.f, 0.f, -10.f)));
+		buffer.Rasterize();
+		buffer.BuildPyramid();
+
+		// Each texel bounds the pixels it covers, down to a single one holding the whole buffer
+		const std::vector<OcclusionLevel>& pyramid = buffer.GetPyramid();
+		const std::vector<float>& depth = buffer.GetDepth();
+		const OcclusionLevel& top = pyramid.back();
+		Assertion(top.width == 1 && top.height == 1, "fail on occlusion pyramid : last level");
+		Assertion(top.minDepth[0] == *std::min_element(depth.begin(), depth.end()) && top.maxDepth[0] == 1.f, "fail on occlusion pyramid : min and max of the buffer");
+
+		for (size_t i = 1; i < pyramid.size(); i++)
+		{
+			const OcclusionLevel& fine = pyramid[i - 1];
+			const OcclusionLevel& level = pyramid[i];
+			for (unsigned int y = 0; y < fine.height; y++)
+			{
+				for (unsigned int x = 0; x < fine.width; x++)
+				{
+					const unsigned int texel = (y / 2) * level.width + x / 2;
+					Assertion(level.minDepth[texel] <= fine.minDepth[y * fine.width + x] && level.maxDepth[texel] >= fine.maxDepth[y * fine.width + x],
+						"fail on occlusion pyramid : level " + std::to_string(i));
+				}
+			}
+		}
+	}
+
+	void TestOcclusionQueries()
+	{
+		// Wall of 20 x 20 x 1 at z = -10, in the middle of the screen
+		std::vector<Resources::Vertex> vertices;
+		std::vector<unsigned int> indices;
+		GetTestBox(vertices, indices);
+
+		const Core::Maths::Mat4 viewProjection = GetTestViewProjection();
+		const Core::Maths::Mat4 wall = Core::Maths::Mat4::CreateTranslationMatrix(Core::Maths::Vec3(0.f, 0.f, -10.f))
+			* Core::Maths::Mat4::CreateScaleMatrix(Core::Maths::Vec3(10.f, 10.f, 0.5f));
+
+		OcclusionBuffer buffer;
+		buffer.AddOccluder(vertices, indices, viewProjection * wall);
+		buffer.Rasterize();
+		buffer.BuildPyramid();
+
+		Assertion(buffer.IsOccluded(Core::Maths::Vec3(0.f, 0.f, -20.f), 1.f, viewProjection), "fail on occlusion queries : behind the wall");
+		Assertion(buffer.IsOccluded(Core::Maths::Vec3(-4.f, 3.f, -11.f), 0.4f, viewProjection), "fail on occlusion queries : right behind the wall");
+		Assertion(!buffer.IsOccluded(Core::Maths::Vec3(0.f, 0.f, -5.f), 1.f, viewProjection), "fail on occlusion queries : in front of the wall");
+		Assertion(!buffer.IsOccluded(Core::Maths::Vec3(0.f, 0.f, -9.f), 1.f, viewProjection), "fail on occlusion queries : through the wall");
+		Assertion(!buffer.IsOccluded(Core::Maths::Vec3(25.f, 0.f, -20.f), 1.f, viewProjection), "fail on occlusion queries : beside the wall");
+		Assertion(!buffer.IsOccluded(Core::Maths::Vec3(16.f, 0.f, -20.f), 2.f, viewProjection), "fail on occlusion queries : across the edge of the wall");
+		Assertion(!buffer.IsOccluded(Core::Maths::Vec3(0.f, 0.f, 5.f), 1.f, viewProjection), "fail on occlusion queries : around the eye");
+	}
+
+	void TestOcclusionNearPlane()
+	{
+		// Floor just under the eye, from 0.02 in front of it (before the near plane) to 10 away
+		const std::vector<Resources::Vertex> vertices = {
+			{ Core::Maths::Vec3(0.f, -0.05f, 4.98f), Core::Maths::Vec3(), Core::Maths::Vec2() },
+			{ Core::Maths::Vec3(-10.f, -0.05f, -5.f), Core::Maths::Vec3(), Core::Maths::Vec2() },
+			{ Core::Maths::Vec3(10.f, -0.05f, -5.f), Core::Maths::Vec3(), Core::Maths::Vec2() } };
+		const std::vector<unsigned int> indices = { 0, 1, 2 };
+
+		const Core::Maths::Mat4 viewProjection = GetTestViewProjection();
+		OcclusionBuffer buffer;
+		buffer.AddOccluder(vertices, indices, viewProjection);
+		buffer.Rasterize();
+		buffer.BuildPyramid();
+
+		// Seen through the part of the floor closer than the near plane, that the GPU clips
+		Assertion(!buffer.IsOccluded(Core::Maths::Vec3(0.f, -0.4f, 4.5f), 0.05f, viewProjection), "fail on occlusion near plane : seen under the clipped floor");
+		Assertion(buffer.IsOccluded(Core::Maths::Vec3(0.f, -2.f, -5.f), 0.2f, viewProjection), "fail on occlusion near plane : under the drawn floor");
+		Assertion(*std::min_element(buffer.GetDepth().begin(), buffer.GetDepth().end()) >= 0.f, "fail on occlusion near plane : depth before the near plane");
+	}
+}
\ No newline at end of file
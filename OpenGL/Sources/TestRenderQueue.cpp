@@ -0,0 +1,203 @@
+#include "TestRenderQueue.hpp"
+
+#include <random>
+#include <algorithm>
+
+#include "RenderQueue.hpp"
+#include "GLRecorder.hpp"
+#include "JobSystem.hpp"
+#include "Assertion.hpp"
+
+using namespace LowRenderer;
+
+namespace Core::Debug
+{
+	// The submit runs on the recorder, no OpenGL context
+	void TestRenderQueue()
+	{
+		TestRenderKey();
+		TestRadixSort();
+		TestRenderSubmit();
+		TestRenderInstancing();
+		TestRenderRecord();
+		Log::Print("RenderQueue : OK\n", Core::Debug::LogLevel::Test);
+	}
+
+	void TestRenderKey()
+	{
+		const uint64_t base = RenderQueue::MakeKey(RenderPass::Opaque, 1, 1, 1, 10.f);
+		Assertion(base < RenderQueue::MakeKey(RenderPass::Opaque, 1, 1, 1, 20.f), "fail on render key : opaque front to back");
+		Assertion(base < RenderQueue::MakeKey(RenderPass::Opaque, 1, 1, 2, 0.f), "fail on render key : mesh before depth");
+		Assertion(base < RenderQueue::MakeKey(RenderPass::Opaque, 1, 2, 0, 0.f), "fail on render key : texture before mesh");
+		Assertion(base < RenderQueue::MakeKey(RenderPass::Opaque, 2, 0, 0, 0.f), "fail on render key : shader before texture");
+		Assertion(base < RenderQueue::MakeKey(RenderPass::Transparent, 0, 0, 0, 0.f), "fail on render key : pass first");
+
+		const uint64_t near = RenderQueue::MakeKey(RenderPass::Transparent, 1, 1, 1, 10.f);
+		Assertion(near > RenderQueue::MakeKey(RenderPass::Transparent, 1, 1, 1, 20.f), "fail on render key : transparent back to front");
+		Assertion(RenderQueue::MakeKey(RenderPass::Opaque, 1, 1, 1, -5.f) == RenderQueue::MakeKey(RenderPass::Opaque, 1, 1, 1, 0.f), "fail on render key : behind the camera");
+	}
+
+	void TestRadixSort()
+	{
+		// Few distinct shaders and textures as in a scene, the equal keys keep their order
+		std::mt19937 random(42);
+		std::vector<RenderCommand> commands;
+		for (unsigned int i = 0; i < 5000; i++)
+			commands.push_back(RenderCommand{ RenderQueue::MakeKey(RenderPass::Opaque, random() % 3, random() % 8, random() % 8, (float)(random() % 100)), i });
+
+		std::vector<RenderCommand> expected = commands;
+		std::stable_sort(expected.begin(), expected.end(), [](const RenderCommand& p_a, const RenderCommand& p_b) { return p_a.key < p_b.key; });
+
+		// Alone, then on the workers : the chunks of SORT_GRAIN keep the order of the equal keys between them
+		for (const unsigned int nbWorkers : { 0u, 3u })
+		{
+			std::vector<RenderCommand> sortedCommands = commands, buffer;
+			Core::JobSystem::Start(nbWorkers);
+			RenderQueue::RadixSort(sortedCommands, buffer);
+			Core::JobSystem::Stop();
+
+			bool same = sortedCommands.size() == expected.size();
+			for (size_t i = 0; same && i < sortedCommands.size(); i++)
+				same = sortedCommands[i].key == expected[i].key && sortedCommands[i].draw == expected[i].draw;
+			Assertion(same, "fail on radix sort : order on " + std::to_string(nbWorkers) + " workers");
+		}
+
+		std::vector<RenderCommand> empty, buffer;
+		RenderQueue::RadixSort(empty, buffer);
+		Assertion(empty.empty(), "fail on radix sort : empty");
+	}
+
+	void TestRenderSubmit()
+	{
+		// Declared first, the resources are deleted while the recorder is still installed
+		GLRecorder recorder({ "model", "normalMatrix", "mvp", "texture1", "uvTransform" });
+
+		Resources::Shader shader("TestRenderQueue", "Resources/Shaders/VertexShaderSource.vert", "Resources/Shaders/FragmentShaderSource.frag", 1);
+		shader.Init();
+		shader.InitOpenGL();
+		Resources::Texture wall("Wall", "", "", 2), sample("Sample", "", "", 3);
+		Resources::Mesh cube("Cube", "", "", 4), sphere("Sphere", "", "", 5);
+
+		// Interleaved as in the graph : every draw would change the texture and the mesh
+		std::vector<Model> models = { Model(&cube, &shader, &wall), Model(&sphere, &shader, &sample), Model(&sphere, &shader, &wall), Model(&cube, &shader, &sample) };
+		const Core::Maths::Mat4 identity = Core::Maths::Mat4::Identity();
+
+		RenderQueue queue;
+		queue.SetInstancing(false);
+		for (unsigned int i = 0; i < 4; i++)
+		{
+			for (Model& model : models)
+				queue.Add(model, identity, identity, identity);
+		}
+		queue.Sort();
+
+		GLRecorder::Reset();
+		queue.Submit(Resources::ShaderDefines(), identity);
+		const RenderQueueStats& stats = queue.GetStats();
+		const GLCalls& calls = GLRecorder::GetCalls();
+
+		Assertion(stats.nbDraws == 16 && calls.draw == 16, "fail on render submit : draws");
+		Assertion(stats.nbShaderChanges == 1 && calls.useProgram == 1, "fail on render submit : shader binds");
+		Assertion(stats.nbTextureChanges == 2, "fail on render submit : texture binds " + std::to_string(stats.nbTextureChanges));
+		Assertion(stats.nbMeshChanges == 4 && calls.bindVertexArray == 4, "fail on render submit : mesh binds " + std::to_string(stats.nbMeshChanges));
+	}
+
+	void TestRenderInstancing()
+	{
+		// Uniforms parsed from the sources, viewProjection of the instanced variant included
+		GLRecorder recorder;
+
+		Resources::Shader shader("TestRenderQueue", "Resources/Shaders/VertexShaderSource.vert", "Resources/Shaders/FragmentShaderSource.frag", 1);
+		shader.Init();
+		shader.InitOpenGL();
+		Resources::Texture wall("Wall", "", "", 2), sample("Sample", "", "", 3);
+		Resources::Mesh cube("Cube", "", "", 4), sphere("Sphere", "", "", 5);
+		Model box(&cube, &shader, &wall), ball(&sphere, &shader, &sample);
+
+		// Three boxes as Box1 to Box10 of Scene1, one ball alone
+		std::vector<Core::Maths::Mat4> transforms;
+		for (unsigned int i = 0; i < 3; i++)
+			transforms.push_back(Core::Maths::Mat4::CreateTranslationMatrix(Core::Maths::Vec3((float)i, 2.f, 3.f)));
+		const Core::Maths::Mat4 identity = Core::Maths::Mat4::Identity();
+
+		RenderQueue queue;
+		queue.Add(box, transforms[0], identity, identity);
+		queue.Add(ball, identity, identity, identity);
+		queue.Add(box, transforms[1], identity, identity);
+		queue.Add(box, transforms[2], identity, identity);
+		queue.Sort();
+
+		const std::vector<Resources::InstanceData>& instances = queue.GetInstances();
+		Assertion(queue.GetBatches().size() == 2 && instances.size() == 3, "fail on render instancing : batches");
+
+		// Column 3 of the model holds the translation
+		bool translations = true;
+		for (unsigned int i = 0; i < 3; i++)
+			translations &= instances[i].model[12] == (float)i && instances[i].model[13] == 2.f && instances[i].model[14] == 3.f && instances[i].model[15] == 1.f;
+		Assertion(translations, "fail on render instancing : instance matrices");
+
+		GLRecorder::Reset();
+		queue.Submit(Resources::ShaderDefines(), identity);
+		const RenderQueueStats& stats = queue.GetStats();
+		const GLCalls& calls = GLRecorder::GetCalls();
+
+		Assertion(stats.nbDraws == 4 && stats.nbInstanced == 3 && calls.draw == 2, "fail on render instancing : draw calls " + std::to_string(calls.draw));
+		Assertion(shader.GetNbVariants() == 2 && calls.bufferUpload == 1, "fail on render instancing : instanced variant");
+	}
+
+	void TestRenderRecord()
+	{
+		GLRecorder recorder({ "model", "normalMatrix", "mvp", "texture1", "uvTransform" });
+
+		Resources::Shader shader("TestRenderQueue", "Resources/Shaders/VertexShaderSource.vert", "Resources/Shaders/FragmentShaderSource.frag", 1);
+		Resources::Texture wall("Wall", "", "", 2), sample("Sample", "", "", 3);
+		Resources::Mesh cube("Cube", "", "", 4), sphere("Sphere", "", "", 5);
+		std::vector<Model> models = { Model(&cube, &shader, &wall), Model(&sphere, &shader, &sample), Model(&sphere, &shader, &wall) };
+
+		std::mt19937 random(42);
+		std::vector<Core::Maths::Mat4> transforms;
+		for (unsigned int i = 0; i < 3000; i++)
+			transforms.push_back(Core::Maths::Mat4::CreateTranslationMatrix(Core::Maths::Vec3(0.f, 0.f, (float)(random() % 100))));
+		const Core::Maths::Mat4 identity = Core::Maths::Mat4::Identity();
+
+		// Every seventh object skipped, as the occluded ones
+		RenderQueue expected;
+		for (unsigned int i = 0; i < transforms.size(); i++)
+		{
+			if (i % 7)
+				expected.Add(models[i % models.size()], transforms[i], identity, transforms[i]);
+		}
+		expected.Sort();
+
+		RenderQueue queue;
+		Core::JobSystem::Start(3);
+		for (const unsigned int count : { (unsigned int)transforms.size(), 1000u, (unsigned int)transforms.size() })
+		{
+			// The second frame has less lists than the first one, the third reuses them
+			queue.Clear();
+			queue.Record(count, 64, [&](unsigned int p_begin, unsigned int p_end, RenderList& p_list)
+			{
+				for (unsigned int i = p_begin; i < p_end; i++)
+				{
+					if (i % 7)
+						p_list.Add(models[i % models.size()], transforms[i], identity, transforms[i]);
+				}
+			});
+		}
+		queue.Sort();
+		Core::JobSystem::Stop();
+
+		const std::vector<RenderCommand>& commands = queue.GetCommands();
+		bool same = commands.size() == expected.GetCommands().size();
+		for (size_t i = 0; same && i < commands.size(); i++)
+			same = commands[i].key == expected.GetCommands()[i].key && commands[i].draw == expected.GetCommands()[i].draw;
+		Assertion(same, "fail on render record : draws of the workers");
+		Assertion(queue.GetBatches().size() == expected.GetBatches().size() && queue.GetInstances().size() == expected.GetInstances().size(), "fail on render record : batches");
+
+		const std::vector<Resources::InstanceData>& instances = queue.GetInstances();
+		same = instances.size() == expected.GetInstances().size();
+		for (size_t i = 0; same && i < instances.size(); i++)
+			same = std::equal(std::begin(instances[i].model), std::end(instances[i].model), std::begin(expected.GetInstances()[i].model));
+		Assertion(same, "fail on render record : instances of the workers");
+	}
+}
\ No newline at end of file
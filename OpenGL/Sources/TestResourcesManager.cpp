@@ -0,0 +1,145 @@
+#include "TestResourcesManager.hpp"
+
+#include <thread>
+#include <vector>
+#include <unordered_set>
+
+#include "ResourcesManager.hpp"
+#include "Assertion.hpp"
+
+using namespace Resources;
+
+namespace Core::Debug
+{
+	const unsigned int NB_TEST_THREADS = 8;
+	const unsigned int NB_TEST_RESOURCES = 100; // Per thread
+	const unsigned int NB_TEST_SOURCES = 4;
+
+	// Resource without OpenGL object, can be created and destroyed on any thread
+	class TestResource : public IResource
+	{
+	public:
+		TestResource(const std::string& p_name, const std::string& p_path1, const std::string& p_path2, const unsigned int p_id)
+		{
+			name = p_name;
+			path1 = p_path1;
+			path2 = p_path2;
+			id = p_id;
+		}
+	};
+
+	std::string TestResourceName(const unsigned int p_thread, const unsigned int p_index)
+	{
+		return "Test" + std::to_string(p_thread) + '_' + std::to_string(p_index);
+	}
+
+	std::string TestSourcePath(const unsigned int p_index)
+	{
+		return "Resources/Test/Source" + std::to_string(p_index % NB_TEST_SOURCES) + ".test";
+	}
+
+	void TestResourcesManager()
+	{
+		TestConcurrentCreate();
+		TestConcurrentShare();
+		TestConcurrentDelete();
+		Log::Print("ResourcesManager : OK\n", Core::Debug::LogLevel::Test);
+	}
+
+	void TestConcurrentCreate()
+	{
+		ResourceManager resources;
+		std::vector<std::thread> threads;
+
+		for (unsigned int t = 0; t < NB_TEST_THREADS; t++)
+		{
+			threads.emplace_back([&resources, t]()
+			{
+				for (unsigned int i = 0; i < NB_TEST_RESOURCES; i++)
+				{
+					TestResource* created = resources.Create<TestResource>(TestResourceName(t, i), "");
+					// Readers run while the other threads insert in the same shards
+					Assertion(resources.GetResource<TestResource>(TestResourceName(t, i)) == created, "fail on concurrent create : lookup of " + TestResourceName(t, i));
+				}
+			});
+		}
+		for (std::thread& thread : threads)
+			thread.join();
+
+		Assertion(resources.GetNbResources() == NB_TEST_THREADS * NB_TEST_RESOURCES, "fail on concurrent create : " + std::to_string(resources.GetNbResources()) + " resources");
+
+		std::unordered_set<int> ids;
+		for (unsigned int t = 0; t < NB_TEST_THREADS; t++)
+		{
+			for (unsigned int i = 0; i < NB_TEST_RESOURCES; i++)
+			{
+				const int id = resources.GetResource<TestResource>(TestResourceName(t, i))->GetId();
+				Assertion(ids.insert(id).second, "fail on concurrent create : id " + std::to_string(id) + " given twice");
+			}
+		}
+	}
+
+	void TestConcurrentShare()
+	{
+		ResourceManager resources;
+		std::vector<std::thread> threads;
+
+		for (unsigned int t = 0; t < NB_TEST_THREADS; t++)
+		{
+			threads.emplace_back([&resources, t]()
+			{
+				for (unsigned int i = 0; i < NB_TEST_RESOURCES; i++)
+					resources.Create<TestResource>(TestResourceName(t, i), TestSourcePath(i));
+			});
+		}
+		for (std::thread& thread : threads)
+			thread.join();
+
+		// Every name of a source must own the same resource, whichever thread created it first
+		for (unsigned int s = 0; s < NB_TEST_SOURCES; s++)
+		{
+			TestResource* source = resources.GetResource<TestResource>(TestResourceName(0, s));
+			for (unsigned int t = 0; t < NB_TEST_THREADS; t++)
+			{
+				for (unsigned int i = s; i < NB_TEST_RESOURCES; i += NB_TEST_SOURCES)
+					Assertion(resources.GetResource<TestResource>(TestResourceName(t, i)) == source, "fail on concurrent share : " + TestResourceName(t, i) + " is not shared");
+			}
+
+			Assertion(resources.GetResourcesFromPath(TestSourcePath(s)).size() == 1, "fail on concurrent share : " + TestSourcePath(s) + " loaded twice");
+		}
+
+		// A name created again is not shared twice
+		const unsigned int nbShared = NB_TEST_THREADS * NB_TEST_RESOURCES - NB_TEST_SOURCES;
+		Assertion(resources.GetNbShared() == nbShared, "fail on concurrent share : " + std::to_string(resources.GetNbShared()) + " shares");
+		resources.Create<TestResource>(TestResourceName(1, 1), TestSourcePath(1));
+		Assertion(resources.GetNbShared() == nbShared, "fail on concurrent share : same name counted again");
+	}
+
+	void TestConcurrentDelete()
+	{
+		ResourceManager resources;
+		for (unsigned int i = 0; i < NB_TEST_RESOURCES; i++)
+			resources.Create<TestResource>(TestResourceName(0, i), "");
+
+		std::vector<std::thread> threads;
+
+		// Half of the threads delete, the other half look up the resources kept
+		for (unsigned int t = 0; t < NB_TEST_THREADS; t++)
+		{
+			threads.emplace_back([&resources, t]()
+			{
+				for (unsigned int i = t % 2; i < NB_TEST_RESOURCES; i += 2)
+				{
+					if (i % 2 == 0)
+						resources.Delete(TestResourceName(0, i));
+					else
+						Assertion(resources.GetResource<TestResource>(TestResourceName(0, i)), "fail on concurrent delete : " + TestResourceName(0, i) + " deleted");
+				}
+			});
+		}
+		for (std::thread& thread : threads)
+			thread.join();
+
+		Assertion(resources.GetNbResources() == NB_TEST_RESOURCES / 2, "fail on concurrent delete : " + std::to_string(resources.GetNbResources()) + " resources left");
+	}
+}
\ No newline at end of file
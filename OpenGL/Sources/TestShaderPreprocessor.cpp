@@ -0,0 +1,85 @@
+#include "TestShaderPreprocessor.hpp"
+
+#include <unordered_map>
+
+#include "ShaderPreprocessor.hpp"
+#include "Assertion.hpp"
+
+using namespace Resources;
+
+namespace Core::Debug
+{
+	// Sources in memory, no file and no OpenGL context
+	void TestShaderPreprocessor()
+	{
+		TestShaderIncludes();
+		TestShaderDefines();
+		TestShaderVariantKey();
+		Log::Print("ShaderPreprocessor : OK\n", Core::Debug::LogLevel::Test);
+	}
+
+	void TestShaderIncludes()
+	{
+		const std::unordered_map<std::string, std::string> files = {
+			{ "Test/common.glsl", "float common;\n" },
+			{ "Test/Sub/light.glsl", "#include \"../common.glsl\"\nfloat light;" } };
+		unsigned int nbReads = 0;
+		ShaderReader reader = [&files, &nbReads](const std::string& p_path) -> std::shared_ptr<const std::string>
+		{
+			nbReads++;
+			auto it = files.find(p_path);
+			return it != files.end() ? std::make_shared<const std::string>(it->second) : nullptr;
+		};
+
+		const std::string source = "#version 330 core\n#include \"common.glsl\"\n  # include \"Sub/light.glsl\"\nvoid main() {}";
+		const PreprocessedShader shader = ShaderPreprocessor::ResolveIncludes(source, "Test/shader.frag", reader);
+
+		// common.glsl is included once, its second include keeps an empty line
+		const std::string expected = "#version 330 core\n"
+			"#line 0 1\nfloat common;\n#line 2 0\n"
+			"#line 0 2\n\nfloat light;\n#line 3 0\n"
+			"void main() {}\n";
+		Assertion(shader.source == expected, "fail on shader includes : source\n" + shader.source);
+		Assertion(shader.files.size() == 3 && nbReads == 2, "fail on shader includes : " + std::to_string(shader.files.size()) + " files");
+
+		// Missing or malformed : reported, the shader keeps the lines around
+		const PreprocessedShader missing = ShaderPreprocessor::ResolveIncludes("#include \"missing.glsl\"\nfloat a;\n", "Test/shader.frag", reader);
+		Assertion(!missing.error.empty() && missing.source == "\nfloat a;\n" && missing.files.size() == 1, "fail on shader includes : missing include");
+		const PreprocessedShader malformed = ShaderPreprocessor::ResolveIncludes("#include \"common.glsl\nfloat a;\n", "Test/shader.frag", reader);
+		Assertion(!malformed.error.empty() && malformed.source == "\nfloat a;\n", "fail on shader includes : malformed include");
+		Assertion(shader.error.empty(), "fail on shader includes : error without reason");
+	}
+
+	void TestShaderDefines()
+	{
+		ShaderDefines defines;
+		defines.Set("NB_POINT_LIGHT", 2);
+		defines.Set("SHADOWS");
+
+		const std::string source = "// Lit\n#version 330 core\nvoid main() {}\n";
+		const std::string expected = "// Lit\n#version 330 core\n#define NB_POINT_LIGHT 2\n#define SHADOWS\n#line 2 0\nvoid main() {}\n";
+		Assertion(ShaderPreprocessor::InjectDefines(source, defines) == expected, "fail on shader defines : after the version");
+		Assertion(ShaderPreprocessor::InjectDefines(source, ShaderDefines()) == source, "fail on shader defines : no define");
+	}
+
+	void TestShaderVariantKey()
+	{
+		ShaderDefines first;
+		first.Set("NB_DIRECTION_LIGHT", 1);
+		first.Set("NB_POINT_LIGHT", 2);
+
+		ShaderDefines second;
+		second.Set("NB_POINT_LIGHT", 2);
+		second.Set("NB_DIRECTION_LIGHT", 1);
+		Assertion(first.GetKey() == second.GetKey(), "fail on variant key : order of the defines");
+
+		second.Set("NB_POINT_LIGHT", 3);
+		Assertion(first.GetKey() != second.GetKey(), "fail on variant key : value");
+
+		ShaderDefines merged = second;
+		merged.Merge(first);
+		Assertion(merged.GetKey() == first.GetKey(), "fail on variant key : merge");
+
+		Assertion(ShaderDefines().GetKey() == ShaderDefines().GetKey() && ShaderDefines().GetKey() != first.GetKey(), "fail on variant key : empty");
+	}
+}
\ No newline at end of file
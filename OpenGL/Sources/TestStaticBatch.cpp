@@ -0,0 +1,129 @@
+#include "TestStaticBatch.hpp"
+
+#include <cmath>
+
+#include "StaticBatch.hpp"
+#include "GLRecorder.hpp"
+#include "JobSystem.hpp"
+#include "Assertion.hpp"
+
+using namespace LowRenderer;
+
+namespace Core::Debug
+{
+	// Quad in the plane z = 0, facing +z
+	static void TestFillQuad(Resources::Mesh& p_mesh)
+	{
+		for (unsigned int corner = 0; corner < 4; corner++)
+			p_mesh.GetVertexBuffer().push_back({ Core::Maths::Vec3(corner & 1 ? 1.f : -1.f, corner & 2 ? 1.f : -1.f, 0.f), Core::Maths::Vec3(0.f, 0.f, 1.f), Core::Maths::Vec2((float)(corner & 1), (float)(corner >> 1)) });
+		p_mesh.GetIndexBuffer() = { 0, 1, 2, 1, 3, 2 };
+	}
+
+	// On the recorder, no OpenGL context
+	void TestStaticBatch()
+	{
+		TestStaticBatchMerge();
+		TestStaticBatchWorkers();
+		TestStaticBatchReload();
+		Log::Print("StaticBatch : OK\n", Core::Debug::LogLevel::Test);
+	}
+
+	void TestStaticBatchMerge()
+	{
+		GLRecorder recorder;
+		Resources::Mesh quad("Quad", "", "", 1);
+		TestFillQuad(quad);
+
+		// Moved, and turned to face +x
+		Physics::Transform moved(Core::Maths::Vec3(10.f, 0.f, 0.f), Core::Maths::Vec3(2.f, 2.f, 2.f));
+		moved.SetMatrix(moved.GetLocalTransform());
+		Physics::Transform turned(Core::Maths::Vec3(0.f, 5.f, 0.f), Core::Maths::Vec3(1.f, 1.f, 1.f), Core::Maths::Vec3(0.f, 90.f, 0.f));
+		turned.SetMatrix(turned.GetLocalTransform());
+
+		std::vector<Resources::Vertex> vertices;
+		std::vector<unsigned int> indices;
+		StaticBatch::Merge({ &quad, &quad }, { &moved, &turned }, vertices, indices);
+
+		Assertion(vertices.size() == 8 && indices.size() == 12, "fail on static batch : size");
+		Assertion(vertices[3].position.x == 12.f && vertices[3].position.y == 2.f && vertices[3].position.z == 0.f, "fail on static batch : world position");
+		Assertion(indices[5] == 2 && indices[6] == 4 && indices[11] == 6, "fail on static batch : indices after the first mesh");
+		Assertion(vertices[3].uv.x == 1.f && vertices[7].uv.y == 1.f, "fail on static batch : uv");
+
+		const Core::Maths::Vec3& normal = vertices[4].normal;
+		Assertion(fabsf(fabsf(normal.x) - 1.f) < 1e-5f && fabsf(normal.z) < 1e-5f, "fail on static batch : turned normal");
+		Assertion(fabsf(vertices[4].position.y - 4.f) < 1e-5f && fabsf(vertices[4].position.x) < 1e-5f, "fail on static batch : turned position");
+	}
+
+	void TestStaticBatchWorkers()
+	{
+		GLRecorder recorder;
+		Resources::Mesh quad("Quad", "", "", 1);
+		TestFillQuad(quad);
+
+		std::vector<Physics::Transform> transforms;
+		for (unsigned int i = 0; i < 100; i++)
+		{
+			transforms.push_back(Physics::Transform(Core::Maths::Vec3((float)i, 0.f, (float)(i % 7)), Core::Maths::Vec3(1.f, 1.f, 1.f), Core::Maths::Vec3(0.f, (float)i * 10.f, 0.f)));
+			transforms.back().SetMatrix(transforms.back().GetLocalTransform());
+		}
+		std::vector<const Resources::Mesh*> meshes(transforms.size(), &quad);
+		std::vector<const Physics::Transform*> pointers;
+		for (const Physics::Transform& transform : transforms)
+			pointers.push_back(&transform);
+
+		std::vector<Resources::Vertex> vertices, threadedVertices;
+		std::vector<unsigned int> indices, threadedIndices;
+		StaticBatch::Merge(meshes, pointers, vertices, indices);
+		Core::JobSystem::Start(3);
+		StaticBatch::Merge(meshes, pointers, threadedVertices, threadedIndices);
+		Core::JobSystem::Stop();
+
+		bool same = indices == threadedIndices && vertices.size() == threadedVertices.size();
+		for (size_t i = 0; same && i < vertices.size(); i++)
+			same = vertices[i].position.x == threadedVertices[i].position.x && vertices[i].position.z == threadedVertices[i].position.z && vertices[i].normal.x == threadedVertices[i].normal.x;
+		Assertion(same, "fail on static batch : workers");
+	}
+
+	void TestStaticBatchReload()
+	{
+		GLRecorder recorder;
+		Resources::Mesh quad("Quad", "", "", 1);
+		TestFillQuad(quad);
+		quad.Init();
+		quad.InitOpenGL();
+		Resources::Shader shader("Shader", "", "", 2);
+		Resources::Texture texture("Texture", "", "", 3);
+		shader.SetStat(Resources::StatResource::LOADED);
+		texture.SetStat(Resources::StatResource::LOADED);
+
+		std::vector<GameObject*> gameObjects;
+		for (unsigned int i = 0; i < 2; i++)
+		{
+			Physics::Transform transform(Core::Maths::Vec3((float)i * 3.f, 0.f, 0.f), Core::Maths::Vec3(1.f, 1.f, 1.f));
+			transform.SetMatrix(transform.GetLocalTransform());
+			gameObjects.push_back(new GameObject(Model(&quad, &shader, &texture), transform, "Static" + std::to_string(i)));
+			gameObjects.back()->SetStatic(true);
+		}
+
+		StaticBatch batch;
+		Assertion(batch.Build(gameObjects) && batch.GetMeshes().size() == 1 && batch.Update() == 0, "fail on static batch reload : build");
+		const Resources::Mesh* merged = batch.GetMeshes()[0].get();
+
+		// The quad reloaded with 8 vertices : the batch mesh is merged again in place
+		Resources::Mesh reloaded("Quad", "", "", 1);
+		TestFillQuad(reloaded);
+		TestFillQuad(reloaded);
+		reloaded.Init();
+		reloaded.InitOpenGL();
+		quad.SwapReload(reloaded);
+
+		Assertion(batch.Update() == 1 && batch.GetMeshes()[0].get() == merged, "fail on static batch reload : merged again");
+		Assertion(merged->GetVertexBuffer().size() == 16 && merged->GetIndexBuffer().size() == 12 && batch.GetBatches()[0]->GetModel().GetMesh() == merged, "fail on static batch reload : new geometry");
+		Assertion(batch.Update() == 0, "fail on static batch reload : merged once");
+
+		for (GameObject* gameObject : gameObjects)
+			delete gameObject;
+		for (GameObject* gameObject : batch.GetBatches())
+			delete gameObject;
+	}
+}
\ No newline at end of file
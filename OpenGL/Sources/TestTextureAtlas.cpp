@@ -0,0 +1,114 @@
+#include "TestTextureAtlas.hpp"
+
+#include <vector>
+
+#include "TextureAtlas.hpp"
+#include "Texture.hpp"
+#include "ThreadsManager.hpp"
+#include "GLRecorder.hpp"
+#include "Assertion.hpp"
+
+using namespace Resources;
+
+namespace Core::Debug
+{
+	// Packing and padding, the pages are uploaded to the recorder only
+	void TestTextureAtlas()
+	{
+		TestAtlasPack();
+		TestAtlasRegion();
+		TestAtlasReload();
+		Log::Print("TextureAtlas : OK\n", Core::Debug::LogLevel::Test);
+	}
+
+	void TestAtlasPack()
+	{
+		TextureAtlas atlas;
+		std::vector<AtlasRegion> regions;
+
+		// 272 texels padded : 3x3 per page, the tenth one opens a second page
+		for (unsigned int i = 0; i < 10; i++)
+		{
+			AtlasRegion region;
+			Assertion(atlas.Pack(ATLAS_MAX_TEXTURE_SIZE, ATLAS_MAX_TEXTURE_SIZE, region), "fail on atlas pack : region " + std::to_string(i));
+			Assertion(region.x % ATLAS_ALIGNMENT == 0 && region.y % ATLAS_ALIGNMENT == 0, "fail on atlas pack : region " + std::to_string(i) + " not aligned");
+			regions.push_back(region);
+		}
+		Assertion(atlas.GetNbPages() == 2 && regions.back().page == 1, "fail on atlas pack : " + std::to_string(atlas.GetNbPages()) + " pages");
+
+		const uint32_t size = TextureAtlas::GetPaddedSize(ATLAS_MAX_TEXTURE_SIZE);
+		for (unsigned int i = 0; i < regions.size(); i++)
+		{
+			Assertion(regions[i].x + size <= ATLAS_PAGE_SIZE && regions[i].y + size <= ATLAS_PAGE_SIZE, "fail on atlas pack : region " + std::to_string(i) + " out of its page");
+			for (unsigned int j = i + 1; j < regions.size(); j++)
+			{
+				const bool overlap = regions[i].page == regions[j].page
+					&& regions[i].x < regions[j].x + size && regions[j].x < regions[i].x + size
+					&& regions[i].y < regions[j].y + size && regions[j].y < regions[i].y + size;
+				Assertion(!overlap, "fail on atlas pack : regions " + std::to_string(i) + " and " + std::to_string(j) + " overlap");
+			}
+		}
+
+		// Bigger than a page
+		AtlasRegion region;
+		Assertion(!atlas.Pack(ATLAS_PAGE_SIZE, 1, region), "fail on atlas pack : texture bigger than a page");
+	}
+
+	void TestAtlasRegion()
+	{
+		// 4x4 RGB with a different red on each texel
+		TextureData texture;
+		texture.format = TextureFormat::RGB8;
+		texture.pixels.resize(4 * 4 * 3);
+		for (unsigned int i = 0; i < 16; i++)
+			texture.pixels[i * 3] = (unsigned char)i;
+		texture.levels.push_back({ 4, 4, 0, texture.pixels.size() });
+
+		const std::vector<unsigned char> pixels = TextureAtlas::BuildRegion(texture, 0);
+		const uint32_t size = TextureAtlas::GetPaddedSize(4);
+		Assertion(pixels.size() == (size_t)size * size * 4, "fail on atlas region : size");
+
+		// The texel of the region at (x, y) is the texel of the texture wrapped around the padding
+		for (uint32_t y = 0; y < size; y++)
+		{
+			for (uint32_t x = 0; x < size; x++)
+			{
+				const unsigned char expected = (unsigned char)(((y - ATLAS_PADDING) % 4) * 4 + (x - ATLAS_PADDING) % 4);
+				const unsigned char* texel = pixels.data() + ((size_t)y * size + x) * 4;
+				Assertion(texel[0] == expected && texel[3] == 255, "fail on atlas region : texel " + std::to_string(x) + ", " + std::to_string(y));
+			}
+		}
+
+		// The last level of the page repeats the last level of the texture
+		const std::vector<unsigned char> last = TextureAtlas::BuildRegion(texture, ATLAS_NB_LEVELS - 1);
+		Assertion(last.size() == (size_t)(size >> (ATLAS_NB_LEVELS - 1)) * (size >> (ATLAS_NB_LEVELS - 1)) * 4, "fail on atlas region : last level size");
+	}
+
+	void TestAtlasReload()
+	{
+		GLRecorder recorder;
+		TextureAtlas atlas;
+		TextureAtlas* const previousAtlas = Texture::atlas;
+		Texture::atlas = &atlas;
+
+		Texture texture("Luma", "Resources/Textures/luma.png", "", 1);
+		texture.Init();
+		texture.InitOpenGL();
+		Assertion(texture.GetStat() == StatResource::LOADED && atlas.GetNbRegions() == 1, "fail on atlas reload : first load");
+
+		// Every reload keeps its own binding, the pages do not fill with unused regions
+		const bool multithread = ThreadsManager::multithread;
+		ThreadsManager::multithread = false;
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			ThreadsManager threads(0);
+			threads.AddResourceToReload(&texture);
+			threads.Update();
+		}
+		ThreadsManager::multithread = multithread;
+		Texture::atlas = previousAtlas;
+
+		Assertion(texture.GetStat() == StatResource::LOADED && texture.GetMemoryUsage().gpu > 0, "fail on atlas reload : reloaded texture");
+		Assertion(atlas.GetNbRegions() == 1, "fail on atlas reload : " + std::to_string(atlas.GetNbRegions()) + " regions");
+	}
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "TestTextureBaker.hpp"
+
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include "TextureBaker.hpp"
+#include "Texture.hpp"
+#include "FileCache.hpp"
+#include "ThreadsManager.hpp"
+#include "GLRecorder.hpp"
+#include "Assertion.hpp"
+
+using namespace Resources;
+
+namespace Core::Debug
+{
+	// Everything runs on the CPU, no OpenGL context needed
+	void TestTextureBaker()
+	{
+		TestMipmapsSize();
+		TestMipmapsConstant();
+		TestMipmapsGamma();
+		TestMipmapsCompress();
+		TestTextureCache();
+		TestTextureReloadFailed();
+		Log::Print("TextureBaker : OK\n", Core::Debug::LogLevel::Test);
+	}
+
+	void TestMipmapsSize()
+	{
+		const std::vector<unsigned char> pixels(5 * 3 * 3, 0);
+		const TextureData texture = TextureBaker::BuildMipmaps(pixels.data(), 5, 3, 3);
+
+		// 5x3 -> 2x1 -> 1x1
+		Assertion(texture.format == TextureFormat::RGB8, "fail on mipmaps size : format");
+		Assertion(texture.levels.size() == 3, "fail on mipmaps size : " + std::to_string(texture.levels.size()) + " levels");
+		Assertion(texture.levels[1].width == 2 && texture.levels[1].height == 1, "fail on mipmaps size : level 1");
+		Assertion(texture.levels[2].width == 1 && texture.levels[2].height == 1, "fail on mipmaps size : level 2");
+		Assertion(texture.levels[2].offset + texture.levels[2].size == texture.pixels.size(), "fail on mipmaps size : pixels size");
+
+		// Grey images are expanded to RGBA
+		const TextureData grey = TextureBaker::BuildMipmaps(pixels.data(), 4, 4, 1);
+		Assertion(grey.format == TextureFormat::RGBA8 && grey.levels[0].size == 4 * 4 * 4, "fail on mipmaps size : grey image");
+	}
+
+	void TestMipmapsConstant()
+	{
+		std::vector<unsigned char> pixels(16 * 16 * 4);
+		for (size_t i = 0; i < pixels.size(); i += 4)
+		{
+			pixels[i] = 200;
+			pixels[i + 1] = 100;
+			pixels[i + 2] = 50;
+			pixels[i + 3] = 255;
+		}
+
+		const TextureData texture = TextureBaker::BuildMipmaps(pixels.data(), 16, 16, 4);
+		for (unsigned int level = 0; level < texture.levels.size(); level++)
+		{
+			const unsigned char* data = texture.GetLevel(level);
+			for (size_t i = 0; i < texture.levels[level].size; i++)
+				Assertion(std::abs(data[i] - pixels[i % 4]) <= 1, "fail on mipmaps constant : level " + std::to_string(level));
+		}
+	}
+
+	void TestMipmapsGamma()
+	{
+		// Black and white checkerboard, half of the light in linear space is 188 in sRGB, not 128
+		std::vector<unsigned char> pixels(8 * 8 * 3);
+		for (unsigned int y = 0; y < 8; y++)
+		{
+			for (unsigned int x = 0; x < 8; x++)
+			{
+				for (unsigned int c = 0; c < 3; c++)
+					pixels[(y * 8 + x) * 3 + c] = (x + y) % 2 ? 255 : 0;
+			}
+		}
+
+		const TextureData texture = TextureBaker::BuildMipmaps(pixels.data(), 8, 8, 3);
+		const unsigned char last = texture.GetLevel((unsigned int)texture.levels.size() - 1)[0];
+		Assertion(std::abs(last - 188) <= 2, "fail on mipmaps gamma : " + std::to_string(last));
+	}
+
+	void TestMipmapsCompress()
+	{
+		std::vector<unsigned char> pixels(8 * 8 * 4, 255);
+		const TextureData opaque = TextureBaker::Compress(TextureBaker::BuildMipmaps(pixels.data(), 8, 8, 4));
+		Assertion(opaque.format == TextureFormat::BC1 && opaque.levels.size() == 4, "fail on mipmaps compress : opaque format");
+
+		pixels[3] = 0;
+		const TextureData alpha = TextureBaker::Compress(TextureBaker::BuildMipmaps(pixels.data(), 8, 8, 4));
+		Assertion(alpha.format == TextureFormat::BC3, "fail on mipmaps compress : alpha format");
+
+		// Every level of a white texture is still white once decompressed
+		const TextureData white = TextureBaker::Decompress(opaque);
+		for (unsigned int level = 0; level < white.levels.size(); level++)
+		{
+			const unsigned char* data = white.GetLevel(level);
+			for (size_t i = 0; i < white.levels[level].size; i++)
+				Assertion(data[i] == 255, "fail on mipmaps compress : level " + std::to_string(level));
+		}
+	}
+
+	void TestTextureCache()
+	{
+		const std::string path = std::string(TEXTURE_CACHE_DIRECTORY) + "/Test.tex";
+		std::vector<unsigned char> pixels(7 * 5 * 3);
+		for (size_t i = 0; i < pixels.size(); i++)
+			pixels[i] = (unsigned char)(i * 7);
+
+		const TextureData texture = TextureBaker::BuildMipmaps(pixels.data(), 7, 5, 3);
+		Assertion(TextureBaker::SaveCache(path, 42, texture), "fail on texture cache : save");
+
+		// Mapped, the levels point in the file
+		TextureData loaded;
+		Assertion(TextureBaker::LoadCache(path, 42, loaded) && loaded.mapping && loaded.pixels.empty(), "fail on texture cache : load");
+		Assertion(loaded.format == texture.format && loaded.levels.size() == texture.levels.size(), "fail on texture cache : levels");
+		Assertion((uintptr_t)loaded.GetPixels() % TEXTURE_CACHE_ALIGNMENT == 0, "fail on texture cache : pixels not aligned");
+		Assertion(loaded.GetPixelsSize() == texture.GetPixelsSize() && memcmp(loaded.GetPixels(), texture.GetPixels(), texture.GetPixelsSize()) == 0, "fail on texture cache : pixels");
+
+		// Another key, or other settings, miss the cache
+		TextureData other;
+		Assertion(!TextureBaker::LoadCache(path, 43, other), "fail on texture cache : wrong key");
+		Assertion(TextureBaker::GetKey("content", true) != TextureBaker::GetKey("content", false), "fail on texture cache : settings not in the key");
+
+		loaded = TextureData();
+		std::error_code error;
+		std::filesystem::remove(path, error);
+	}
+
+	void TestTextureReloadFailed()
+	{
+		GLRecorder recorder;
+		const std::string path = "Resources/Test/Reload.png";
+		std::error_code error;
+		std::filesystem::create_directories("Resources/Test", error);
+		std::filesystem::copy_file("Resources/Textures/Patrick.png", path, std::filesystem::copy_options::overwrite_existing, error);
+
+		Texture texture("Reload", path, "", 1);
+		texture.Init();
+		texture.InitOpenGL();
+		const size_t gpuSize = texture.GetMemoryUsage().gpu;
+		Assertion(texture.GetStat() == StatResource::LOADED && gpuSize > 0, "fail on texture reload : first load");
+
+		// Half written by the editor : the reload fails and the live texture is kept
+		std::string content;
+		{
+			std::ifstream file(path, std::ios::in | std::ios::binary);
+			content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		}
+		{
+			std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+			file.write(content.data(), content.size() / 2);
+		}
+		FileCache::Invalidate(path);
+
+		const bool multithread = ThreadsManager::multithread;
+		ThreadsManager::multithread = false;
+		{
+			ThreadsManager threads(0);
+			threads.AddResourceToReload(&texture);
+			threads.Update();
+		}
+		ThreadsManager::multithread = multithread;
+		Assertion(texture.GetStat() == StatResource::LOADED && texture.GetMemoryUsage().gpu == gpuSize, "fail on texture reload : previous version kept");
+
+		std::filesystem::remove(path, error);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "TestTextureStreamer.hpp"
+
+#include <vector>
+
+#include "TextureStreamer.hpp"
+#include "Assertion.hpp"
+
+using namespace Resources;
+
+namespace Core::Debug
+{
+	// 1024x1024 RGBA8 texture with its tail at 64x64
+	StreamingEntry TestStreamingEntry(const float p_screenSize)
+	{
+		StreamingEntry entry;
+		entry.tailLevel = 4;
+		entry.residentLevel = entry.tailLevel;
+		entry.screenSize = p_screenSize;
+		entry.wantedLevel = TextureStreamer::GetWantedLevel(1024, 1024, p_screenSize, entry.tailLevel);
+		for (uint32_t size = 1024; size > 0; size /= 2)
+			entry.levelSizes.push_back((size_t)size * size * 4);
+		entry.targetLevel = entry.residentLevel;
+
+		return entry;
+	}
+
+	size_t TestStreamingSize(const StreamingEntry& p_entry)
+	{
+		size_t size = 0;
+		for (unsigned int level = p_entry.targetLevel; level < p_entry.tailLevel; level++)
+			size += p_entry.levelSizes[level];
+
+		return size;
+	}
+
+	// Plans only, no texture is uploaded
+	void TestTextureStreamer()
+	{
+		TestStreamingWantedLevel();
+		TestStreamingPriority();
+		TestStreamingBudget();
+		TestStreamingUpload();
+		Log::Print("TextureStreamer : OK\n", Core::Debug::LogLevel::Test);
+	}
+
+	void TestStreamingWantedLevel()
+	{
+		Assertion(TextureStreamer::GetWantedLevel(1024, 1024, 0.f, 4) == 4, "fail on wanted level : not drawn");
+		Assertion(TextureStreamer::GetWantedLevel(1024, 1024, 2000.f, 4) == 0, "fail on wanted level : full screen");
+		Assertion(TextureStreamer::GetWantedLevel(1024, 512, 256.f, 4) == 2, "fail on wanted level : 256 pixels");
+		Assertion(TextureStreamer::GetWantedLevel(1024, 1024, 1.f, 4) == 4, "fail on wanted level : clamped to the tail");
+	}
+
+	void TestStreamingPriority()
+	{
+		// Room for the first level of one texture only, the biggest on screen gets it
+		std::vector<StreamingEntry> entries = { TestStreamingEntry(100.f), TestStreamingEntry(1000.f) };
+		StreamingEntry full = entries[1];
+		full.targetLevel = 0;
+		TextureStreamer::Plan(entries, TestStreamingSize(full) + full.levelSizes[3], 64 * 1024 * 1024);
+		Assertion(entries[1].targetLevel == 0, "fail on streaming priority : biggest at level " + std::to_string(entries[1].targetLevel));
+		Assertion(entries[0].targetLevel == 3, "fail on streaming priority : smallest at level " + std::to_string(entries[0].targetLevel));
+	}
+
+	void TestStreamingBudget()
+	{
+		// The texture not drawn any more gives its levels to the one on screen
+		std::vector<StreamingEntry> entries = { TestStreamingEntry(0.f), TestStreamingEntry(1000.f) };
+		entries[0].residentLevel = 0;
+		entries[0].targetLevel = 0;
+		const size_t budget = TestStreamingSize(entries[0]) + 1;
+
+		TextureStreamer::Plan(entries, budget, 64 * 1024 * 1024);
+		Assertion(entries[0].targetLevel == entries[0].tailLevel, "fail on streaming budget : not drawn at level " + std::to_string(entries[0].targetLevel));
+		Assertion(entries[1].targetLevel == 0, "fail on streaming budget : drawn at level " + std::to_string(entries[1].targetLevel));
+		Assertion(TestStreamingSize(entries[0]) + TestStreamingSize(entries[1]) <= budget, "fail on streaming budget : over budget");
+
+		// Lowered budget
+		entries[0].residentLevel = entries[0].targetLevel;
+		entries[1].residentLevel = entries[1].targetLevel;
+		TextureStreamer::Plan(entries, budget / 2, 64 * 1024 * 1024);
+		Assertion(TestStreamingSize(entries[1]) <= budget / 2 && entries[1].targetLevel == 1, "fail on streaming budget : lowered budget");
+	}
+
+	void TestStreamingUpload()
+	{
+		// Coarse levels first, one more at least each frame
+		std::vector<StreamingEntry> entries = { TestStreamingEntry(1000.f) };
+		TextureStreamer::Plan(entries, TEXTURE_STREAMING_BUDGET, 1);
+		Assertion(entries[0].targetLevel == 3, "fail on streaming upload : level " + std::to_string(entries[0].targetLevel));
+
+		entries[0].residentLevel = entries[0].targetLevel;
+		TextureStreamer::Plan(entries, TEXTURE_STREAMING_BUDGET, 2 * 1024 * 1024);
+		Assertion(entries[0].targetLevel == 1, "fail on streaming upload : level " + std::to_string(entries[0].targetLevel));
+	}
+}
\ No newline at end of file
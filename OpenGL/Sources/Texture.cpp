@@ -1,19 +1,33 @@
 #include "Texture.hpp"
 
 #include "Assertion.hpp"
+#include "FileCache.hpp"
+#include "Shader.hpp"
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
-
-#define STB_IMAGE_IMPLEMENTATION
-#include <STB_Image/stb_image.h>
 #include <iostream>
 
 namespace Resources
 {
+	bool Texture::compression = true;
+	TextureAtlas* Texture::atlas = nullptr;
+	TextureStreamer* Texture::streamer = nullptr;
+
 	Texture::Texture(const std::string& p_name, const std::string& p_path1, const std::string& p_path2, const unsigned int p_id)
 		: texture(0)
 		, sampler(0)
+		, textureData()
+		, width(0)
+		, height(0)
+		, format(TextureFormat::RGBA8)
+		, gpuSize(0)
+		, inAtlas(false)
+		, standalone(false)
+		, region()
+		, tailLevel(0)
+		, residentLevel(0)
+		, screenSize(0.f)
 	{
 		name = p_name;
 		path1 = p_path1;
@@ -23,33 +37,102 @@ namespace Resources
 
 	Texture::~Texture()
 	{
+		if (streamer && tailLevel > 0)
+			streamer->Remove(this);
 		glDeleteTextures(1, &texture);
 		glDeleteSamplers(1, &sampler);
 	}
 
 	void Texture::Init()
 	{
-		// generate the texture data
-		stbi_set_flip_vertically_on_load(true);
-		data = stbi_load(path1.c_str(), &width, &height, &nrChannels, 0);
+		// generate the texture data, every worker can decode at the same time
+		std::shared_ptr<const std::string> file = FileCache::Load(path1);
+		if (!file)
+		{
+			stat = StatResource::FAILED;
+			return;
+		}
+
+		// Warm runs map the baked levels, the image is not decoded
+		const uint64_t key = TextureBaker::GetKey(*file, compression);
+		const std::string cachePath = TextureBaker::GetCachePath(key);
+		if (!TextureBaker::LoadCache(cachePath, key, textureData))
+		{
+			// A file still being written by an editor does not decode
+			Image image;
+			if (!image.Decode(file->data(), file->size()))
+			{
+				Core::Debug::Log::Print("Fail to load texture " + path1 + "\n", Core::Debug::LogLevel::Warning);
+				stat = StatResource::FAILED;
+				return;
+			}
+
+			// The mip chain is built here, on the worker, the main thread only uploads
+			textureData = TextureBaker::Bake(image, compression);
+			if (!textureData.levels.empty())
+			{
+				TextureBaker::SaveCache(cachePath, key, textureData);
+				Core::Debug::Log::Print("Bake texture " + path1 + "\n", Core::Debug::LogLevel::Notification);
+			}
+		}
+
+		if (textureData.levels.empty())
+		{
+			Core::Debug::Log::Print("Texture " + path1 + " has no level\n", Core::Debug::LogLevel::Warning);
+			stat = StatResource::FAILED;
+			return;
+		}
+
+		format = textureData.format;
+		width = textureData.levels[0].width;
+		height = textureData.levels[0].height;
 		stat = StatResource::INITIALIZED;
 	}
 
 	void Texture::InitOpenGL()
 	{
-		bool isPng = true;
-		if (path1.find(".jpg") != std::string::npos)
-			isPng = false;
+		if (atlas && !standalone && atlas->Insert(textureData, region))
+		{
+			inAtlas = true;
+			format = TextureFormat::RGBA8;
+			gpuSize = 0;
+			for (unsigned int level = 0; level < ATLAS_NB_LEVELS; level++)
+				gpuSize += (size_t)(TextureAtlas::GetPaddedSize(region.width) >> level) * (TextureAtlas::GetPaddedSize(region.height) >> level) * 4;
+
+			textureData = TextureData();
+			stat = StatResource::LOADED;
+			return;
+		}
+
+		// Drivers without S3TC get the decompressed levels
+		if (textureData.IsCompressed() && !GLAD_GL_EXT_texture_compression_s3tc)
+			textureData = TextureBaker::Decompress(textureData);
+		format = textureData.format;
+
+		// Only the small levels are uploaded now, the model is drawn with them until the streamer brings the others
+		tailLevel = 0;
+		if (streamer)
+		{
+			while (tailLevel + 1 < textureData.levels.size() && std::max(textureData.levels[tailLevel].width, textureData.levels[tailLevel].height) > TEXTURE_STREAMING_TAIL_SIZE)
+				tailLevel++;
+		}
 
 		glGenTextures(1, &texture);
 		glBindTexture(GL_TEXTURE_2D, texture);
-		if (isPng)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-		else
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-		glGenerateMipmap(GL_TEXTURE_2D);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Rows of RGB images are not aligned on 4 bytes
+
+		gpuSize = 0;
+		for (unsigned int level = tailLevel; level < textureData.levels.size(); level++)
+			UploadLevel(level);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, (GLint)tailLevel);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)textureData.levels.size() - 1);
+		residentLevel = tailLevel;
 
-		stbi_image_free(data);
+		if (tailLevel > 0)
+			streamer->Add(this);
+		else
+			textureData = TextureData();
 
 		// create a sampler and parameterize it
 		glGenSamplers(1, &sampler);
@@ -59,17 +142,132 @@ namespace Resources
 		glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 		glSamplerParameterf(sampler, GL_TEXTURE_MAX_ANISOTROPY_EXT, 4.f);
 
-		GLint max = 0;
-		glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &max);
-
-		glBindTextureUnit(id, texture);
-		glBindSampler(id, sampler);
 		stat = StatResource::LOADED;
 	}
 
-	void Texture::Draw(const unsigned int p_shaderProgram)
+	IResource* Texture::CreateReload() const
+	{
+		Texture* reload = new Texture(name, path1, path2, id);
+		reload->standalone = true;
+		return reload;
+	}
+
+	void Texture::SwapReload(IResource& p_reloaded)
+	{
+		Texture& reloaded = static_cast<Texture&>(p_reloaded);
+		std::swap(texture, reloaded.texture);
+		std::swap(sampler, reloaded.sampler);
+		std::swap(width, reloaded.width);
+		std::swap(height, reloaded.height);
+		std::swap(format, reloaded.format);
+		std::swap(gpuSize, reloaded.gpuSize);
+		std::swap(inAtlas, reloaded.inAtlas); // The previous region stays unused in its page, the next reloads add none
+		std::swap(standalone, reloaded.standalone);
+		std::swap(region, reloaded.region);
+
+		// The reloaded texture is deleted with the previous version, the streamer keeps this one
+		std::swap(textureData, reloaded.textureData);
+		std::swap(tailLevel, reloaded.tailLevel);
+		std::swap(residentLevel, reloaded.residentLevel);
+		if (streamer)
+		{
+			streamer->Remove(&reloaded);
+			if (tailLevel > 0)
+				streamer->Add(this);
+			else
+				streamer->Remove(this);
+		}
+	}
+
+	ResourceMemory Texture::GetMemoryUsage() const
 	{
-		GLint location = glGetUniformLocation(p_shaderProgram, "texture1");
-		if(location!= -1) glUniform1i(location, id);
+		ResourceMemory memory;
+
+		// Decoded pixels are only kept until the upload, or while streaming. Mapped pixels are in the page cache of the system.
+		memory.cpu = textureData.pixels.capacity();
+		memory.gpu = gpuSize;
+
+		return memory;
+	}
+
+	constexpr uint64_t TEXTURE_UNIFORM = UniformHash("texture1");
+	constexpr uint64_t UV_TRANSFORM_UNIFORM = UniformHash("uvTransform");
+
+	void Texture::Draw(const Shader& p_shader)
+	{
+		if (inAtlas)
+			atlas->Bind(region);
+		else
+		{
+			glBindTextureUnit(DIFFUSE_TEXTURE_UNIT, texture);
+			glBindSampler(DIFFUSE_TEXTURE_UNIT, sampler);
+		}
+
+		Shader::SetInt(p_shader.GetLocation(TEXTURE_UNIFORM), DIFFUSE_TEXTURE_UNIT);
+		Shader::SetVec4(p_shader.GetLocation(UV_TRANSFORM_UNIFORM), Core::Maths::Vec4(region.scale[0], region.scale[1], region.offset[0], region.offset[1]));
+	}
+
+	void Texture::GetStreamingEntry(const float p_screenHeight, StreamingEntry& p_entry)
+	{
+		const TextureLevel& level0 = textureData.levels[0];
+
+		p_entry.residentLevel = residentLevel;
+		p_entry.tailLevel = tailLevel;
+		p_entry.screenSize = screenSize * p_screenHeight;
+		p_entry.wantedLevel = TextureStreamer::GetWantedLevel(level0.width, level0.height, p_entry.screenSize, tailLevel);
+		p_entry.levelSizes.resize(textureData.levels.size());
+		for (unsigned int level = 0; level < textureData.levels.size(); level++)
+			p_entry.levelSizes[level] = textureData.levels[level].size;
+
+		// Requested again by the draw of the next frame
+		screenSize = 0.f;
+	}
+
+	void Texture::SetResidentLevel(const unsigned int p_level)
+	{
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		for (unsigned int level = p_level; level < residentLevel; level++)
+			UploadLevel(level);
+		for (unsigned int level = residentLevel; level < p_level; level++)
+			FreeLevel(level);
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, (GLint)p_level);
+		residentLevel = p_level;
+	}
+
+	void Texture::UploadLevel(const unsigned int p_level)
+	{
+		const TextureLevel& textureLevel = textureData.levels[p_level];
+		const unsigned char* pixels = textureData.GetLevel(p_level);
+
+		switch (format)
+		{
+		case TextureFormat::BC1:
+			glCompressedTexImage2D(GL_TEXTURE_2D, p_level, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, textureLevel.width, textureLevel.height, 0, (GLsizei)textureLevel.size, pixels);
+			break;
+		case TextureFormat::BC3:
+			glCompressedTexImage2D(GL_TEXTURE_2D, p_level, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, textureLevel.width, textureLevel.height, 0, (GLsizei)textureLevel.size, pixels);
+			break;
+		case TextureFormat::RGB8:
+			glTexImage2D(GL_TEXTURE_2D, p_level, GL_RGB, textureLevel.width, textureLevel.height, 0, GL_RGB, GL_UNSIGNED_BYTE, pixels);
+			break;
+		default:
+			glTexImage2D(GL_TEXTURE_2D, p_level, GL_RGBA, textureLevel.width, textureLevel.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+			break;
+		}
+		gpuSize += textureLevel.size;
+	}
+
+	void Texture::FreeLevel(const unsigned int p_level)
+	{
+		// An empty image releases the storage of the level, it is outside of the base level anyway
+		if (textureData.IsCompressed())
+			glCompressedTexImage2D(GL_TEXTURE_2D, p_level, format == TextureFormat::BC1 ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 0, 0, 0, 0, nullptr);
+		else
+			glTexImage2D(GL_TEXTURE_2D, p_level, format == TextureFormat::RGB8 ? GL_RGB : GL_RGBA, 0, 0, 0, format == TextureFormat::RGB8 ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		gpuSize -= textureData.levels[p_level].size;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,182 @@
+#include "TextureAtlas.hpp"
+
+#include <algorithm>
+
+#include <glad/glad.h>
+
+#include "Log.hpp"
+#include "Texture.hpp"
+
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "../stb-master/stb_rect_pack.h"
+
+namespace Resources
+{
+	TextureAtlas::TextureAtlas()
+		: sampler(0)
+		, nbRegions(0)
+	{
+	}
+
+	TextureAtlas::~TextureAtlas()
+	{
+		Clear();
+	}
+
+	bool TextureAtlas::Insert(const TextureData& p_texture, AtlasRegion& p_region)
+	{
+		if (!Fits(p_texture))
+			return false;
+
+		// Pages are not compressed, a BC block would not stay aligned on the last levels
+		const TextureData texture = p_texture.IsCompressed() ? TextureBaker::Decompress(p_texture) : TextureData();
+		const TextureData& source = p_texture.IsCompressed() ? texture : p_texture;
+
+		AtlasRegion region;
+		if (!Pack(source.levels[0].width, source.levels[0].height, region))
+			return false;
+
+		AtlasPage& page = *pages[region.page];
+		if (!page.texture)
+			CreatePageTexture(page);
+
+		glBindTexture(GL_TEXTURE_2D, page.texture);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		for (unsigned int level = 0; level < ATLAS_NB_LEVELS; level++)
+		{
+			const std::vector<unsigned char> pixels = BuildRegion(source, level);
+			glTexSubImage2D(GL_TEXTURE_2D, level, region.x >> level, region.y >> level,
+				GetPaddedSize(region.width) >> level, GetPaddedSize(region.height) >> level, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		}
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+		p_region = region;
+		return true;
+	}
+
+	bool TextureAtlas::Pack(const uint32_t p_width, const uint32_t p_height, AtlasRegion& p_region)
+	{
+		stbrp_rect rect = {};
+		rect.w = (stbrp_coord)GetPaddedSize(p_width);
+		rect.h = (stbrp_coord)GetPaddedSize(p_height);
+		if (rect.w > ATLAS_PAGE_SIZE || rect.h > ATLAS_PAGE_SIZE)
+			return false;
+
+		// First page with room left, the skyline of each page keeps the previous rects
+		unsigned int page = 0;
+		for (; page < pages.size(); page++)
+		{
+			stbrp_pack_rects(&pages[page]->context, &rect, 1);
+			if (rect.was_packed)
+				break;
+		}
+
+		if (page == pages.size())
+		{
+			std::unique_ptr<AtlasPage> newPage = std::make_unique<AtlasPage>();
+			newPage->nodes.resize(ATLAS_PAGE_SIZE);
+			stbrp_init_target(&newPage->context, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, newPage->nodes.data(), (int)newPage->nodes.size());
+			stbrp_pack_rects(&newPage->context, &rect, 1);
+			pages.push_back(std::move(newPage));
+			Core::Debug::Log::Print("New texture atlas page " + std::to_string(page) + "\n", Core::Debug::LogLevel::Notification);
+		}
+
+		nbRegions++;
+		p_region.page = page;
+		p_region.x = rect.x;
+		p_region.y = rect.y;
+		p_region.width = p_width;
+		p_region.height = p_height;
+		p_region.scale[0] = (float)p_width / ATLAS_PAGE_SIZE;
+		p_region.scale[1] = (float)p_height / ATLAS_PAGE_SIZE;
+		p_region.offset[0] = (float)(rect.x + ATLAS_PADDING) / ATLAS_PAGE_SIZE;
+		p_region.offset[1] = (float)(rect.y + ATLAS_PADDING) / ATLAS_PAGE_SIZE;
+
+		return true;
+	}
+
+	void TextureAtlas::Bind(const AtlasRegion& p_region) const
+	{
+		glBindTextureUnit(DIFFUSE_TEXTURE_UNIT, pages[p_region.page]->texture);
+		glBindSampler(DIFFUSE_TEXTURE_UNIT, sampler);
+	}
+
+	void TextureAtlas::Clear()
+	{
+		for (const std::unique_ptr<AtlasPage>& page : pages)
+		{
+			if (page->texture)
+				glDeleteTextures(1, &page->texture);
+		}
+		pages.clear();
+		nbRegions = 0;
+
+		if (sampler)
+			glDeleteSamplers(1, &sampler);
+		sampler = 0;
+	}
+
+	bool TextureAtlas::Fits(const TextureData& p_texture)
+	{
+		return !p_texture.levels.empty()
+			&& p_texture.levels[0].width <= ATLAS_MAX_TEXTURE_SIZE && p_texture.levels[0].height <= ATLAS_MAX_TEXTURE_SIZE;
+	}
+
+	std::vector<unsigned char> TextureAtlas::BuildRegion(const TextureData& p_texture, const unsigned int p_level)
+	{
+		// Small textures have less levels than the page, the last one is repeated
+		const unsigned int sourceLevel = std::min(p_level, (unsigned int)p_texture.levels.size() - 1);
+		const TextureLevel& source = p_texture.levels[sourceLevel];
+		const unsigned char* sourcePixels = p_texture.GetLevel(sourceLevel);
+		const unsigned int channels = p_texture.format == TextureFormat::RGB8 ? 3 : 4;
+
+		const uint32_t width = GetPaddedSize(p_texture.levels[0].width) >> p_level;
+		const uint32_t height = GetPaddedSize(p_texture.levels[0].height) >> p_level;
+		const uint32_t padding = ATLAS_PADDING >> p_level;
+
+		std::vector<unsigned char> pixels((size_t)width * height * 4);
+		for (uint32_t y = 0; y < height; y++)
+		{
+			// Same wrap as the GL_REPEAT sampler of the textures outside of the atlas
+			const uint32_t sourceY = (y + source.height - padding % source.height) % source.height;
+			for (uint32_t x = 0; x < width; x++)
+			{
+				const uint32_t sourceX = (x + source.width - padding % source.width) % source.width;
+				const unsigned char* in = sourcePixels + ((size_t)sourceY * source.width + sourceX) * channels;
+				unsigned char* out = pixels.data() + ((size_t)y * width + x) * 4;
+
+				out[0] = in[0];
+				out[1] = in[1];
+				out[2] = in[2];
+				out[3] = channels == 4 ? in[3] : 255;
+			}
+		}
+
+		return pixels;
+	}
+
+	uint32_t TextureAtlas::GetPaddedSize(const uint32_t p_size)
+	{
+		return (p_size + 2 * ATLAS_PADDING + ATLAS_ALIGNMENT - 1) / ATLAS_ALIGNMENT * ATLAS_ALIGNMENT;
+	}
+
+	void TextureAtlas::CreatePageTexture(AtlasPage& p_page)
+	{
+		glGenTextures(1, &p_page.texture);
+		glBindTexture(GL_TEXTURE_2D, p_page.texture);
+		for (unsigned int level = 0; level < ATLAS_NB_LEVELS; level++)
+			glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, ATLAS_PAGE_SIZE >> level, ATLAS_PAGE_SIZE >> level, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, ATLAS_NB_LEVELS - 1);
+
+		// The padding wraps, the page itself is never repeated
+		if (!sampler)
+		{
+			glGenSamplers(1, &sampler);
+			glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+			glSamplerParameterf(sampler, GL_TEXTURE_MAX_ANISOTROPY_EXT, 4.f);
+		}
+	}
+}
\ No newline at end of file
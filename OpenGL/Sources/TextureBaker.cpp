@@ -0,0 +1,351 @@
+#include "TextureBaker.hpp"
+
+#include <fstream>
+#include <filesystem>
+#include <thread>
+#include <cstring>
+#include <algorithm>
+
+#define STB_DXT_IMPLEMENTATION
+#include "../stb-master/stb_dxt.h"
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#include "../stb-master/stb_image_resize.h"
+
+#include "FileCache.hpp"
+#include "Log.hpp"
+
+namespace Resources
+{
+	TextureData TextureBaker::Bake(const Image& p_image, const bool p_compress)
+	{
+		if (!p_image.GetData())
+			return TextureData();
+
+		TextureData texture = BuildMipmaps(p_image.GetData(), p_image.GetWidth(), p_image.GetHeight(), p_image.GetNrChannels());
+		return p_compress ? Compress(texture) : texture;
+	}
+
+	TextureData TextureBaker::BuildMipmaps(const unsigned char* p_pixels, const uint32_t p_width, const uint32_t p_height, const int p_nrChannels)
+	{
+		TextureData texture;
+		uint32_t width = p_width;
+		uint32_t height = p_height;
+
+		// Grey images are expanded, OpenGL would show them in red
+		texture.format = p_nrChannels == 3 ? TextureFormat::RGB8 : TextureFormat::RGBA8;
+		const int channels = p_nrChannels == 3 ? 3 : 4;
+		if (p_nrChannels == channels)
+			texture.pixels.assign(p_pixels, p_pixels + (size_t)width * height * channels);
+		else
+			texture.pixels = ToRGBA(p_pixels, (size_t)width * height, p_nrChannels);
+		texture.levels.push_back({ width, height, 0, texture.pixels.size() });
+
+		while (width > 1 || height > 1)
+		{
+			const TextureLevel& previous = texture.levels.back();
+			width = std::max(1u, width / 2);
+			height = std::max(1u, height / 2);
+
+			const size_t offset = texture.pixels.size();
+			const size_t size = GetLevelSize(texture.format, width, height);
+			texture.pixels.resize(offset + size);
+
+			// Filtered in linear space, alpha weighted
+			stbir_resize_uint8_srgb_edgemode(texture.pixels.data() + previous.offset, previous.width, previous.height, 0,
+				texture.pixels.data() + offset, width, height, 0,
+				channels, channels == 4 ? 3 : STBIR_ALPHA_CHANNEL_NONE, 0, STBIR_EDGE_WRAP);
+
+			texture.levels.push_back({ width, height, offset, size });
+		}
+
+		return texture;
+	}
+
+	TextureData TextureBaker::Compress(const TextureData& p_texture)
+	{
+		if (p_texture.IsCompressed())
+			return p_texture;
+
+		TextureData texture;
+		const bool alpha = HasAlpha(p_texture);
+		texture.format = alpha ? TextureFormat::BC3 : TextureFormat::BC1;
+
+		for (unsigned int level = 0; level < p_texture.levels.size(); level++)
+		{
+			const TextureLevel& source = p_texture.levels[level];
+			const size_t size = GetLevelSize(texture.format, source.width, source.height);
+			texture.levels.push_back({ source.width, source.height, texture.pixels.size(), size });
+			texture.pixels.resize(texture.pixels.size() + size);
+
+			const std::vector<unsigned char> rgba = p_texture.format == TextureFormat::RGBA8 ? std::vector<unsigned char>()
+				: ToRGBA(p_texture.GetLevel(level), (size_t)source.width * source.height, 3);
+			CompressLevel(rgba.empty() ? p_texture.GetLevel(level) : rgba.data(), source.width, source.height, alpha, texture.pixels.data() + texture.levels.back().offset);
+		}
+
+		return texture;
+	}
+
+	TextureData TextureBaker::Decompress(const TextureData& p_texture)
+	{
+		if (!p_texture.IsCompressed())
+			return p_texture;
+
+		TextureData texture;
+		texture.format = TextureFormat::RGBA8;
+
+		const bool bc3 = p_texture.format == TextureFormat::BC3;
+		const size_t blockSize = bc3 ? 16 : 8;
+
+		for (unsigned int level = 0; level < p_texture.levels.size(); level++)
+		{
+			const TextureLevel& compressed = p_texture.levels[level];
+			const uint32_t width = compressed.width;
+			const uint32_t height = compressed.height;
+			const size_t offset = texture.pixels.size();
+			texture.levels.push_back({ width, height, offset, (size_t)width * height * 4 });
+			texture.pixels.resize(offset + (size_t)width * height * 4);
+
+			const unsigned char* block = p_texture.GetLevel(level);
+			for (uint32_t by = 0; by < height; by += 4)
+			{
+				for (uint32_t bx = 0; bx < width; bx += 4, block += blockSize)
+				{
+					unsigned char alphas[8] = { 255, 255, 255, 255, 255, 255, 255, 255 };
+					uint64_t alphaIndices = 0;
+					const unsigned char* color = block;
+
+					if (bc3)
+					{
+						alphas[0] = block[0];
+						alphas[1] = block[1];
+						for (int i = 2; i < 8; i++)
+						{
+							if (alphas[0] > alphas[1])
+								alphas[i] = (unsigned char)(((8 - i) * alphas[0] + (i - 1) * alphas[1]) / 7);
+							else if (i < 6)
+								alphas[i] = (unsigned char)(((6 - i) * alphas[0] + (i - 1) * alphas[1]) / 5);
+							else
+								alphas[i] = i == 6 ? 0 : 255;
+						}
+						for (int i = 0; i < 6; i++)
+							alphaIndices |= (uint64_t)block[2 + i] << (8 * i);
+						color = block + 8;
+					}
+
+					const uint16_t c0 = color[0] | (color[1] << 8);
+					const uint16_t c1 = color[2] | (color[3] << 8);
+					const uint32_t colorIndices = color[4] | (color[5] << 8) | (color[6] << 16) | ((uint32_t)color[7] << 24);
+
+					unsigned char colors[4][4];
+					for (int i = 0; i < 2; i++)
+					{
+						const uint16_t c = i == 0 ? c0 : c1;
+						colors[i][0] = (unsigned char)(((c >> 11) & 31) * 255 / 31);
+						colors[i][1] = (unsigned char)(((c >> 5) & 63) * 255 / 63);
+						colors[i][2] = (unsigned char)((c & 31) * 255 / 31);
+						colors[i][3] = 255;
+					}
+
+					// BC3 color blocks are always in 4 colors mode
+					const bool fourColors = bc3 || c0 > c1;
+					for (int channel = 0; channel < 3; channel++)
+					{
+						if (fourColors)
+						{
+							colors[2][channel] = (unsigned char)((2 * colors[0][channel] + colors[1][channel]) / 3);
+							colors[3][channel] = (unsigned char)((colors[0][channel] + 2 * colors[1][channel]) / 3);
+						}
+						else
+						{
+							colors[2][channel] = (unsigned char)((colors[0][channel] + colors[1][channel]) / 2);
+							colors[3][channel] = 0;
+						}
+					}
+					colors[2][3] = 255;
+					colors[3][3] = fourColors ? 255 : 0;
+
+					for (uint32_t y = 0; y < 4 && by + y < height; y++)
+					{
+						for (uint32_t x = 0; x < 4 && bx + x < width; x++)
+						{
+							const int pixel = y * 4 + x;
+							unsigned char* out = texture.pixels.data() + offset + ((size_t)(by + y) * width + bx + x) * 4;
+							std::memcpy(out, colors[(colorIndices >> (2 * pixel)) & 3], 4);
+							if (bc3)
+								out[3] = alphas[(alphaIndices >> (3 * pixel)) & 7];
+						}
+					}
+				}
+			}
+		}
+
+		return texture;
+	}
+
+	uint64_t TextureBaker::GetKey(const std::string& p_content, const bool p_compress)
+	{
+		// A new version of the baker invalidates the cache. Textures are always flipped on decode.
+		const uint64_t settings[] = { TEXTURE_CACHE_VERSION, STB_DXT_HIGHQUAL, p_compress, true };
+		return FileCache::Hash(p_content.data(), p_content.size()) ^ (FileCache::Hash(settings, sizeof(settings)) * 31);
+	}
+
+	std::string TextureBaker::GetCachePath(const uint64_t p_key)
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "%016llx.tex", (unsigned long long)p_key);
+		return std::string(TEXTURE_CACHE_DIRECTORY) + '/' + name;
+	}
+
+	bool TextureBaker::LoadCache(const std::string& p_path, const uint64_t p_key, TextureData& p_texture)
+	{
+		std::error_code error;
+		if (!std::filesystem::exists(p_path, error))
+			return false;
+
+		std::shared_ptr<Core::MappedFile> file = std::make_shared<Core::MappedFile>();
+		if (!file->Open(p_path))
+			return false;
+
+		TextureCacheHeader header = {};
+		if (file->GetSize() >= sizeof(TextureCacheHeader))
+			memcpy(&header, file->GetData(), sizeof(TextureCacheHeader));
+
+		const uint64_t levelsEnd = sizeof(TextureCacheHeader) + (uint64_t)header.nbLevels * sizeof(TextureLevel);
+		if (header.magic != TEXTURE_CACHE_MAGIC || header.version != TEXTURE_CACHE_VERSION || header.key != p_key || header.nbLevels == 0
+			|| header.pixelsOffset < levelsEnd || header.pixelsOffset + header.pixelsSize > file->GetSize())
+		{
+			Core::Debug::Log::Print("Texture cache " + p_path + " is out of date\n", Core::Debug::LogLevel::Warning);
+			return false;
+		}
+
+		p_texture.format = header.format;
+		p_texture.levels.resize(header.nbLevels);
+		memcpy(p_texture.levels.data(), file->GetData() + sizeof(TextureCacheHeader), header.nbLevels * sizeof(TextureLevel));
+		p_texture.pixels.clear();
+
+		// Read ahead in large blocks, the upload then only touches pages already in memory
+		file->Prefetch((size_t)header.pixelsOffset, (size_t)header.pixelsSize);
+		p_texture.mappedPixels = file->GetData() + header.pixelsOffset;
+		p_texture.mappedSize = (size_t)header.pixelsSize;
+		p_texture.mapping = std::move(file);
+
+		return true;
+	}
+
+	bool TextureBaker::SaveCache(const std::string& p_path, const uint64_t p_key, const TextureData& p_texture)
+	{
+		std::error_code error;
+		std::filesystem::create_directories(std::filesystem::path(p_path).parent_path(), error);
+
+		// Written aside then renamed, a worker never reads a half written cache
+		const std::string temporaryPath = p_path + '.' + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+		{
+			std::ofstream file(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!file)
+			{
+				Core::Debug::Log::Print("Fail to write texture cache " + p_path + "\n", Core::Debug::LogLevel::Warning);
+				return false;
+			}
+
+			TextureCacheHeader header;
+			header.magic = TEXTURE_CACHE_MAGIC;
+			header.version = TEXTURE_CACHE_VERSION;
+			header.format = p_texture.format;
+			header.nbLevels = (uint32_t)p_texture.levels.size();
+			header.key = p_key;
+			const uint64_t levelsEnd = sizeof(TextureCacheHeader) + p_texture.levels.size() * sizeof(TextureLevel);
+			header.pixelsOffset = (levelsEnd + TEXTURE_CACHE_ALIGNMENT - 1) / TEXTURE_CACHE_ALIGNMENT * TEXTURE_CACHE_ALIGNMENT;
+			header.pixelsSize = p_texture.GetPixelsSize();
+
+			const char padding[TEXTURE_CACHE_ALIGNMENT] = {};
+			file.write((const char*)&header, sizeof(TextureCacheHeader));
+			file.write((const char*)p_texture.levels.data(), p_texture.levels.size() * sizeof(TextureLevel));
+			file.write(padding, header.pixelsOffset - levelsEnd);
+			file.write((const char*)p_texture.GetPixels(), header.pixelsSize);
+		}
+
+		std::filesystem::rename(temporaryPath, p_path, error);
+		if (error)
+			std::filesystem::remove(temporaryPath, error); // Already written by another worker
+
+		return true;
+	}
+
+	bool TextureBaker::HasAlpha(const TextureData& p_texture)
+	{
+		if (p_texture.format != TextureFormat::RGBA8 || p_texture.levels.empty())
+			return p_texture.format == TextureFormat::BC3;
+
+		const unsigned char* data = p_texture.GetLevel(0);
+		for (size_t i = 3; i < p_texture.levels[0].size; i += 4)
+		{
+			if (data[i] != 255)
+				return true;
+		}
+
+		return false;
+	}
+
+	size_t TextureBaker::GetLevelSize(const TextureFormat p_format, const uint32_t p_width, const uint32_t p_height)
+	{
+		const size_t nbBlocks = (size_t)((p_width + 3) / 4) * ((p_height + 3) / 4);
+
+		switch (p_format)
+		{
+		case TextureFormat::RGB8:
+			return (size_t)p_width * p_height * 3;
+		case TextureFormat::RGBA8:
+			return (size_t)p_width * p_height * 4;
+		case TextureFormat::BC1:
+			return nbBlocks * 8;
+		case TextureFormat::BC3:
+			return nbBlocks * 16;
+		default:
+			return 0;
+		}
+	}
+
+	std::vector<unsigned char> TextureBaker::ToRGBA(const unsigned char* p_pixels, const size_t p_nbPixels, const int p_nrChannels)
+	{
+		std::vector<unsigned char> rgba(p_nbPixels * 4);
+
+		for (size_t i = 0; i < p_nbPixels; i++)
+		{
+			const unsigned char* in = p_pixels + i * p_nrChannels;
+			unsigned char* out = rgba.data() + i * 4;
+
+			// 1 : grey, 2 : grey alpha, 3 : rgb, 4 : rgba
+			out[0] = in[0];
+			out[1] = p_nrChannels >= 3 ? in[1] : in[0];
+			out[2] = p_nrChannels >= 3 ? in[2] : in[0];
+			out[3] = p_nrChannels == 4 ? in[3] : p_nrChannels == 2 ? in[1] : 255;
+		}
+
+		return rgba;
+	}
+
+	void TextureBaker::CompressLevel(const unsigned char* p_rgba, const uint32_t p_width, const uint32_t p_height, const bool p_alpha, unsigned char* p_blocks)
+	{
+		const size_t blockSize = p_alpha ? 16 : 8;
+		unsigned char block[64];
+
+		for (uint32_t by = 0; by < p_height; by += 4)
+		{
+			for (uint32_t bx = 0; bx < p_width; bx += 4, p_blocks += blockSize)
+			{
+				// Blocks on the border repeat the last pixels
+				for (uint32_t y = 0; y < 4; y++)
+				{
+					const uint32_t sy = std::min(by + y, p_height - 1);
+					for (uint32_t x = 0; x < 4; x++)
+					{
+						const uint32_t sx = std::min(bx + x, p_width - 1);
+						std::memcpy(block + (y * 4 + x) * 4, p_rgba + ((size_t)sy * p_width + sx) * 4, 4);
+					}
+				}
+
+				stb_compress_dxt_block(p_blocks, block, p_alpha, STB_DXT_HIGHQUAL);
+			}
+		}
+	}
+}
\ No newline at end of file
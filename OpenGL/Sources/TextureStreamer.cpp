@@ -0,0 +1,118 @@
+#include "TextureStreamer.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+#include "Texture.hpp"
+
+namespace Resources
+{
+	TextureStreamer::TextureStreamer()
+		: budget(TEXTURE_STREAMING_BUDGET)
+		, residentSize(0)
+	{
+	}
+
+	void TextureStreamer::Add(Texture* p_texture)
+	{
+		if (std::find(textures.begin(), textures.end(), p_texture) == textures.end())
+			textures.push_back(p_texture);
+	}
+
+	void TextureStreamer::Remove(Texture* p_texture)
+	{
+		textures.erase(std::remove(textures.begin(), textures.end(), p_texture), textures.end());
+	}
+
+	void TextureStreamer::Clear()
+	{
+		textures.clear();
+		residentSize = 0;
+	}
+
+	void TextureStreamer::Update(const float p_screenHeight)
+	{
+		std::vector<StreamingEntry> entries(textures.size());
+		for (unsigned int i = 0; i < textures.size(); i++)
+			textures[i]->GetStreamingEntry(p_screenHeight, entries[i]);
+
+		Plan(entries, budget, TEXTURE_STREAMING_UPLOAD);
+
+		residentSize = 0;
+		for (unsigned int i = 0; i < textures.size(); i++)
+		{
+			const StreamingEntry& entry = entries[i];
+			if (entry.targetLevel != entry.residentLevel)
+				textures[i]->SetResidentLevel(entry.targetLevel);
+
+			for (unsigned int level = entry.targetLevel; level < entry.tailLevel; level++)
+				residentSize += entry.levelSizes[level];
+		}
+	}
+
+	unsigned int TextureStreamer::GetWantedLevel(const uint32_t p_width, const uint32_t p_height, const float p_screenSize, const unsigned int p_tailLevel)
+	{
+		// Not drawn this frame
+		if (p_screenSize <= 0.f)
+			return p_tailLevel;
+
+		// One texel per pixel
+		const float level = std::floor(std::log2((float)std::max(p_width, p_height) / p_screenSize));
+		return (unsigned int)std::clamp(level, 0.f, (float)p_tailLevel);
+	}
+
+	void TextureStreamer::Plan(std::vector<StreamingEntry>& p_entries, const size_t p_budget, const size_t p_upload)
+	{
+		size_t total = 0;
+		for (StreamingEntry& entry : p_entries)
+		{
+			entry.targetLevel = entry.residentLevel;
+			for (unsigned int level = entry.residentLevel; level < entry.tailLevel; level++)
+				total += entry.levelSizes[level];
+		}
+
+		// Biggest on screen first
+		std::vector<unsigned int> order(p_entries.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&p_entries](const unsigned int p_a, const unsigned int p_b)
+			{ return p_entries[p_a].screenSize > p_entries[p_b].screenSize; });
+
+		// Frees the finest levels of the entries after p_rank until p_size fits in the budget
+		auto evict = [&](const size_t p_rank, const size_t p_size)
+		{
+			for (const bool keepWanted : { true, false })
+			{
+				for (size_t rank = order.size(); rank-- > p_rank && total + p_size > p_budget;)
+				{
+					StreamingEntry& entry = p_entries[order[rank]];
+					const unsigned int limit = keepWanted ? entry.wantedLevel : entry.tailLevel;
+					for (; entry.targetLevel < limit && total + p_size > p_budget; entry.targetLevel++)
+						total -= entry.levelSizes[entry.targetLevel];
+				}
+			}
+			return total + p_size <= p_budget;
+		};
+
+		// The budget may have been lowered since the last frame
+		evict(0, 0);
+
+		size_t uploaded = 0;
+		for (size_t rank = 0; rank < order.size(); rank++)
+		{
+			StreamingEntry& entry = p_entries[order[rank]];
+			while (entry.targetLevel > entry.wantedLevel)
+			{
+				const size_t size = entry.levelSizes[entry.targetLevel - 1];
+				if (uploaded > 0 && uploaded + size > p_upload)
+					return;
+				if (!evict(rank + 1, size))
+					break;
+
+				entry.targetLevel--;
+				total += size;
+				uploaded += size;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -1,12 +1,16 @@
 #include "ThreadsManager.hpp"
 #include <iostream>
 
+#include "Log.hpp"
+#include "Assertion.hpp"
+
 namespace Core
 {
 	ThreadsManager::ThreadsManager(const unsigned int p_size)
 		: resourcesToInitEnabled (0)
 		, resourcesToLoadEnabled (0)
 		, nbThreadResources(p_size)
+		, reloadRunning(false)
 	{
 		for (unsigned int i = 0; i < nbThreadResources; i++)
 		{
@@ -21,6 +25,8 @@ namespace Core
 			if(threadpool.at(i).joinable())
 				threadpool.at(i).join();
 		}
+
+		DeleteThreads();
 	}
 
 	void ThreadsManager::Init()
@@ -45,6 +51,38 @@ namespace Core
 		}
 	}
 
+	void ThreadsManager::AddResourceToInit(Resources::IResource* p_resource)
+	{
+		// A resource shared between several names is only initialized once
+		if (p_resource->GetStat() != Resources::StatResource::NONE)
+			return;
+
+		p_resource->SetStat(Resources::StatResource::QUEUED);
+		resourcesToInit.push(p_resource);
+	}
+
+	void ThreadsManager::AddResourceToReload(Resources::IResource* p_resource)
+	{
+		// Resources still in their first loading are already up to date
+		if (p_resource->GetStat() != Resources::StatResource::LOADED)
+			return;
+
+		Resources::IResource* reloaded = p_resource->CreateReload();
+		if (!reloaded)
+		{
+			Core::Debug::Log::Print("Fail to reload " + p_resource->GetName() + ", the previous version is kept\n", Core::Debug::LogLevel::Warning);
+			return;
+		}
+
+		{
+			ScopedLock lock(reloadLock);
+			resourcesToReload.push(ResourceReload{ p_resource, reloaded });
+		}
+
+		Core::Debug::Log::Print("Reload " + p_resource->GetName() + "\n", Core::Debug::LogLevel::Notification);
+		StartReloadThread();
+	}
+
 	void ThreadsManager::InitResources()
 	{
 		while (resourcesToInit.size() != 0)
@@ -54,11 +92,19 @@ namespace Core
 
 			if (test == 1)
 			{
+				// Another worker may have taken the last resource meanwhile
+				if (resourcesToInit.empty())
+				{
+					resourcesToInitEnabled.store(0);
+					break;
+				}
+
 				Resources::IResource* resource = resourcesToInit.front();
 				resourcesToInit.pop();
 				resourcesToInitEnabled.store(0);
 
 				resource->Init();
+				Assertion(resource->GetStat() != Resources::StatResource::FAILED, "Fail to load " + resource->GetName());
 
 				bool addedToQueue = false;
 
@@ -78,8 +124,90 @@ namespace Core
 		}
 	}
 
+	void ThreadsManager::ReloadResources()
+	{
+		while (true)
+		{
+			ResourceReload reload;
+			{
+				ScopedLock lock(reloadLock);
+				if (resourcesToReload.empty())
+				{
+					reloadRunning.store(false);
+					return;
+				}
+
+				reload = resourcesToReload.front();
+				resourcesToReload.pop();
+			}
+
+			// A broken file while editing : the previous version stays live
+			reload.reloaded->Init();
+			if (reload.reloaded->GetStat() == Resources::StatResource::FAILED)
+			{
+				Core::Debug::Log::Print("Fail to reload " + reload.resource->GetName() + ", the previous version is kept\n", Core::Debug::LogLevel::Warning);
+				delete reload.reloaded;
+				continue;
+			}
+
+			ScopedLock lock(reloadLock);
+			resourcesToSwap.push(reload);
+		}
+	}
+
+	void ThreadsManager::StartReloadThread()
+	{
+		if (reloadRunning.exchange(true))
+			return;
+
+		if (reloadThread.joinable())
+			reloadThread.join();
+
+		if (multithread)
+			reloadThread = std::thread(&ThreadsManager::ReloadResources, this);
+		else
+			ReloadResources();
+	}
+
+	void ThreadsManager::SwapReloadedResources()
+	{
+		// Taken out of the queue first : the reload thread is not blocked by the uploads
+		std::vector<ResourceReload> reloads;
+		bool restartReload = false;
+		{
+			ScopedLock lock(reloadLock);
+			for (; !resourcesToSwap.empty(); resourcesToSwap.pop())
+				reloads.push_back(resourcesToSwap.front());
+
+			// A reload requested while the thread was stopping
+			restartReload = !resourcesToReload.empty() && !reloadRunning;
+		}
+
+		// Called between two frames : the resources are never swapped while they are drawn
+		for (const ResourceReload& reload : reloads)
+		{
+			reload.reloaded->InitOpenGL();
+			if (reload.reloaded->GetStat() == Resources::StatResource::FAILED)
+			{
+				Core::Debug::Log::Print("Fail to reload " + reload.resource->GetName() + ", the previous version is kept\n", Core::Debug::LogLevel::Warning);
+				delete reload.reloaded;
+				continue;
+			}
+
+			reload.resource->SwapReload(*reload.reloaded);
+			delete reload.reloaded; // Now holds the previous version
+
+			Core::Debug::Log::Print("Reloaded " + reload.resource->GetName() + "\n", Core::Debug::LogLevel::Notification);
+		}
+
+		if (restartReload)
+			StartReloadThread();
+	}
+
 	void ThreadsManager::Update()
 	{
+		SwapReloadedResources();
+
 		while (resourcesToLoad.size() != 0)
 		{
 			Wait(resourcesToLoadEnabled);
@@ -88,6 +216,7 @@ namespace Core
 			if (test == 1)
 			{
 				resourcesToLoad.front()->InitOpenGL();
+				Assertion(resourcesToLoad.front()->GetStat() != Resources::StatResource::FAILED, "Fail to load " + resourcesToLoad.front()->GetName());
 				resourcesToLoad.pop();
 				resourcesToLoadEnabled.store(0);
 			}
@@ -104,5 +233,15 @@ namespace Core
 				std::cout << " Thread unused is destroyed \n";
 			}
 		}
+
+		if (reloadThread.joinable())
+			reloadThread.join();
+
+		// The pending reloads target resources that are going to be deleted
+		ScopedLock lock(reloadLock);
+		for (; !resourcesToReload.empty(); resourcesToReload.pop())
+			delete resourcesToReload.front().reloaded;
+		for (; !resourcesToSwap.empty(); resourcesToSwap.pop())
+			delete resourcesToSwap.front().reloaded;
 	}
 }
\ No newline at end of file
@@ -1,8 +1,5 @@
 #include "Timer.hpp"
-#include <imgui.h>
 #include <string.h>
-#include <imgui_impl_glfw.h>
-#include <GLFW/glfw3.h>
 #include <iostream>
 
 namespace Core::Time
@@ -19,7 +16,9 @@ namespace Core::Time
 
 	void Timer::Update()
 	{
-		_currentFrame = glfwGetTime();
+		// Monotonic, without the window : the headless runs have no GLFW
+		static const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+		_currentFrame = std::chrono::duration<double>(std::chrono::steady_clock::now() - origin).count();
 		_deltaTime = _currentFrame - _lastFrame;
 		_lastFrame = _currentFrame;
 	}
@@ -47,4 +46,4 @@ namespace Core::Time
 		}
 	}
 
-}
+}
\ No newline at end of file
@@ -1,17 +1,30 @@
 #include "Transform.hpp"
 
+#include <cstring>
+
 namespace Physics
 {
 	Transform::Transform(const Core::Maths::Vec3& p_translate, const Core::Maths::Vec3& p_scale, const Core::Maths::Vec3& p_rotation)
 		: matrix(Core::Maths::Mat4::Identity())
+		, normalMatrix(Core::Maths::Mat4::Identity())
 		, translation(p_translate)
 		, scale (p_scale)
 		, rotation(p_rotation)
 	{
 	}
 
-	const Core::Maths::Mat4& Transform::GetLocalTransform()
+	Core::Maths::Mat4 Transform::GetLocalTransform() const
 	{
 		return Core::Maths::Mat4::CreateTransformationMatrix(translation, scale, rotation);
 	}
+
+	void Transform::SetMatrix(const Core::Maths::Mat4& p_matrix)
+	{
+		// Most of the objects do not move, their normal matrix is kept
+		if (memcmp(matrix.mat, p_matrix.mat, sizeof(matrix.mat)) == 0)
+			return;
+
+		matrix = p_matrix;
+		normalMatrix = matrix.GetNormalMatrix();
+	}
 }
\ No newline at end of file
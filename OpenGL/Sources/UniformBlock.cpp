@@ -0,0 +1,152 @@
+#include "UniformBlock.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+#include <glad/glad.h>
+
+namespace LowRenderer
+{
+	// --------------------
+	//    Uniform block
+	// --------------------
+
+	size_t UniformBlock::AddInt(const int32_t p_value)
+	{
+		return Add(&p_value, sizeof(int32_t), 4);
+	}
+
+	size_t UniformBlock::AddFloat(const float p_value)
+	{
+		return Add(&p_value, sizeof(float), 4);
+	}
+
+	size_t UniformBlock::AddVec3(const Core::Maths::Vec3& p_value)
+	{
+		const float value[3] = { p_value.x, p_value.y, p_value.z };
+		return Add(value, sizeof(value), 16);
+	}
+
+	size_t UniformBlock::AddVec4(const Core::Maths::Vec4& p_value)
+	{
+		const float value[4] = { p_value.x, p_value.y, p_value.z, p_value.w };
+		return Add(value, sizeof(value), 16);
+	}
+
+	size_t UniformBlock::BeginStruct()
+	{
+		Align(16);
+		return data.size();
+	}
+
+	void UniformBlock::EndStruct()
+	{
+		// The member which follows a struct starts on the next 16 bytes
+		Align(16);
+	}
+
+	size_t UniformBlock::Add(const void* p_value, const size_t p_size, const size_t p_alignment)
+	{
+		Align(p_alignment);
+		const size_t offset = data.size();
+		data.resize(offset + p_size);
+		memcpy(data.data() + offset, p_value, p_size);
+
+		return offset;
+	}
+
+	void UniformBlock::Align(const size_t p_alignment)
+	{
+		data.resize((data.size() + p_alignment - 1) / p_alignment * p_alignment, 0);
+	}
+
+	// --------------------
+	//   Uniform buffer
+	// --------------------
+
+	UniformBuffer::UniformBuffer(const unsigned int p_binding)
+		: buffer(0)
+		, binding(p_binding)
+	{
+	}
+
+	UniformBuffer::~UniformBuffer()
+	{
+		if (buffer)
+			glDeleteBuffers(1, &buffer);
+	}
+
+	bool UniformBuffer::Upload(const UniformBlock& p_block)
+	{
+		if (!buffer)
+			glGenBuffers(1, &buffer);
+
+		// Bound every frame, the buffer of another scene may use the binding point
+		glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+
+		const bool sameSize = uploaded.size() == p_block.GetSize() && !uploaded.empty();
+		if (sameSize && memcmp(uploaded.data(), p_block.GetData(), uploaded.size()) == 0)
+			return false;
+
+		if (sameSize)
+			glBufferSubData(GL_UNIFORM_BUFFER, 0, (GLsizeiptr)p_block.GetSize(), p_block.GetData());
+		else
+			glBufferData(GL_UNIFORM_BUFFER, (GLsizeiptr)p_block.GetSize(), p_block.GetData(), GL_DYNAMIC_DRAW);
+
+		uploaded.assign(p_block.GetData(), p_block.GetData() + p_block.GetSize());
+		return true;
+	}
+
+	// --------------------
+	//   Texture buffer
+	// --------------------
+
+	TextureBuffer::TextureBuffer(const unsigned int p_unit, const unsigned int p_format)
+		: buffer(0)
+		, texture(0)
+		, unit(p_unit)
+		, format(p_format)
+	{
+	}
+
+	TextureBuffer::~TextureBuffer()
+	{
+		if (texture)
+			glDeleteTextures(1, &texture);
+		if (buffer)
+			glDeleteBuffers(1, &buffer);
+	}
+
+	bool TextureBuffer::Upload(const void* p_data, const size_t p_size)
+	{
+		const bool created = buffer == 0;
+		if (created)
+		{
+			glGenBuffers(1, &buffer);
+			glGenTextures(1, &texture);
+		}
+
+		// Bound every frame, as the uniform buffers
+		glBindTextureUnit(unit, texture);
+
+		const bool sameSize = !created && uploaded.size() == p_size;
+		if (sameSize && (p_size == 0 || memcmp(uploaded.data(), p_data, p_size) == 0))
+			return false;
+
+		glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+		if (sameSize)
+			glBufferSubData(GL_TEXTURE_BUFFER, 0, (GLsizeiptr)p_size, p_data);
+		else
+		{
+			// Never empty, a texture buffer needs storage to be complete
+			static const unsigned char empty[16] = {};
+			glBufferData(GL_TEXTURE_BUFFER, (GLsizeiptr)std::max(p_size, sizeof(empty)), p_size ? p_data : empty, GL_DYNAMIC_DRAW);
+			glBindTexture(GL_TEXTURE_BUFFER, texture);
+			glTexBuffer(GL_TEXTURE_BUFFER, format, buffer);
+		}
+
+		const unsigned char* data = static_cast<const unsigned char*>(p_data);
+		uploaded.assign(data, data + p_size);
+		return true;
+	}
+}
\ No newline at end of file
@@ -1,12 +1,27 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <iostream>
+#include <cctype>
 
 // Core
 #include "App.hpp"
 // Core::Debug
 #include "Assertion.hpp"
 #include "TestMyMaths.hpp"
+#include "TestResourcesManager.hpp"
+#include "TestTextureBaker.hpp"
+#include "TestTextureAtlas.hpp"
+#include "TestTextureStreamer.hpp"
+#include "TestLightManager.hpp"
+#include "TestShaderPreprocessor.hpp"
+#include "TestRenderQueue.hpp"
+#include "TestFrustum.hpp"
+#include "TestOcclusion.hpp"
+#include "TestStaticBatch.hpp"
+#include "TestMeshArena.hpp"
+#include "Benchmark.hpp"
+// Resources
+#include "AssetPack.hpp"
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 void APIENTRY glDebugOutput(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam);
@@ -15,15 +30,66 @@ void APIENTRY glDebugOutput(GLenum source, GLenum type, GLuint id, GLenum severi
 const unsigned int SCR_WIDTH = 1920;
 const unsigned int SCR_HEIGHT = 1080;
 
-int main()
+int main(int argc, char** argv)
 {
 	Core::Debug::Log::OpenFile("Log.txt");
 
-	#ifdef DEBUG
-		Core::Debug::TestMyMaths();
-	#endif // DEBUG
+	// OpenGL.exe --pack <directory> <pack> : pack every file of the directory, then quit
+	if (argc == 4 && std::string(argv[1]) == "--pack")
+	{
+		const bool built = Resources::AssetPack::Build(argv[3], Resources::AssetPack::ListFiles(argv[2]));
+		Core::Debug::Log::CloseFile();
+		return built ? 0 : 1;
+	}
+
+	// OpenGL.exe --benchmark : run the headless benchmarks, then quit
+	if (argc == 2 && std::string(argv[1]) == "--benchmark")
+	{
+		Core::Debug::Benchmark();
+		Core::Debug::Log::CloseFile();
+		return 0;
+	}
 
-	Core::AppInit appInit { SCR_WIDTH, SCR_HEIGHT, 4, 5, "LearnOpenGL", *framebuffer_size_callback, *glDebugOutput };
+	// OpenGL.exe --test : run the unit tests, then quit
+	if (argc == 2 && std::string(argv[1]) == "--test")
+	{
+		Core::Debug::TestMyMaths();
+		Core::Debug::TestResourcesManager();
+		Core::Debug::TestTextureBaker();
+		Core::Debug::TestTextureAtlas();
+		Core::Debug::TestTextureStreamer();
+		Core::Debug::TestLightManager();
+		Core::Debug::TestShaderPreprocessor();
+		Core::Debug::TestRenderQueue();
+		Core::Debug::TestFrustum();
+		Core::Debug::TestOcclusion();
+		Core::Debug::TestStaticBatch();
+		Core::Debug::TestMeshArena();
+		Core::Debug::Log::CloseFile();
+		return 0;
+	}
+
+	Core::AppInit appInit { SCR_WIDTH, SCR_HEIGHT, 4, 5, "LearnOpenGL", *framebuffer_size_callback, *glDebugOutput, false, "Resources.pack" };
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string argument = argv[i];
+
+		// --headless [frames] : load and simulate Scene1 without window nor GPU, print the recorded GL calls, then quit
+		if (argument == "--headless")
+		{
+			appInit.headless = true;
+			if (i + 1 < argc && std::isdigit((unsigned char)argv[i + 1][0]))
+				appInit.headlessFrames = (unsigned int)std::stoul(argv[++i]);
+		}
+		// --hot-reload : reload the resources modified in Resources/ while the app runs
+		else if (argument == "--hot-reload")
+			appInit.hotReload = true;
+		// --indirect : draw Scene1 with one glMultiDrawElementsIndirect per shader and texture
+		else if (argument == "--indirect")
+			appInit.indirectDraws = true;
+		else
+			Core::Debug::Log::Print("Unknown argument " + argument + "\n", Core::Debug::LogLevel::Warning);
+	}
 	Core::App app;
 
 	Assertion(app.Init(appInit), "fail on init app");